@@ -45,3 +45,8 @@ export BOOST_TEST_COLOR_OUTPUT=1
 
 # Run unit tests
 ./build/unit-tests $(ut_log_args)
+
+# Run C++20 unit tests, if the compiler supports them
+if [[ -x build/unit-tests-cxx20 ]]; then
+    ./build/unit-tests-cxx20 $(ut_log_args cxx20)
+fi
@@ -25,7 +25,8 @@
 #include "ndn-cxx/detail/common.hpp"
 #include "ndn-cxx/tag.hpp"
 
-#include <map>
+#include <array>
+#include <vector>
 
 namespace ndn {
 
@@ -58,20 +59,78 @@ public:
   removeTag() const;
 
 private:
-  mutable std::map<int, shared_ptr<Tag>> m_tags;
+  /** \brief first TypeId stored in a fixed slot
+   *
+   *  TypeIds [FIXED_SLOT_BEGIN, FIXED_SLOT_END) are the NDNLPv2 tags (IncomingFaceIdTag through
+   *  PrefixAnnouncementTag) that are attached to nearly every packet received from the forwarder.
+   *  They live in a fixed array so that tagging an incoming packet does not allocate a map node.
+   */
+  static constexpr int FIXED_SLOT_BEGIN = 10;
+  static constexpr int FIXED_SLOT_END = 16;
+
+  static constexpr bool
+  isFixedSlot(int typeId) noexcept
+  {
+    return typeId >= FIXED_SLOT_BEGIN && typeId < FIXED_SLOT_END;
+  }
+
+  shared_ptr<Tag>*
+  findOtherTag(int typeId) const;
+
+  void
+  setOtherTag(int typeId, shared_ptr<Tag> tag) const;
+
+private:
+  mutable std::array<shared_ptr<Tag>, FIXED_SLOT_END - FIXED_SLOT_BEGIN> m_fixedTags;
+  mutable std::vector<std::pair<int, shared_ptr<Tag>>> m_otherTags;
 };
 
+inline shared_ptr<Tag>*
+TagHost::findOtherTag(int typeId) const
+{
+  for (auto& entry : m_otherTags) {
+    if (entry.first == typeId) {
+      return &entry.second;
+    }
+  }
+  return nullptr;
+}
+
+inline void
+TagHost::setOtherTag(int typeId, shared_ptr<Tag> tag) const
+{
+  for (auto it = m_otherTags.begin(); it != m_otherTags.end(); ++it) {
+    if (it->first == typeId) {
+      if (tag == nullptr) {
+        m_otherTags.erase(it);
+      }
+      else {
+        it->second = std::move(tag);
+      }
+      return;
+    }
+  }
+
+  if (tag != nullptr) {
+    m_otherTags.emplace_back(typeId, std::move(tag));
+  }
+}
+
 template<typename T>
 shared_ptr<T>
 TagHost::getTag() const
 {
   static_assert(std::is_base_of<Tag, T>::value, "T must inherit from Tag");
 
-  auto it = m_tags.find(T::getTypeId());
-  if (it == m_tags.end()) {
+  if (isFixedSlot(T::getTypeId())) {
+    return static_pointer_cast<T>(m_fixedTags[T::getTypeId() - FIXED_SLOT_BEGIN]);
+  }
+
+  auto tag = findOtherTag(T::getTypeId());
+  if (tag == nullptr) {
     return nullptr;
   }
-  return static_pointer_cast<T>(it->second);
+  return static_pointer_cast<T>(*tag);
 }
 
 template<typename T>
@@ -80,11 +139,11 @@ TagHost::setTag(shared_ptr<T> tag) const
 {
   static_assert(std::is_base_of<Tag, T>::value, "T must inherit from Tag");
 
-  if (tag == nullptr) {
-    m_tags.erase(T::getTypeId());
+  if (isFixedSlot(T::getTypeId())) {
+    m_fixedTags[T::getTypeId() - FIXED_SLOT_BEGIN] = std::move(tag);
   }
   else {
-    m_tags[T::getTypeId()] = std::move(tag);
+    setOtherTag(T::getTypeId(), std::move(tag));
   }
 }
 
@@ -22,6 +22,7 @@
  */
 
 #include "ndn-cxx/encoding/block.hpp"
+#include "ndn-cxx/encoding/buffer-pool.hpp"
 #include "ndn-cxx/encoding/buffer-stream.hpp"
 #include "ndn-cxx/encoding/encoding-buffer.hpp"
 #include "ndn-cxx/encoding/tlv.hpp"
@@ -123,7 +124,7 @@ Block::Block(const uint8_t* buf, size_t bufSize)
   uint64_t typeLengthSize = static_cast<uint64_t>(pos - buf);
   m_size = typeLengthSize + length;
 
-  m_buffer = make_shared<Buffer>(buf, m_size);
+  m_buffer = encoding::BufferPool::get().allocate(buf, m_size);
   m_begin = m_buffer->begin();
   m_end = m_valueEnd = m_buffer->end();
   m_valueBegin = m_begin + typeLengthSize;
@@ -238,7 +239,7 @@ Block::fromBuffer(const uint8_t* buf, size_t bufSize)
   }
 
   size_t typeLengthSize = pos - buf;
-  auto b = make_shared<Buffer>(buf, pos + length);
+  auto b = encoding::BufferPool::get().allocate(buf, typeLengthSize + length);
   return std::make_tuple(true, Block(b, type, b->begin(), b->end(),
                                      b->begin() + typeLengthSize, b->end()));
 }
@@ -326,25 +327,33 @@ Block::parse() const
   if (!m_elements.empty() || value_size() == 0)
     return;
 
-  Buffer::const_iterator begin = value_begin();
-  Buffer::const_iterator end = value_end();
-
-  while (begin != end) {
-    Buffer::const_iterator pos = begin;
-
-    uint32_t type = tlv::readType(pos, end);
-    uint64_t length = tlv::readVarNumber(pos, end);
-    if (length > static_cast<uint64_t>(end - pos)) {
+  const size_t size = value_size();
+  size_t offset = 0;
+  tlv::ElementHeader headers[16];
+  while (offset < size) {
+    size_t nHeaders = tlv::scanElementHeaders(value() + offset, size - offset,
+                                              headers, std::extent<decltype(headers)>::value);
+    if (nHeaders == 0) {
       m_elements.clear();
+      // decode the malformed sub-element again to report the error
+      Buffer::const_iterator pos = value_begin() + offset;
+      uint32_t type = tlv::readType(pos, value_end());
+      tlv::readVarNumber(pos, value_end());
       NDN_THROW(Error("TLV-LENGTH of sub-element of type " + to_string(type) +
                       " exceeds TLV-VALUE boundary of parent block"));
     }
-    // pos now points to TLV-VALUE of sub element
 
-    Buffer::const_iterator subEnd = pos + length;
-    m_elements.emplace_back(m_buffer, type, begin, subEnd, pos, subEnd);
+    Buffer::const_iterator chunk = value_begin() + offset;
+    for (size_t i = 0; i < nHeaders; ++i) {
+      const tlv::ElementHeader& header = headers[i];
+      Buffer::const_iterator begin = chunk + header.offset;
+      Buffer::const_iterator valueBegin = begin + header.size;
+      Buffer::const_iterator end = valueBegin + header.length;
+      m_elements.emplace_back(m_buffer, header.type, begin, end, valueBegin, end);
+    }
 
-    begin = subEnd;
+    const tlv::ElementHeader& last = headers[nHeaders - 1];
+    offset += last.offset + last.size + last.length;
   }
 }
 
@@ -0,0 +1,216 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/encoding/buffer-pool.hpp"
+
+#include <algorithm>
+
+namespace ndn {
+namespace encoding {
+
+constexpr std::array<size_t, 8> BufferPool::SIZE_CLASSES;
+constexpr size_t BufferPool::MAX_IDLE_PER_CLASS;
+constexpr size_t BufferPool::CONTROL_BLOCK_SIZE;
+constexpr size_t BufferPool::MAX_IDLE_CONTROL_BLOCKS;
+
+// Pool of the current thread, or nullptr if it has not been created yet or was already destroyed.
+// Buffers released while this is nullptr (e.g., static Blocks destroyed at exit) are freed.
+static thread_local BufferPool* t_pool = nullptr;
+
+static size_t
+findSizeClass(size_t size)
+{
+  return std::lower_bound(BufferPool::SIZE_CLASSES.begin(), BufferPool::SIZE_CLASSES.end(), size) -
+         BufferPool::SIZE_CLASSES.begin();
+}
+
+/**
+ * @brief Serves the (fixed-size) control block of a pooled shared_ptr<Buffer>
+ *
+ * Slots are taken from the free list of the calling thread's pool and released into the free
+ * list of the thread that destroys the control block, mirroring how the Buffer itself moves.
+ */
+template<typename T>
+class BufferPool::ControlBlockAllocator
+{
+public:
+  using value_type = T;
+
+  ControlBlockAllocator() noexcept = default;
+
+  template<typename U>
+  ControlBlockAllocator(const ControlBlockAllocator<U>&) noexcept
+  {
+  }
+
+  T*
+  allocate(size_t n)
+  {
+    static_assert(sizeof(T) <= CONTROL_BLOCK_SIZE, "control block does not fit in a slot");
+    BOOST_ASSERT(n == 1);
+
+    if (t_pool != nullptr && !t_pool->m_idleControlBlocks.empty()) {
+      void* slot = t_pool->m_idleControlBlocks.back();
+      t_pool->m_idleControlBlocks.pop_back();
+      return static_cast<T*>(slot);
+    }
+    return static_cast<T*>(::operator new(CONTROL_BLOCK_SIZE));
+  }
+
+  void
+  deallocate(T* p, size_t) noexcept
+  {
+    if (t_pool == nullptr || t_pool->m_idleControlBlocks.size() >= MAX_IDLE_CONTROL_BLOCKS) {
+      ::operator delete(p);
+      return;
+    }
+    t_pool->m_idleControlBlocks.push_back(p);
+  }
+
+  template<typename U>
+  bool
+  operator==(const ControlBlockAllocator<U>&) const noexcept
+  {
+    return true;
+  }
+
+  template<typename U>
+  bool
+  operator!=(const ControlBlockAllocator<U>&) const noexcept
+  {
+    return false;
+  }
+};
+
+BufferPool::BufferPool()
+{
+  // reserve upfront, so that recycle() never needs to allocate
+  for (auto& idle : m_idle) {
+    idle.reserve(MAX_IDLE_PER_CLASS);
+  }
+  m_idleControlBlocks.reserve(MAX_IDLE_CONTROL_BLOCKS);
+  t_pool = this;
+}
+
+BufferPool::~BufferPool()
+{
+  t_pool = nullptr;
+  clear();
+}
+
+BufferPool&
+BufferPool::get()
+{
+  thread_local BufferPool pool;
+  return pool;
+}
+
+shared_ptr<Buffer>
+BufferPool::allocate(size_t size)
+{
+  size_t sc = findSizeClass(size);
+  if (sc == SIZE_CLASSES.size()) {
+    return make_shared<Buffer>(size);
+  }
+
+  Buffer* buffer = nullptr;
+  if (!m_idle[sc].empty()) {
+    buffer = m_idle[sc].back();
+    m_idle[sc].pop_back();
+    buffer->assign(size, 0);
+  }
+  else {
+    buffer = new Buffer;
+    buffer->reserve(SIZE_CLASSES[sc]);
+    buffer->resize(size);
+  }
+  return makeShared(buffer);
+}
+
+shared_ptr<Buffer>
+BufferPool::allocate(const uint8_t* buf, size_t length)
+{
+  size_t sc = findSizeClass(length);
+  if (sc == SIZE_CLASSES.size()) {
+    return make_shared<Buffer>(buf, length);
+  }
+
+  Buffer* buffer = nullptr;
+  if (!m_idle[sc].empty()) {
+    buffer = m_idle[sc].back();
+    m_idle[sc].pop_back();
+  }
+  else {
+    buffer = new Buffer;
+    buffer->reserve(SIZE_CLASSES[sc]);
+  }
+  buffer->assign(buf, buf + length);
+  return makeShared(buffer);
+}
+
+shared_ptr<Buffer>
+BufferPool::makeShared(Buffer* buffer)
+{
+  return shared_ptr<Buffer>(buffer, &BufferPool::recycle, ControlBlockAllocator<Buffer>());
+}
+
+void
+BufferPool::recycle(Buffer* buffer) noexcept
+{
+  // a buffer that was resized by its user is only reusable if its capacity still matches a size class
+  size_t sc = findSizeClass(buffer->capacity());
+  if (t_pool == nullptr || sc == SIZE_CLASSES.size() || SIZE_CLASSES[sc] != buffer->capacity() ||
+      t_pool->m_idle[sc].size() >= MAX_IDLE_PER_CLASS) {
+    delete buffer;
+    return;
+  }
+
+  t_pool->m_idle[sc].push_back(buffer);
+}
+
+size_t
+BufferPool::size() const noexcept
+{
+  size_t n = 0;
+  for (const auto& idle : m_idle) {
+    n += idle.size();
+  }
+  return n;
+}
+
+void
+BufferPool::clear() noexcept
+{
+  for (auto& idle : m_idle) {
+    for (Buffer* buffer : idle) {
+      delete buffer;
+    }
+    idle.clear();
+  }
+
+  for (void* slot : m_idleControlBlocks) {
+    ::operator delete(slot);
+  }
+  m_idleControlBlocks.clear();
+}
+
+} // namespace encoding
+} // namespace ndn
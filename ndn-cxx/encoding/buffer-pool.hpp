@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_ENCODING_BUFFER_POOL_HPP
+#define NDN_ENCODING_BUFFER_POOL_HPP
+
+#include "ndn-cxx/encoding/buffer.hpp"
+#include "ndn-cxx/encoding/tlv.hpp"
+
+#include <array>
+
+namespace ndn {
+namespace encoding {
+
+/**
+ * @brief Per-thread, size-classed pool of reusable Buffer objects
+ *
+ * Encoder and Block allocate their wire buffers through the pool of the calling thread.
+ * A pooled buffer is owned by a regular shared_ptr (so it remains a ConstBufferPtr for all
+ * existing users), but its deleter hands the Buffer, together with its storage, back to the
+ * pool of the thread that drops the last reference instead of freeing it.  The shared_ptr
+ * control block is drawn from, and returned to, a per-thread free list as well.  Once the pool
+ * is warm, an allocation in a size class that has an idle buffer does not go to the heap.
+ *
+ * Requests larger than the largest size class are served by a plain heap allocation.
+ */
+class BufferPool : noncopyable
+{
+public:
+  /**
+   * @brief Get the pool of the calling thread
+   */
+  static BufferPool&
+  get();
+
+  /**
+   * @brief Obtain a zero-filled buffer of exactly @p size bytes
+   *
+   * The buffer is returned to the pool of the releasing thread when the last shared_ptr
+   * referencing it is destroyed.
+   */
+  shared_ptr<Buffer>
+  allocate(size_t size);
+
+  /**
+   * @brief Obtain a buffer holding a copy of [@p buf, @p buf + @p length)
+   */
+  shared_ptr<Buffer>
+  allocate(const uint8_t* buf, size_t length);
+
+  /**
+   * @brief Get number of idle buffers held in the pool
+   */
+  size_t
+  size() const noexcept;
+
+  /**
+   * @brief Release all idle buffers held in the pool
+   */
+  void
+  clear() noexcept;
+
+public:
+  /** @brief Capacities of the size classes, in increasing order
+   */
+  static constexpr std::array<size_t, 8> SIZE_CLASSES{{
+    64, 128, 256, 512, 1024, 2048, 4096, MAX_NDN_PACKET_SIZE
+  }};
+
+  /** @brief Maximum number of idle buffers kept per size class
+   */
+  static constexpr size_t MAX_IDLE_PER_CLASS = 32;
+
+private:
+  BufferPool();
+
+  ~BufferPool();
+
+  static void
+  recycle(Buffer* buffer) noexcept;
+
+  static shared_ptr<Buffer>
+  makeShared(Buffer* buffer);
+
+  /** @brief Allocator for the control blocks of pooled shared_ptr<Buffer>
+   */
+  template<typename T>
+  class ControlBlockAllocator;
+
+public:
+  /** @brief Size of a control block slot
+   */
+  static constexpr size_t CONTROL_BLOCK_SIZE = 64;
+
+  /** @brief Maximum number of idle control blocks kept
+   */
+  static constexpr size_t MAX_IDLE_CONTROL_BLOCKS = SIZE_CLASSES.size() * MAX_IDLE_PER_CLASS;
+
+private:
+  std::array<std::vector<Buffer*>, SIZE_CLASSES.size()> m_idle;
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  std::vector<void*> m_idleControlBlocks;
+};
+
+} // namespace encoding
+} // namespace ndn
+
+#endif // NDN_ENCODING_BUFFER_POOL_HPP
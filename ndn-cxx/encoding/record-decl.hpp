@@ -0,0 +1,503 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_ENCODING_RECORD_DECL_HPP
+#define NDN_ENCODING_RECORD_DECL_HPP
+
+#include "ndn-cxx/encoding/block-helpers.hpp"
+#include "ndn-cxx/util/time.hpp"
+
+#include <bitset>
+#include <tuple>
+#include <boost/range/adaptor/reversed.hpp>
+
+namespace ndn {
+namespace encoding {
+
+/** @brief Indicate a field is encoded as a non-negative integer.
+ *
+ *  Supported member types are integral and enumeration types, durations (encoded as their
+ *  count), time::system_clock::TimePoint (encoded as milliseconds since the Unix epoch), and
+ *  std::bitset.
+ */
+struct NonNegativeIntegerTag;
+
+/** @brief Indicate a field is encoded as a string.
+ */
+struct StringTag;
+
+/** @brief Indicate a field is a self-describing TLV element, such as a Name or another record.
+ *
+ *  The member type must provide `wireEncode(EncodingImpl<TAG>&)` and `wireDecode(const Block&)`.
+ */
+struct NestedTag;
+
+/** @brief Indicate a field is a TLV element that wraps exactly one self-describing element.
+ */
+struct WrappedTag;
+
+namespace detail {
+
+template<typename T>
+constexpr std::enable_if_t<std::is_integral<T>::value || std::is_enum<T>::value, uint64_t>
+toNonNegativeInteger(T value) noexcept
+{
+  return static_cast<uint64_t>(value);
+}
+
+template<typename Rep, typename Period>
+constexpr uint64_t
+toNonNegativeInteger(boost::chrono::duration<Rep, Period> value) noexcept
+{
+  return static_cast<uint64_t>(value.count());
+}
+
+inline uint64_t
+toNonNegativeInteger(const time::system_clock::TimePoint& value)
+{
+  return static_cast<uint64_t>(time::toUnixTimestamp(value).count());
+}
+
+template<size_t N>
+uint64_t
+toNonNegativeInteger(const std::bitset<N>& value)
+{
+  return value.to_ullong();
+}
+
+template<typename T>
+std::enable_if_t<std::is_integral<T>::value || std::is_enum<T>::value>
+fromNonNegativeInteger(const Block& element, T& value)
+{
+  value = readNonNegativeIntegerAs<T>(element);
+}
+
+template<typename Rep, typename Period>
+void
+fromNonNegativeInteger(const Block& element, boost::chrono::duration<Rep, Period>& value)
+{
+  value = boost::chrono::duration<Rep, Period>(readNonNegativeInteger(element));
+}
+
+inline void
+fromNonNegativeInteger(const Block& element, time::system_clock::TimePoint& value)
+{
+  value = time::fromUnixTimestamp(time::milliseconds(readNonNegativeInteger(element)));
+}
+
+template<size_t N>
+void
+fromNonNegativeInteger(const Block& element, std::bitset<N>& value)
+{
+  value = std::bitset<N>(static_cast<unsigned long long>(readNonNegativeInteger(element)));
+}
+
+/** @brief Maximum size of a TLV element that holds a nonNegativeInteger.
+ *
+ *  TLV-TYPE occupies at most 5 octets, TLV-LENGTH 1 octet, and TLV-VALUE at most 8 octets.
+ */
+constexpr size_t MAX_NON_NEGATIVE_INTEGER_ELEMENT_SIZE = 5 + 1 + 8;
+
+/** @brief Write a nonNegativeInteger TLV element so that it ends right before @p end.
+ *  @return pointer to the first octet of the element
+ */
+inline uint8_t*
+writeNonNegativeIntegerElementBackward(uint8_t* end, uint32_t type, uint64_t value) noexcept
+{
+  uint8_t* pos = end;
+  size_t valueSize = tlv::sizeOfNonNegativeInteger(value);
+  for (size_t i = 0; i < valueSize; ++i) {
+    *--pos = static_cast<uint8_t>(value);
+    value >>= 8;
+  }
+  *--pos = static_cast<uint8_t>(valueSize);
+
+  if (type < 253) {
+    *--pos = static_cast<uint8_t>(type);
+  }
+  else if (type <= std::numeric_limits<uint16_t>::max()) {
+    *--pos = static_cast<uint8_t>(type);
+    *--pos = static_cast<uint8_t>(type >> 8);
+    *--pos = 253;
+  }
+  else {
+    for (int i = 0; i < 4; ++i) {
+      *--pos = static_cast<uint8_t>(type);
+      type >>= 8;
+    }
+    *--pos = 254;
+  }
+  return pos;
+}
+
+template<typename MemberPointer>
+struct MemberPointerTraits;
+
+template<typename C, typename T>
+struct MemberPointerTraits<T C::*>
+{
+  using ValueType = T;
+};
+
+} // namespace detail
+
+/** @brief Encodes and decodes the TLV element of a single field value.
+ *  @tparam CODEC_TAG NonNegativeIntegerTag, StringTag, NestedTag, or WrappedTag
+ */
+template<typename CODEC_TAG>
+struct FieldCodec;
+
+/** @brief Codec of nonNegativeInteger fields.
+ *
+ *  The encoded element has a small bounded width, so it is sized arithmetically when estimating,
+ *  and serialized on the stack and prepended in a single call when encoding.  Decoding reads the
+ *  TLV-VALUE with the fixed-width loads of tlv::readNonNegativeInteger.
+ */
+template<>
+struct FieldCodec<NonNegativeIntegerTag>
+{
+  template<typename T>
+  static size_t
+  prepend(EncodingImpl<EstimatorTag>&, uint32_t type, const T& value)
+  {
+    return tlv::sizeOfVarNumber(type) + 1 +
+           tlv::sizeOfNonNegativeInteger(detail::toNonNegativeInteger(value));
+  }
+
+  template<typename T>
+  static size_t
+  prepend(EncodingImpl<EncoderTag>& encoder, uint32_t type, const T& value)
+  {
+    uint8_t buf[detail::MAX_NON_NEGATIVE_INTEGER_ELEMENT_SIZE];
+    uint8_t* end = buf + sizeof(buf);
+    uint8_t* begin = detail::writeNonNegativeIntegerElementBackward(end, type,
+                                                                    detail::toNonNegativeInteger(value));
+    return encoder.prependByteArray(begin, static_cast<size_t>(end - begin));
+  }
+
+  template<typename T>
+  static void
+  decode(const Block& element, T& value)
+  {
+    detail::fromNonNegativeInteger(element, value);
+  }
+};
+
+template<>
+struct FieldCodec<StringTag>
+{
+  template<Tag TAG>
+  static size_t
+  prepend(EncodingImpl<TAG>& encoder, uint32_t type, const std::string& value)
+  {
+    return prependStringBlock(encoder, type, value);
+  }
+
+  static void
+  decode(const Block& element, std::string& value)
+  {
+    value = readString(element);
+  }
+};
+
+template<>
+struct FieldCodec<NestedTag>
+{
+  template<Tag TAG, typename T>
+  static size_t
+  prepend(EncodingImpl<TAG>& encoder, uint32_t, const T& value)
+  {
+    return value.wireEncode(encoder);
+  }
+
+  template<typename T>
+  static void
+  decode(const Block& element, T& value)
+  {
+    value.wireDecode(element);
+  }
+};
+
+template<>
+struct FieldCodec<WrappedTag>
+{
+  template<Tag TAG, typename T>
+  static size_t
+  prepend(EncodingImpl<TAG>& encoder, uint32_t type, const T& value)
+  {
+    return prependNestedBlock(encoder, type, value);
+  }
+
+  template<typename T>
+  static void
+  decode(const Block& element, T& value)
+  {
+    element.parse();
+    if (element.elements().empty()) {
+      NDN_THROW(tlv::Error("TLV-TYPE " + to_string(element.type()) + " must contain a nested element"));
+    }
+    value.wireDecode(element.elements().front());
+  }
+};
+
+namespace detail {
+
+/** @brief Encoding and decoding rules that depend on how often a field may occur.
+ *
+ *  A field is required by default, optional if its member type is `optional<T>`,
+ *  and repeatable (zero or more occurrences) if its member type is `std::vector<T>`.
+ */
+template<typename T>
+struct IsRepeated : std::false_type
+{
+};
+
+template<typename T>
+struct IsRepeated<std::vector<T>> : std::true_type
+{
+};
+
+template<typename T>
+struct FieldPresence
+{
+  template<typename Codec, Tag TAG>
+  static size_t
+  prepend(EncodingImpl<TAG>& encoder, uint32_t type, const T& value)
+  {
+    return Codec::prepend(encoder, type, value);
+  }
+
+  template<typename Codec, typename Error>
+  static void
+  decode(Block::element_const_iterator& it, Block::element_const_iterator end, uint32_t type,
+         T& value)
+  {
+    if (it == end || it->type() != type) {
+      NDN_THROW(Error("missing required field of TLV-TYPE " + to_string(type)));
+    }
+    Codec::decode(*it, value);
+    ++it;
+  }
+};
+
+template<typename T>
+struct FieldPresence<optional<T>>
+{
+  template<typename Codec, Tag TAG>
+  static size_t
+  prepend(EncodingImpl<TAG>& encoder, uint32_t type, const optional<T>& value)
+  {
+    return value ? Codec::prepend(encoder, type, *value) : 0;
+  }
+
+  template<typename Codec, typename Error>
+  static void
+  decode(Block::element_const_iterator& it, Block::element_const_iterator end, uint32_t type,
+         optional<T>& value)
+  {
+    if (it == end || it->type() != type) {
+      value = nullopt;
+      return;
+    }
+    T decoded;
+    Codec::decode(*it, decoded);
+    value = std::move(decoded);
+    ++it;
+  }
+};
+
+template<typename T>
+struct FieldPresence<std::vector<T>>
+{
+  template<typename Codec, Tag TAG>
+  static size_t
+  prepend(EncodingImpl<TAG>& encoder, uint32_t type, const std::vector<T>& value)
+  {
+    size_t length = 0;
+    for (const auto& item : value | boost::adaptors::reversed) {
+      length += Codec::prepend(encoder, type, item);
+    }
+    return length;
+  }
+
+  template<typename Codec, typename Error>
+  static void
+  decode(Block::element_const_iterator& it, Block::element_const_iterator end, uint32_t type,
+         std::vector<T>& value)
+  {
+    value.clear();
+    for (; it != end && it->type() == type; ++it) {
+      T decoded;
+      Codec::decode(*it, decoded);
+      value.push_back(std::move(decoded));
+    }
+  }
+};
+
+} // namespace detail
+
+/** @brief Declare a field of a TLV record.
+ *  @tparam TYPE TLV-TYPE number of the field.
+ *  @tparam CODEC_TAG selects a specialization of FieldCodec.
+ *  @tparam MemberPointer type of @p MEMBER.
+ *  @tparam MEMBER pointer to the data member that holds the field value.
+ *  @sa NDN_CXX_RECORD_FIELD
+ */
+template<uint32_t TYPE, typename CODEC_TAG, typename MemberPointer, MemberPointer MEMBER>
+class FieldDecl
+{
+public:
+  using ValueType = typename detail::MemberPointerTraits<MemberPointer>::ValueType;
+  using TlvType = std::integral_constant<uint32_t, TYPE>;
+  using IsRepeated = detail::IsRepeated<ValueType>;
+
+  template<Tag TAG, typename R>
+  static size_t
+  prepend(EncodingImpl<TAG>& encoder, const R& record)
+  {
+    return detail::FieldPresence<ValueType>::template prepend<FieldCodec<CODEC_TAG>>(
+      encoder, TYPE, record.*MEMBER);
+  }
+
+  template<typename Error, typename R>
+  static void
+  decode(Block::element_const_iterator& it, Block::element_const_iterator end, R& record)
+  {
+    detail::FieldPresence<ValueType>::template decode<FieldCodec<CODEC_TAG>, Error>(
+      it, end, TYPE, record.*MEMBER);
+  }
+};
+
+/** @brief Declare a TLV record, i.e., a TLV element whose TLV-VALUE is a sequence of fields.
+ *  @tparam TYPE TLV-TYPE number of the record.
+ *  @tparam FIELDS FieldDecl of each field, in the order of appearance in TLV-VALUE.
+ *
+ *  The encoding and decoding routines of the record are generated at compile time from the
+ *  field list. Unrecognized elements after the last field are ignored during decoding, unless
+ *  the last field is repeated: then every remaining element must belong to that field.
+ */
+template<uint32_t TYPE, typename... FIELDS>
+class RecordDecl
+{
+public:
+  using TlvType = std::integral_constant<uint32_t, TYPE>;
+
+  /** @brief Prepend the wire encoding of @p record to @p encoder.
+   */
+  template<Tag TAG, typename R>
+  static size_t
+  encode(EncodingImpl<TAG>& encoder, const R& record)
+  {
+    size_t totalLength = prependFields<FIELDS...>(encoder, record);
+    totalLength += encoder.prependVarNumber(totalLength);
+    totalLength += encoder.prependVarNumber(TYPE);
+    return totalLength;
+  }
+
+  /** @brief Encode @p record into a new Block of exactly the estimated size.
+   */
+  template<typename R>
+  static Block
+  encode(const R& record)
+  {
+    EncodingEstimator estimator;
+    size_t estimatedSize = encode(estimator, record);
+
+    EncodingBuffer buffer(estimatedSize, 0);
+    encode(buffer, record);
+    return buffer.block();
+  }
+
+  /** @brief Decode @p wire into @p record.
+   *  @tparam Error exception type to throw on decoding failure
+   *  @tparam R record type, must be default-constructible and move-assignable
+   *  @throw Error TLV-TYPE mismatch, a required field is missing, or an unexpected element
+   *               follows a repeated last field
+   *  @throw tlv::Error a field value is malformed
+   *
+   *  The fields are decoded into a temporary, so @p record is left unchanged if decoding fails.
+   */
+  template<typename Error, typename R>
+  static void
+  decode(const Block& wire, R& record)
+  {
+    if (wire.type() != TYPE) {
+      NDN_THROW(Error("Expecting TLV-TYPE " + to_string(TYPE) + ", but TLV has type " +
+                      to_string(wire.type())));
+    }
+
+    wire.parse();
+    auto it = wire.elements_begin();
+    R decoded;
+    decodeFields<Error, FIELDS...>(it, wire.elements_end(), decoded);
+
+    using LastField = std::tuple_element_t<sizeof...(FIELDS) - 1, std::tuple<FIELDS...>>;
+    if (LastField::IsRepeated::value && it != wire.elements_end()) {
+      NDN_THROW(Error("Unexpected TLV-TYPE " + to_string(it->type()) + " after field of TLV-TYPE " +
+                      to_string(LastField::TlvType::value)));
+    }
+
+    record = std::move(decoded);
+  }
+
+private:
+  template<Tag TAG, typename R>
+  static size_t
+  prependFields(EncodingImpl<TAG>&, const R&)
+  {
+    return 0;
+  }
+
+  // fields are prepended in reverse order, so that the first field ends up in front
+  template<typename FIELD, typename... REST, Tag TAG, typename R>
+  static size_t
+  prependFields(EncodingImpl<TAG>& encoder, const R& record)
+  {
+    size_t length = prependFields<REST...>(encoder, record);
+    length += FIELD::prepend(encoder, record);
+    return length;
+  }
+
+  template<typename Error, typename R>
+  static void
+  decodeFields(Block::element_const_iterator&, Block::element_const_iterator, R&)
+  {
+  }
+
+  template<typename Error, typename FIELD, typename... REST, typename R>
+  static void
+  decodeFields(Block::element_const_iterator& it, Block::element_const_iterator end, R& record)
+  {
+    FIELD::template decode<Error>(it, end, record);
+    decodeFields<Error, REST...>(it, end, record);
+  }
+};
+
+} // namespace encoding
+} // namespace ndn
+
+/** @brief Declare a record field held in data member @p member (e.g., `&Foo::m_bar`).
+ *  @sa ndn::encoding::FieldDecl
+ */
+#define NDN_CXX_RECORD_FIELD(type, codecTag, member) \
+  ::ndn::encoding::FieldDecl<type, ::ndn::encoding::codecTag, decltype(member), member>
+
+#endif // NDN_ENCODING_RECORD_DECL_HPP
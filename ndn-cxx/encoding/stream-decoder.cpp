@@ -0,0 +1,177 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/encoding/stream-decoder.hpp"
+#include "ndn-cxx/encoding/buffer-pool.hpp"
+
+#include <cstring>
+
+namespace ndn {
+namespace encoding {
+
+static size_t
+getVarNumberSize(uint8_t firstOctet) noexcept
+{
+  switch (firstOctet) {
+    case 253:
+      return 3;
+    case 254:
+      return 5;
+    case 255:
+      return 9;
+    default:
+      return 1;
+  }
+}
+
+StreamDecoder::StreamDecoder(size_t maxElementSize)
+  : m_maxElementSize(maxElementSize)
+{
+}
+
+void
+StreamDecoder::reset() noexcept
+{
+  m_state = State::TYPE;
+  m_headerSize = 0;
+  m_varNumberBegin = 0;
+  m_varNumberEnd = 0;
+  m_type = tlv::Invalid;
+  m_valueOffset = 0;
+  m_element.reset();
+  m_elementSize = 0;
+}
+
+void
+StreamDecoder::decode(const uint8_t* buf, size_t size, const ElementCallback& onElement)
+{
+  const uint8_t* const end = buf + size;
+  while (buf != end) {
+    if (m_state == State::TYPE && m_headerSize == 0) {
+      buf += decodeComplete(buf, end - buf, onElement);
+      if (buf == end) {
+        break;
+      }
+    }
+
+    if (m_state != State::VALUE) {
+      buf += decodeHeader(buf, end - buf);
+      if (m_state != State::VALUE || m_elementSize < m_element->size()) {
+        continue;
+      }
+      // zero-length TLV-VALUE, element is already complete
+    }
+    else {
+      size_t nCopy = std::min(static_cast<size_t>(end - buf), m_element->size() - m_elementSize);
+      std::memcpy(m_element->data() + m_elementSize, buf, nCopy);
+      m_elementSize += nCopy;
+      buf += nCopy;
+      if (m_elementSize < m_element->size()) {
+        continue;
+      }
+    }
+
+    auto element = std::move(m_element);
+    uint32_t type = m_type;
+    size_t valueOffset = m_valueOffset;
+    reset();
+    onElement(Block(element, type, element->begin(), element->end(),
+                    element->begin() + valueOffset, element->end()));
+  }
+}
+
+size_t
+StreamDecoder::decodeComplete(const uint8_t* buf, size_t size, const ElementCallback& onElement)
+{
+  size_t nConsumed = 0;
+  tlv::ElementHeader headers[16];
+  while (nConsumed < size) {
+    size_t nHeaders = tlv::scanElementHeaders(buf + nConsumed, size - nConsumed,
+                                              headers, std::extent<decltype(headers)>::value);
+    const uint8_t* const chunk = buf + nConsumed;
+    for (size_t i = 0; i < nHeaders; ++i) {
+      const tlv::ElementHeader& header = headers[i];
+      size_t elementSize = header.size + static_cast<size_t>(header.length);
+      if (elementSize > m_maxElementSize) {
+        // leave it to decodeHeader() to report the error
+        return nConsumed;
+      }
+
+      auto element = BufferPool::get().allocate(chunk + header.offset, elementSize);
+      nConsumed += elementSize;
+      onElement(Block(element, header.type, element->begin(), element->end(),
+                      element->begin() + header.size, element->end()));
+    }
+
+    if (nHeaders < std::extent<decltype(headers)>::value) {
+      break;
+    }
+  }
+  return nConsumed;
+}
+
+size_t
+StreamDecoder::decodeHeader(const uint8_t* buf, size_t size)
+{
+  size_t nConsumed = 0;
+  while (nConsumed < size && m_state != State::VALUE) {
+    if (m_headerSize == m_varNumberBegin) {
+      // first octet of a VAR-NUMBER determines its size
+      m_varNumberEnd = m_varNumberBegin + getVarNumberSize(buf[nConsumed]);
+    }
+
+    size_t nCopy = std::min(size - nConsumed, m_varNumberEnd - m_headerSize);
+    std::memcpy(m_header + m_headerSize, buf + nConsumed, nCopy);
+    m_headerSize += nCopy;
+    nConsumed += nCopy;
+    if (m_headerSize < m_varNumberEnd) {
+      break;
+    }
+
+    const uint8_t* pos = m_header + m_varNumberBegin;
+    const uint8_t* const end = m_header + m_headerSize;
+    if (m_state == State::TYPE) {
+      if (!tlv::readType(pos, end, m_type)) {
+        reset();
+        NDN_THROW(Error("Illegal TLV-TYPE in stream"));
+      }
+      m_state = State::LENGTH;
+      m_varNumberBegin = m_headerSize;
+      continue;
+    }
+
+    uint64_t length = 0;
+    tlv::readVarNumber(pos, end, length); // cannot fail, all octets are present
+    if (m_headerSize > m_maxElementSize || length > m_maxElementSize - m_headerSize) {
+      reset();
+      NDN_THROW(Error("TLV-LENGTH from stream exceeds limit"));
+    }
+
+    m_element = BufferPool::get().allocate(m_headerSize + static_cast<size_t>(length));
+    std::memcpy(m_element->data(), m_header, m_headerSize);
+    m_elementSize = m_valueOffset = m_headerSize;
+    m_state = State::VALUE;
+  }
+  return nConsumed;
+}
+
+} // namespace encoding
+} // namespace ndn
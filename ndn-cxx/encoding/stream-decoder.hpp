@@ -0,0 +1,138 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_ENCODING_STREAM_DECODER_HPP
+#define NDN_ENCODING_STREAM_DECODER_HPP
+
+#include "ndn-cxx/encoding/block.hpp"
+
+namespace ndn {
+namespace encoding {
+
+/**
+ * @brief Resumable decoder that extracts TLV elements from a byte stream
+ *
+ * Bytes are fed in arbitrarily sized chunks. The decoder parses TLV-TYPE and TLV-LENGTH as soon
+ * as their octets arrive, then allocates a wire buffer of the exact element size and copies each
+ * following chunk into it, so that octets already received are never parsed again.
+ * Elements that arrive entirely within one chunk are located in bulk with
+ * tlv::scanElementHeaders() and bypass the state machine.
+ * Every complete element is delivered as a Block that owns its wire buffer.
+ */
+class StreamDecoder : noncopyable
+{
+public:
+  class Error : public tlv::Error
+  {
+  public:
+    using tlv::Error::Error;
+  };
+
+  using ElementCallback = function<void(const Block& element)>;
+
+  /**
+   * @brief Create a decoder
+   * @param maxElementSize maximum accepted size of an element, including TLV-TYPE and TLV-LENGTH
+   */
+  explicit
+  StreamDecoder(size_t maxElementSize = MAX_NDN_PACKET_SIZE);
+
+  /**
+   * @brief Consume a chunk of the stream
+   * @param buf pointer to the chunk
+   * @param size size of the chunk
+   * @param onElement invoked for each element completed by this chunk
+   * @throw Error TLV-TYPE is invalid, or the declared element size exceeds the limit;
+   *              the decoder is reset and the rest of the chunk is discarded
+   */
+  void
+  decode(const uint8_t* buf, size_t size, const ElementCallback& onElement);
+
+  /**
+   * @brief Get the total size of the element being decoded
+   * @return size including TLV-TYPE and TLV-LENGTH, or nullopt if TLV-LENGTH is not known yet
+   *
+   * This allows a receiver to learn how many more octets to expect before the element is
+   * complete, e.g., to size its next read accordingly.
+   */
+  optional<size_t>
+  getExpectedSize() const noexcept
+  {
+    if (m_state != State::VALUE) {
+      return nullopt;
+    }
+    return m_element->size();
+  }
+
+  /**
+   * @brief Get the number of octets of the current, incomplete element received so far
+   */
+  size_t
+  getReceivedSize() const noexcept
+  {
+    return m_state == State::VALUE ? m_elementSize : m_headerSize;
+  }
+
+  /**
+   * @brief Discard any partially received element
+   */
+  void
+  reset() noexcept;
+
+private:
+  /** @brief deliver elements that are entirely contained in the chunk, at an element boundary
+   *  @return number of octets consumed
+   */
+  size_t
+  decodeComplete(const uint8_t* buf, size_t size, const ElementCallback& onElement);
+
+  /** @brief consume octets of TLV-TYPE and TLV-LENGTH
+   *  @return number of octets consumed
+   */
+  size_t
+  decodeHeader(const uint8_t* buf, size_t size);
+
+private:
+  enum class State {
+    TYPE,
+    LENGTH,
+    VALUE,
+  };
+
+  const size_t m_maxElementSize;
+  State m_state = State::TYPE;
+
+  // TLV-TYPE and TLV-LENGTH are collected here until both are complete
+  uint8_t m_header[18];
+  size_t m_headerSize = 0;
+  size_t m_varNumberBegin = 0; // offset in m_header of the VAR-NUMBER being collected
+  size_t m_varNumberEnd = 0;
+  uint32_t m_type = tlv::Invalid;
+  size_t m_valueOffset = 0;
+
+  shared_ptr<Buffer> m_element;
+  size_t m_elementSize = 0; // number of octets written into m_element
+};
+
+} // namespace encoding
+} // namespace ndn
+
+#endif // NDN_ENCODING_STREAM_DECODER_HPP
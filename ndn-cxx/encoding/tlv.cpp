@@ -79,5 +79,65 @@ operator<<(std::ostream& os, ContentTypeValue ct)
   return os << static_cast<uint32_t>(ct) << ')';
 }
 
+/**
+ * @brief Decode a VAR-NUMBER without bounds checking.
+ * @pre at least 9 octets are readable at @p pos
+ * @param[out] size number of octets occupied by the VAR-NUMBER
+ */
+static uint64_t
+readVarNumberUnchecked(const uint8_t* pos, size_t& size) noexcept
+{
+  uint8_t firstOctet = pos[0];
+  uint64_t following = 0;
+  std::memcpy(&following, pos + 1, sizeof(following));
+  following = boost::endian::big_to_native(following);
+
+  // 253, 254, 255 are followed by 2, 4, 8 octets respectively
+  size_t width = static_cast<size_t>(firstOctet >= 253) << (((firstOctet - 253) & 0x03) + 1);
+  size = 1 + width;
+  uint64_t wide = following >> ((64 - 8 * width) & 0x3f);
+  return width == 0 ? firstOctet : wide;
+}
+
+size_t
+scanElementHeaders(const uint8_t* buf, size_t size, ElementHeader* headers, size_t maxHeaders) noexcept
+{
+  // the longest possible TLV-TYPE and TLV-LENGTH are 9 octets each
+  const size_t MAX_HEADER_SIZE = 18;
+
+  const uint8_t* pos = buf;
+  const uint8_t* const end = buf + size;
+  size_t nHeaders = 0;
+  while (nHeaders < maxHeaders && pos != end) {
+    uint64_t type = 0;
+    uint64_t length = 0;
+    const uint8_t* valuePos = pos;
+
+    if (static_cast<size_t>(end - pos) >= MAX_HEADER_SIZE) {
+      size_t typeSize = 0;
+      size_t lengthSize = 0;
+      type = readVarNumberUnchecked(pos, typeSize);
+      length = readVarNumberUnchecked(pos + typeSize, lengthSize);
+      valuePos += typeSize + lengthSize;
+    }
+    else if (!readVarNumber(valuePos, end, type) || !readVarNumber(valuePos, end, length)) {
+      break;
+    }
+
+    if (type == Invalid || type > std::numeric_limits<uint32_t>::max() ||
+        length > static_cast<uint64_t>(end - valuePos)) {
+      break;
+    }
+
+    ElementHeader& header = headers[nHeaders++];
+    header.type = static_cast<uint32_t>(type);
+    header.size = static_cast<uint32_t>(valuePos - pos);
+    header.length = length;
+    header.offset = static_cast<size_t>(pos - buf);
+    pos = valuePos + length;
+  }
+  return nHeaders;
+}
+
 } // namespace tlv
 } // namespace ndn
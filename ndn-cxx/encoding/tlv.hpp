@@ -282,6 +282,35 @@ sizeOfNonNegativeInteger(uint64_t integer) noexcept;
 size_t
 writeNonNegativeInteger(std::ostream& os, uint64_t integer);
 
+/**
+ * @brief TLV-TYPE and TLV-LENGTH of an element found by scanElementHeaders().
+ */
+struct ElementHeader
+{
+  uint32_t type;     ///< TLV-TYPE
+  uint32_t size;     ///< combined size of TLV-TYPE and TLV-LENGTH fields
+  uint64_t length;   ///< TLV-LENGTH
+  size_t offset;     ///< offset of the first octet of the element within the scanned buffer
+};
+
+/**
+ * @brief Scan the headers of consecutive TLV elements in a contiguous buffer.
+ *
+ * Unlike calling readType() and readVarNumber() for each element, this function decodes both
+ * fields with unaligned word loads and without per-octet branches whenever enough input remains,
+ * which makes it suitable for locating element boundaries in a whole packet or received chunk.
+ *
+ * @param buf        Begin of the buffer, which must start at an element boundary
+ * @param size       Size of the buffer
+ * @param[out] headers Array to store the scanned headers
+ * @param maxHeaders Capacity of @p headers
+ *
+ * @return number of headers stored in @p headers. Scanning stops early at the end of the
+ *         buffer, or at the first element that has an illegal TLV-TYPE or is truncated.
+ */
+size_t
+scanElementHeaders(const uint8_t* buf, size_t size, ElementHeader* headers, size_t maxHeaders) noexcept;
+
 /////////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////////
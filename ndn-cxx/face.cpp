@@ -29,13 +29,13 @@
 
 // NDN_LOG_INIT(ndn.Face) is declared in face-impl.hpp
 
-// A callback scheduled through io.post and io.dispatch may be invoked after the face is destructed.
-// To prevent this situation, use these macros to capture Face::m_impl as weak_ptr and skip callback
-// execution if the face has been destructed.
+// A callback scheduled through Impl::post and Impl::dispatch may be invoked after the face is
+// destructed. To prevent this situation, use these macros to capture Face::m_impl as weak_ptr and
+// skip callback execution if the face has been destructed.
 #define IO_CAPTURE_WEAK_IMPL(OP) \
   { \
     weak_ptr<Impl> implWeak(m_impl); \
-    m_ioService.OP([=] { \
+    m_impl->OP([=] { \
       auto impl = implWeak.lock(); \
       if (impl != nullptr) {
 #define IO_CAPTURE_WEAK_IMPL_END \
@@ -109,6 +109,7 @@ Face::makeDefaultTransport()
 {
   // transport=unix:///var/run/nfd.sock
   // transport=tcp://localhost:6363
+  // transport=shm:///var/run/nfd-shm.sock
 
   std::string transportUri;
 
@@ -137,6 +138,9 @@ Face::makeDefaultTransport()
     else if (protocol == "tcp" || protocol == "tcp4" || protocol == "tcp6") {
       return TcpTransport::create(transportUri);
     }
+    else if (protocol == "shm") {
+      return ShmTransport::create(transportUri);
+    }
     else {
       NDN_THROW(ConfigFile::Error("Unsupported transport protocol \"" + protocol + "\""));
     }
@@ -184,13 +188,81 @@ Face::expressInterest(const Interest& interest,
   auto interest2 = make_shared<Interest>(interest);
   interest2->getNonce();
 
+  // the callbacks are copied once, into a single object that the PIT record holds
+  auto callbacks = make_shared<InterestCallbacks>(m_impl->wrapCallback(afterSatisfied),
+                                                  m_impl->wrapCallback(afterNacked),
+                                                  m_impl->wrapCallback(afterTimeout));
+
+  IO_CAPTURE_WEAK_IMPL(post) {
+    impl->asyncExpressInterest(id, interest2, callbacks);
+  } IO_CAPTURE_WEAK_IMPL_END
+
+  return PendingInterestHandle(*this, reinterpret_cast<const PendingInterestId*>(id));
+}
+
+PendingInterestHandle
+Face::expressInterest(const Interest& interest, InterestContinuation& continuation)
+{
+  auto id = m_impl->m_pendingInterestTable.allocateId();
+
+  auto interest2 = make_shared<Interest>(interest);
+  interest2->getNonce();
+
+  auto cont = &continuation;
+  shared_ptr<InterestContinuation> cont2;
+  if (m_impl->m_callbackExecutor != nullptr) {
+    // the executor needs copyable callbacks that it can run later
+    DataCallback onData = [cont] (const Interest& i, const Data& d) { cont->onData(i, d); };
+    NackCallback onNack = [cont] (const Interest& i, const lp::Nack& n) { cont->onNack(i, n); };
+    TimeoutCallback onTimeout = [cont] (const Interest& i) { cont->onTimeout(i); };
+    function<void(const Interest&)> onCancel = [cont] (const Interest& i) { cont->onCancel(i); };
+    cont2 = make_shared<InterestCallbacks>(m_impl->wrapCallback(onData),
+                                           m_impl->wrapCallback(onNack),
+                                           m_impl->wrapCallback(onTimeout),
+                                           m_impl->wrapCallback(onCancel));
+  }
+  else {
+    // non-owning pointer: the caller keeps the continuation alive
+    cont2 = shared_ptr<InterestContinuation>(shared_ptr<void>(), cont);
+  }
+
   IO_CAPTURE_WEAK_IMPL(post) {
-    impl->asyncExpressInterest(id, interest2, afterSatisfied, afterNacked, afterTimeout);
+    impl->asyncExpressInterest(id, interest2, cont2);
   } IO_CAPTURE_WEAK_IMPL_END
 
   return PendingInterestHandle(*this, reinterpret_cast<const PendingInterestId*>(id));
 }
 
+std::vector<PendingInterestHandle>
+Face::expressInterests(std::vector<Interest> interests,
+                       const DataCallback& afterSatisfied,
+                       const NackCallback& afterNacked,
+                       const TimeoutCallback& afterTimeout)
+{
+  std::vector<PendingInterestHandle> handles;
+  if (interests.empty()) {
+    return handles;
+  }
+
+  auto firstId = m_impl->m_pendingInterestTable.allocateIds(interests.size());
+  handles.reserve(interests.size());
+  for (size_t i = 0; i < interests.size(); ++i) {
+    interests[i].getNonce();
+    handles.emplace_back(*this, reinterpret_cast<const PendingInterestId*>(firstId + i));
+  }
+
+  auto batch = make_shared<const std::vector<Interest>>(std::move(interests));
+  auto callbacks = make_shared<InterestCallbacks>(m_impl->wrapCallback(afterSatisfied),
+                                                  m_impl->wrapCallback(afterNacked),
+                                                  m_impl->wrapCallback(afterTimeout));
+
+  IO_CAPTURE_WEAK_IMPL(post) {
+    impl->asyncExpressInterests(firstId, batch, callbacks);
+  } IO_CAPTURE_WEAK_IMPL_END
+
+  return handles;
+}
+
 void
 Face::cancelPendingInterest(const PendingInterestId* pendingInterestId)
 {
@@ -221,6 +293,16 @@ Face::put(Data data)
   } IO_CAPTURE_WEAK_IMPL_END
 }
 
+void
+Face::putBatch(std::vector<Data> data)
+{
+  auto batch = make_shared<const std::vector<Data>>(std::move(data));
+
+  IO_CAPTURE_WEAK_IMPL(post) {
+    impl->asyncPutDataBatch(*batch);
+  } IO_CAPTURE_WEAK_IMPL_END
+}
+
 void
 Face::put(lp::Nack nack)
 {
@@ -229,6 +311,14 @@ Face::put(lp::Nack nack)
   } IO_CAPTURE_WEAK_IMPL_END
 }
 
+void
+Face::setContentStore(shared_ptr<InMemoryStorage> contentStore)
+{
+  IO_CAPTURE_WEAK_IMPL(dispatch) {
+    impl->m_contentStore = contentStore;
+  } IO_CAPTURE_WEAK_IMPL_END
+}
+
 RegisteredPrefixHandle
 Face::setInterestFilter(const InterestFilter& filter, const InterestCallback& onInterest,
                         const RegisterPrefixFailureCallback& onFailure,
@@ -246,8 +336,16 @@ Face::setInterestFilter(const InterestFilter& filter, const InterestCallback& on
   nfd::CommandOptions options;
   options.setSigningInfo(signingInfo);
 
-  auto id = m_impl->registerPrefix(filter.getPrefix(), onSuccess, onFailure, flags, options,
-                                   filter, onInterest);
+  auto id = m_impl->m_registeredPrefixTable.allocateId();
+  auto onInterest2 = m_impl->wrapCallback(onInterest);
+  auto onSuccess2 = m_impl->wrapCallback(onSuccess);
+  auto onFailure2 = m_impl->wrapCallback(onFailure);
+
+  IO_CAPTURE_WEAK_IMPL(dispatch) {
+    impl->registerPrefix(id, filter.getPrefix(), onSuccess2, onFailure2, flags, options,
+                         filter, onInterest2);
+  } IO_CAPTURE_WEAK_IMPL_END
+
   return RegisteredPrefixHandle(*this, reinterpret_cast<const RegisteredPrefixId*>(id));
 }
 
@@ -255,9 +353,10 @@ InterestFilterHandle
 Face::setInterestFilter(const InterestFilter& filter, const InterestCallback& onInterest)
 {
   auto id = m_impl->m_interestFilterTable.allocateId();
+  auto onInterest2 = m_impl->wrapCallback(onInterest);
 
   IO_CAPTURE_WEAK_IMPL(post) {
-    impl->asyncSetInterestFilter(id, filter, onInterest);
+    impl->asyncSetInterestFilter(id, filter, onInterest2);
   } IO_CAPTURE_WEAK_IMPL_END
 
   return InterestFilterHandle(*this, reinterpret_cast<const InterestFilterId*>(id));
@@ -281,7 +380,14 @@ Face::registerPrefix(const Name& prefix,
   nfd::CommandOptions options;
   options.setSigningInfo(signingInfo);
 
-  auto id = m_impl->registerPrefix(prefix, onSuccess, onFailure, flags, options, nullopt, nullptr);
+  auto id = m_impl->m_registeredPrefixTable.allocateId();
+  auto onSuccess2 = m_impl->wrapCallback(onSuccess);
+  auto onFailure2 = m_impl->wrapCallback(onFailure);
+
+  IO_CAPTURE_WEAK_IMPL(dispatch) {
+    impl->registerPrefix(id, prefix, onSuccess2, onFailure2, flags, options, nullopt, nullptr);
+  } IO_CAPTURE_WEAK_IMPL_END
+
   return RegisteredPrefixHandle(*this, reinterpret_cast<const RegisteredPrefixId*>(id));
 }
 
@@ -290,12 +396,30 @@ Face::unregisterPrefixImpl(const RegisteredPrefixId* registeredPrefixId,
                            const UnregisterPrefixSuccessCallback& onSuccess,
                            const UnregisterPrefixFailureCallback& onFailure)
 {
+  auto onSuccess2 = m_impl->wrapCallback(onSuccess);
+  auto onFailure2 = m_impl->wrapCallback(onFailure);
+
   IO_CAPTURE_WEAK_IMPL(post) {
     impl->asyncUnregisterPrefix(reinterpret_cast<RecordId>(registeredPrefixId),
-                                onSuccess, onFailure);
+                                onSuccess2, onFailure2);
   } IO_CAPTURE_WEAK_IMPL_END
 }
 
+void
+Face::enableMultiThreading(const CallbackExecutor& executor)
+{
+  if (m_impl->m_submissionQueue == nullptr) {
+    m_impl->m_submissionQueue = make_unique<SubmissionQueue>();
+  }
+  m_impl->m_callbackExecutor = executor;
+}
+
+void
+Face::enableInterestAggregation()
+{
+  m_impl->m_isAggregatingInterests = true;
+}
+
 void
 Face::doProcessEvents(time::milliseconds timeout, bool keepThread)
 {
@@ -337,7 +461,7 @@ void
 Face::shutdown()
 {
   IO_CAPTURE_WEAK_IMPL(post) {
-    impl->m_pendingInterestTable.clear();
+    impl->asyncRemoveAllPendingInterests();
     impl->m_registeredPrefixTable.clear();
 
     if (m_transport->isConnected())
@@ -347,46 +471,51 @@ Face::shutdown()
   } IO_CAPTURE_WEAK_IMPL_END
 }
 
-/**
- * @brief extract local fields from NDNLPv2 packet and tag onto a network layer packet
- */
-template<typename NetPkt>
-static void
-extractLpLocalFields(NetPkt& netPacket, const lp::Packet& lpPacket)
-{
-  addTagFromField<lp::IncomingFaceIdTag, lp::IncomingFaceIdField>(netPacket, lpPacket);
-  addTagFromField<lp::CongestionMarkTag, lp::CongestionMarkField>(netPacket, lpPacket);
-}
-
 void
 Face::onReceiveElement(const Block& blockFromDaemon)
 {
-  lp::Packet lpPacket(blockFromDaemon); // bare Interest/Data is a valid lp::Packet,
-                                        // no need to distinguish
+  // bare Interest/Data is a valid lp::Packet, but skip wrapping it into an LpPacket
+  if (blockFromDaemon.type() == tlv::Interest || blockFromDaemon.type() == tlv::Data) {
+    onReceiveNetPacket(blockFromDaemon, nullptr);
+    return;
+  }
+
+  lp::Packet lpPacket(blockFromDaemon);
 
   Buffer::const_iterator begin, end;
   std::tie(begin, end) = lpPacket.get<lp::FragmentField>();
-  Block netPacket(&*begin, std::distance(begin, end));
+  // the fragment shares the buffer of blockFromDaemon instead of being copied
+  Block netPacket(blockFromDaemon, begin, end, true);
+  onReceiveNetPacket(netPacket, &lpPacket);
+}
+
+void
+Face::onReceiveNetPacket(const Block& netPacket, const lp::Packet* lpPacket)
+{
   switch (netPacket.type()) {
     case tlv::Interest: {
-      auto interest = make_shared<Interest>(netPacket);
-      if (lpPacket.has<lp::NackField>()) {
+      auto interest = Impl::decodeRecycled(m_impl->m_recycledInterest, netPacket);
+      if (lpPacket != nullptr && lpPacket->has<lp::NackField>()) {
         auto nack = make_shared<lp::Nack>(std::move(*interest));
-        nack->setHeader(lpPacket.get<lp::NackField>());
-        extractLpLocalFields(*nack, lpPacket);
+        nack->setHeader(lpPacket->get<lp::NackField>());
+        m_impl->extractLpLocalFields(*nack, *lpPacket);
         NDN_LOG_DEBUG(">N " << nack->getInterest() << '~' << nack->getHeader().getReason());
         m_impl->nackPendingInterests(*nack);
       }
       else {
-        extractLpLocalFields(*interest, lpPacket);
+        if (lpPacket != nullptr) {
+          m_impl->extractLpLocalFields(*interest, *lpPacket);
+        }
         NDN_LOG_DEBUG(">I " << *interest);
         m_impl->processIncomingInterest(std::move(interest));
       }
       break;
     }
     case tlv::Data: {
-      auto data = make_shared<Data>(netPacket);
-      extractLpLocalFields(*data, lpPacket);
+      auto data = Impl::decodeRecycled(m_impl->m_recycledData, netPacket);
+      if (lpPacket != nullptr) {
+        m_impl->extractLpLocalFields(*data, *lpPacket);
+      }
       NDN_LOG_DEBUG(">D " << data->getName());
       m_impl->satisfyPendingInterests(*data);
       break;
@@ -34,6 +34,7 @@
 
 namespace ndn {
 
+class InMemoryStorage;
 class Transport;
 
 class PendingInterestId;
@@ -43,6 +44,10 @@ class RegisteredPrefixHandle;
 class InterestFilterId;
 class InterestFilterHandle;
 
+namespace lp {
+class Packet;
+} // namespace lp
+
 namespace nfd {
 class Controller;
 } // namespace nfd
@@ -62,6 +67,41 @@ typedef function<void(const Interest&, const lp::Nack&)> NackCallback;
  */
 typedef function<void(const Interest&)> TimeoutCallback;
 
+/**
+ * @brief Receiver of the outcome of an expressed Interest
+ *
+ * Unlike the DataCallback, NackCallback, and TimeoutCallback triple, a continuation is neither
+ * copied nor type-erased: the pending Interest record keeps a pointer to it, and exactly one of
+ * its methods is invoked when the Interest is satisfied, Nacked, or times out, or when the Face
+ * drops it in Face::removeAllPendingInterests() or Face::shutdown(). This is the building block
+ * for awaitable wrappers, see ndn-cxx/util/coroutine.hpp.
+ */
+class InterestContinuation
+{
+public:
+  virtual
+  ~InterestContinuation() = default;
+
+  virtual void
+  onData(const Interest& interest, const Data& data) = 0;
+
+  virtual void
+  onNack(const Interest& interest, const lp::Nack& nack) = 0;
+
+  virtual void
+  onTimeout(const Interest& interest) = 0;
+
+  /**
+   * @brief Invoked when the Interest is dropped by removeAllPendingInterests() or shutdown()
+   *
+   * Canceling a single Interest through its PendingInterestHandle does not invoke this method.
+   */
+  virtual void
+  onCancel(const Interest& interest)
+  {
+  }
+};
+
 /**
  * @brief Callback invoked when incoming Interest matches the specified InterestFilter
  */
@@ -87,6 +127,11 @@ typedef function<void()> UnregisterPrefixSuccessCallback;
  */
 typedef function<void(const std::string&)> UnregisterPrefixFailureCallback;
 
+/**
+ * @brief Function that executes an application callback, typically on a thread pool
+ */
+typedef function<void(const function<void()>&)> CallbackExecutor;
+
 /**
  * @brief Provide a communication channel with local or remote NDN forwarder
  */
@@ -240,6 +285,40 @@ public: // consumer
                   const NackCallback& afterNacked,
                   const TimeoutCallback& afterTimeout);
 
+  /**
+   * @brief Express Interest, reporting its outcome to a continuation
+   * @param interest the Interest; a copy will be made, so that the caller is not
+   *                 required to maintain the argument unchanged
+   * @param continuation receiver of the outcome; it is not copied, and the caller must keep it
+   *                     alive until one of its methods has been invoked, or until the Interest
+   *                     has been canceled and the cancellation has been processed by the Face
+   * @throw OversizedPacketError encoded Interest size exceeds MAX_NDN_PACKET_SIZE
+   * @return A handle for canceling the pending Interest.
+   *
+   * In multi-threaded mode with a callback executor, the continuation is invoked via the executor
+   * like any other callback.
+   */
+  PendingInterestHandle
+  expressInterest(const Interest& interest, InterestContinuation& continuation);
+
+  /**
+   * @brief Express several Interests at once
+   * @param interests the Interests, which are moved into a buffer shared by their PIT records
+   * @param afterSatisfied function to be invoked if Data is returned for any of the Interests
+   * @param afterNacked function to be invoked if Network NACK is returned for any of the Interests
+   * @param afterTimeout function to be invoked if any of the Interests times out
+   * @throw OversizedPacketError encoded size of an Interest exceeds MAX_NDN_PACKET_SIZE
+   * @return handles for canceling the pending Interests, in the same order as @p interests
+   *
+   * This is equivalent to calling expressInterest() on each Interest, except that all Interests
+   * are submitted to the I/O thread together and handed to the transport as one batch.
+   */
+  std::vector<PendingInterestHandle>
+  expressInterests(std::vector<Interest> interests,
+                   const DataCallback& afterSatisfied,
+                   const NackCallback& afterNacked,
+                   const TimeoutCallback& afterTimeout);
+
   /**
    * @deprecated use PendingInterestHandle::cancel()
    */
@@ -252,6 +331,9 @@ public: // consumer
 
   /**
    * @brief Cancel all previously expressed Interests
+   *
+   * InterestContinuation::onCancel() is invoked for every Interest that was expressed with a
+   * continuation. shutdown() does the same.
    */
   void
   removeAllPendingInterests();
@@ -399,6 +481,18 @@ public: // producer
   void
   put(Data data);
 
+  /**
+   * @brief Publish several data packets at once
+   * @param data the Data packets
+   *
+   * This is equivalent to calling put() on each packet, except that all packets are submitted to
+   * the I/O thread together and handed to the transport as one batch.
+   *
+   * @throw OversizedPacketError encoded size of a Data exceeds MAX_NDN_PACKET_SIZE
+   */
+  void
+  putBatch(std::vector<Data> data);
+
   /**
    * @brief Send a network NACK
    * @param nack the Nack; a copy will be made, so that the caller is not required to
@@ -408,6 +502,25 @@ public: // producer
   void
   put(lp::Nack nack);
 
+  /**
+   * @brief Answer incoming Interests from a content store
+   * @param contentStore the content store, which may use any InMemoryStorage policy;
+   *                     nullptr disables the content store
+   *
+   * When an Interest from the forwarder matches a Data packet in @p contentStore, the Data is
+   * sent back immediately, without invoking any InterestFilter callback. Every Data passed to
+   * put() or putBatch() is inserted into @p contentStore, unless it carries a CachePolicyTag
+   * with NO_CACHE policy.
+   *
+   * Such Data stop answering Interests with MustBeFresh after their FreshnessPeriod, provided
+   * that @p contentStore has been constructed with the io_service of this Face; otherwise,
+   * InMemoryStorage ignores MustBeFresh.
+   *
+   * @warning @p contentStore may only be accessed from the thread that runs processEvents().
+   */
+  void
+  setContentStore(shared_ptr<InMemoryStorage> contentStore);
+
 public: // IO routine
   /**
    * @brief Process any data to receive or call timeout callbacks.
@@ -460,6 +573,43 @@ public: // IO routine
   void
   shutdown();
 
+  /**
+   * @brief Allow this face to be used from multiple threads
+   * @param executor if not null, application callbacks are handed to this function, instead of
+   *                 being invoked on the thread that processes events
+   *
+   * After this call, expressInterest(), put(), setInterestFilter(), registerPrefix(), shutdown(),
+   * and the cancel/unregister methods of the returned handles may be called from any thread.
+   * They append the operation to a submission queue, and the thread that runs processEvents()
+   * executes queued operations in batches.
+   *
+   * If @p executor is given, callbacks passed to these methods after this call receive copies of
+   * their arguments, so that they can run concurrently with event processing.
+   *
+   * @warning This method must be called before the face is used from any other thread.
+   *          processEvents() must still be called from a single thread, and getNPendingInterests()
+   *          may only be called from that thread.
+   */
+  void
+  enableMultiThreading(const CallbackExecutor& executor = nullptr);
+
+  /**
+   * @brief Aggregate Interests that are identical to an outstanding Interest
+   *
+   * After this call, an Interest expressed while an identical Interest from this face is pending
+   * is not sent to the forwarder. Instead, it is satisfied by the same Data, or Nacked by the same
+   * Nack, as the outstanding Interest. Two Interests are identical if they have the same Name,
+   * CanBePrefix, MustBeFresh, ForwardingHint, and NextHopFaceId tag. An Interest that would time
+   * out after the outstanding one is sent to the forwarder as usual.
+   *
+   * If the outstanding Interest is canceled, one of the Interests aggregated with it is sent to
+   * the forwarder in its place.
+   *
+   * @warning This method must be called before any Interest is expressed.
+   */
+  void
+  enableInterestAggregation();
+
   /**
    * @return reference to io_service object
    */
@@ -497,6 +647,12 @@ private:
   void
   onReceiveElement(const Block& blockFromDaemon);
 
+  /**
+   * @param lpPacket the enclosing NDNLPv2 packet, or nullptr if @p netPacket was received bare
+   */
+  void
+  onReceiveNetPacket(const Block& netPacket, const lp::Packet* lpPacket);
+
   void
   cancelPendingInterest(const PendingInterestId* pendingInterestId);
 
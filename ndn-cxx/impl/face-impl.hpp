@@ -23,13 +23,16 @@
 #define NDN_IMPL_FACE_IMPL_HPP
 
 #include "ndn-cxx/face.hpp"
+#include "ndn-cxx/ims/in-memory-storage.hpp"
 #include "ndn-cxx/impl/lp-field-tag.hpp"
 #include "ndn-cxx/impl/pending-interest.hpp"
 #include "ndn-cxx/impl/registered-prefix.hpp"
+#include "ndn-cxx/impl/submission-queue.hpp"
 #include "ndn-cxx/lp/packet.hpp"
 #include "ndn-cxx/lp/tags.hpp"
 #include "ndn-cxx/mgmt/nfd/command-options.hpp"
 #include "ndn-cxx/mgmt/nfd/controller.hpp"
+#include "ndn-cxx/transport/shm-transport.hpp"
 #include "ndn-cxx/transport/tcp-transport.hpp"
 #include "ndn-cxx/transport/unix-transport.hpp"
 #include "ndn-cxx/util/config-file.hpp"
@@ -37,6 +40,8 @@
 #include "ndn-cxx/util/scheduler.hpp"
 #include "ndn-cxx/util/signal.hpp"
 
+#include <unordered_map>
+
 NDN_LOG_INIT(ndn.Face);
 // INFO level: prefix registration, etc.
 //
@@ -55,7 +60,7 @@ namespace ndn {
 
 /** @brief implementation detail of Face
  */
-class Face::Impl : noncopyable
+class Face::Impl : public std::enable_shared_from_this<Face::Impl>, noncopyable
 {
 public:
   using PendingInterestTable = RecordContainer<PendingInterest>;
@@ -79,40 +84,165 @@ public:
     m_registeredPrefixTable.onEmpty.connect(postOnEmptyPitOrNoRegisteredPrefixes);
   }
 
+public: // submission
+  /** @brief execute @p task on the I/O thread, after the current handler returns
+   *
+   *  In multi-threaded mode, @p task is appended to the submission queue, which the I/O thread
+   *  drains in batches. Otherwise, @p task is posted to the io_service.
+   */
+  void
+  post(SubmissionQueue::Task task)
+  {
+    if (m_submissionQueue == nullptr) {
+      m_face.getIoService().post(std::move(task));
+      return;
+    }
+
+    if (m_submissionQueue->push(std::move(task))) {
+      postDrainSubmissions();
+    }
+  }
+
+  /** @brief execute @p task on the I/O thread
+   *
+   *  In single-threaded mode, the caller is on the I/O thread, so that @p task is executed
+   *  immediately. In multi-threaded mode, this is equivalent to post().
+   */
+  void
+  dispatch(SubmissionQueue::Task task)
+  {
+    if (m_submissionQueue == nullptr) {
+      task();
+      return;
+    }
+
+    post(std::move(task));
+  }
+
+  bool
+  isMultiThreaded() const
+  {
+    return m_submissionQueue != nullptr;
+  }
+
+  /** @brief wrap @p callback so that it is invoked through the callback executor, if any
+   *
+   *  The arguments refer to packets owned by the I/O thread, so that they are copied into
+   *  the task given to the executor.
+   */
+  template<typename ...Args>
+  function<void(Args...)>
+  wrapCallback(const function<void(Args...)>& callback) const
+  {
+    if (m_callbackExecutor == nullptr || callback == nullptr) {
+      return callback;
+    }
+
+    return [executor = m_callbackExecutor, callback] (Args... args) {
+      executor(std::bind(callback, std::decay_t<Args>(args)...));
+    };
+  }
+
+private:
+  void
+  postDrainSubmissions()
+  {
+    weak_ptr<Impl> implWeak(shared_from_this());
+    m_face.getIoService().post([implWeak] {
+      auto impl = implWeak.lock();
+      if (impl != nullptr) {
+        impl->drainSubmissions();
+      }
+    });
+  }
+
+  void
+  drainSubmissions()
+  {
+    m_submissionQueue->popAll(m_submissionBatch);
+    for (auto it = m_submissionBatch.begin(); it != m_submissionBatch.end(); ++it) {
+      try {
+        (*it)();
+      }
+      catch (...) {
+        // the exception propagates out of processEvents(), the rest of the batch is kept
+        if (m_submissionQueue->pushFront(std::next(it), m_submissionBatch.end())) {
+          postDrainSubmissions();
+        }
+        m_submissionBatch.clear();
+        throw;
+      }
+    }
+    m_submissionBatch.clear();
+  }
+
 public: // consumer
   void
   asyncExpressInterest(RecordId id, shared_ptr<const Interest> interest,
-                       const DataCallback& afterSatisfied,
-                       const NackCallback& afterNacked,
-                       const TimeoutCallback& afterTimeout)
+                       shared_ptr<InterestContinuation> continuation)
   {
     NDN_LOG_DEBUG("<I " << *interest);
     this->ensureConnected(true);
 
-    const Interest& interest2 = *interest;
-    auto& entry = m_pendingInterestTable.put(id, std::move(interest), afterSatisfied, afterNacked,
-                                             afterTimeout, ref(m_scheduler));
+    auto& entry = m_pendingInterestTable.put(id, std::move(interest), std::move(continuation),
+                                             ref(m_scheduler));
+    if (m_isAggregatingInterests && aggregateInterest(entry)) {
+      return;
+    }
 
-    lp::Packet lpPacket;
-    addFieldFromTag<lp::NextHopFaceIdField, lp::NextHopFaceIdTag>(lpPacket, interest2);
-    addFieldFromTag<lp::CongestionMarkField, lp::CongestionMarkTag>(lpPacket, interest2);
+    forwardPendingInterest(entry);
+  }
 
-    entry.recordForwarding();
-    m_face.m_transport->send(finishEncoding(std::move(lpPacket), interest2.wireEncode(),
-                                            'I', interest2.getName()));
-    dispatchInterest(entry, interest2);
+  /** @param firstId ID of the first Interest; the others have consecutive IDs
+   */
+  void
+  asyncExpressInterests(RecordId firstId, const shared_ptr<const std::vector<Interest>>& interests,
+                        const shared_ptr<InterestContinuation>& continuation)
+  {
+    sendBatch([&] {
+      for (size_t i = 0; i < interests->size(); ++i) {
+        // the records share ownership of the vector, instead of allocating each Interest
+        shared_ptr<const Interest> interest(interests, &(*interests)[i]);
+        asyncExpressInterest(firstId + i, std::move(interest), continuation);
+      }
+    });
   }
 
   void
   asyncRemovePendingInterest(RecordId id)
   {
+    PendingInterest* entry = m_pendingInterestTable.get(id);
+    if (entry == nullptr) {
+      return;
+    }
+
+    if (entry->hasFollowers()) {
+      promoteFollower(*entry);
+    }
     m_pendingInterestTable.erase(id);
   }
 
+  /** @brief drop all pending Interests, notifying their continuations with onCancel()
+   *
+   *  The table is emptied before any continuation runs, so that a continuation may express new
+   *  Interests.
+   */
   void
   asyncRemoveAllPendingInterests()
   {
+    std::vector<std::pair<shared_ptr<const Interest>, shared_ptr<InterestContinuation>>> canceled;
+    m_pendingInterestTable.forEach([&canceled] (const PendingInterest& entry) {
+      if (entry.getOrigin() == PendingInterestOrigin::APP) {
+        canceled.emplace_back(entry.getInterest(), entry.getContinuation());
+      }
+    });
+
     m_pendingInterestTable.clear();
+    m_aggregationIndex.clear();
+
+    for (const auto& item : canceled) {
+      item.second->onCancel(*item.first);
+    }
   }
 
   /** @return whether the Data should be sent to the forwarder, if it does not come from the forwarder
@@ -147,10 +277,15 @@ public: // consumer
   nackPendingInterests(const lp::Nack& nack)
   {
     optional<lp::Nack> outNack;
+    std::map<RecordId, lp::Nack> nackedLeaders;
     m_pendingInterestTable.removeIf([&] (PendingInterest& entry) {
       if (!nack.getInterest().matchesInterest(*entry.getInterest())) {
         return false;
       }
+      if (entry.getLeaderId() != 0) {
+        // an aggregated Interest is Nacked together with its leader, below
+        return false;
+      }
       NDN_LOG_DEBUG("   nacking " << *entry.getInterest() << " from " << entry.getOrigin());
 
       optional<lp::Nack> outNack1 = entry.recordNack(nack);
@@ -160,18 +295,139 @@ public: // consumer
 
       if (entry.getOrigin() == PendingInterestOrigin::APP) {
         entry.invokeNackCallback(*outNack1);
+        if (entry.hasFollowers()) {
+          nackedLeaders.emplace(entry.getId(), *outNack1);
+        }
       }
       else {
         outNack = outNack1;
       }
       return true;
     });
+
+    if (!nackedLeaders.empty()) {
+      m_pendingInterestTable.removeIf([&] (PendingInterest& entry) {
+        auto it = nackedLeaders.find(entry.getLeaderId());
+        if (it == nackedLeaders.end()) {
+          return false;
+        }
+        NDN_LOG_DEBUG("   nacking " << *entry.getInterest() << " aggregated with " << it->first);
+        entry.invokeNackCallback(it->second);
+        return true;
+      });
+    }
     // send "least severe" Nack from any PendingInterest record originated from forwarder, because
     // it is unimportant to consider Nack reason for the unlikely case when forwarder sends multiple
     // Interests to an app in a short while
     return outNack;
   }
 
+private: // consumer
+  /** @brief send a PendingInterest from the application to the forwarder and local InterestFilters
+   */
+  void
+  forwardPendingInterest(PendingInterest& entry)
+  {
+    const Interest& interest = *entry.getInterest();
+
+    lp::Packet lpPacket;
+    addFieldFromTag<lp::NextHopFaceIdField, lp::NextHopFaceIdTag>(lpPacket, interest);
+    addFieldFromTag<lp::CongestionMarkField, lp::CongestionMarkTag>(lpPacket, interest);
+
+    entry.recordForwarding();
+    sendPacket(lpPacket, interest.wireEncode(), 'I', interest.getName());
+    dispatchInterest(entry, interest);
+  }
+
+  /** @brief attach @p entry to an outstanding identical Interest, if there is one
+   *  @return whether @p entry has been attached, in which case it must not be forwarded
+   *
+   *  An Interest is attached only if it expires no later than the outstanding Interest, so that
+   *  an aggregated Interest never outlives its leader, unless the leader is canceled.
+   */
+  bool
+  aggregateInterest(PendingInterest& entry)
+  {
+    const Interest& interest = *entry.getInterest();
+    auto it = m_aggregationIndex.find(interest.getName());
+    if (it != m_aggregationIndex.end()) {
+      PendingInterest* leader = m_pendingInterestTable.get(it->second);
+      if (leader != nullptr && leader->getLeaderId() == 0 &&
+          canAggregate(*leader->getInterest(), interest) &&
+          entry.getExpiry() <= leader->getExpiry()) {
+        NDN_LOG_DEBUG("   aggregated with " << *leader->getInterest());
+        entry.setLeader(leader);
+        return true;
+      }
+      it->second = entry.getId();
+    }
+    else {
+      m_aggregationIndex.emplace(interest.getName(), entry.getId());
+    }
+
+    // index entries are not removed together with their records, so purge them once in a while
+    if (m_aggregationIndex.size() > 2 * m_pendingInterestTable.size() + 16) {
+      for (auto i = m_aggregationIndex.begin(); i != m_aggregationIndex.end(); ) {
+        if (m_pendingInterestTable.get(i->second) == nullptr) {
+          i = m_aggregationIndex.erase(i);
+        }
+        else {
+          ++i;
+        }
+      }
+    }
+    return false;
+  }
+
+  static bool
+  canAggregate(const Interest& leader, const Interest& follower)
+  {
+    if (!leader.matchesInterest(follower) ||
+        leader.getForwardingHint() != follower.getForwardingHint()) {
+      return false;
+    }
+
+    auto leaderNextHop = leader.getTag<lp::NextHopFaceIdTag>();
+    auto followerNextHop = follower.getTag<lp::NextHopFaceIdTag>();
+    if (leaderNextHop == nullptr || followerNextHop == nullptr) {
+      return leaderNextHop == followerNextHop;
+    }
+    return leaderNextHop->get() == followerNextHop->get();
+  }
+
+  /** @brief forward the Interest aggregated with @p leader that expires last, in place of @p leader
+   *
+   *  The other Interests aggregated with @p leader are attached to the forwarded one.
+   */
+  void
+  promoteFollower(const PendingInterest& leader)
+  {
+    std::vector<PendingInterest*> followers;
+    m_pendingInterestTable.forEach([&] (PendingInterest& entry) {
+      if (entry.getLeaderId() == leader.getId()) {
+        followers.push_back(&entry);
+      }
+    });
+    if (followers.empty()) {
+      return;
+    }
+
+    auto newLeader = *std::max_element(followers.begin(), followers.end(),
+      [] (const PendingInterest* a, const PendingInterest* b) {
+        return a->getExpiry() < b->getExpiry();
+      });
+    newLeader->setLeader(nullptr);
+    for (auto follower : followers) {
+      if (follower != newLeader) {
+        follower->setLeader(newLeader);
+      }
+    }
+
+    m_aggregationIndex[newLeader->getInterest()->getName()] = newLeader->getId();
+    NDN_LOG_DEBUG("   forwarding aggregated " << *newLeader->getInterest());
+    forwardPendingInterest(*newLeader);
+  }
+
 public: // producer
   void
   asyncSetInterestFilter(RecordId id, const InterestFilter& filter,
@@ -194,6 +450,15 @@ public: // producer
   void
   processIncomingInterest(shared_ptr<const Interest> interest)
   {
+    if (m_contentStore != nullptr) {
+      shared_ptr<const Data> data = m_contentStore->find(*interest);
+      if (data != nullptr) {
+        NDN_LOG_DEBUG("   answered from content store with " << data->getName());
+        sendData(*data);
+        return;
+      }
+    }
+
     const Interest& interest2 = *interest;
     auto& entry = m_pendingInterestTable.insert(std::move(interest), ref(m_scheduler));
     dispatchInterest(entry, interest2);
@@ -216,19 +481,32 @@ public: // producer
   asyncPutData(const Data& data)
   {
     NDN_LOG_DEBUG("<D " << data.getName());
+    if (m_contentStore != nullptr) {
+      auto cachePolicy = data.getTag<lp::CachePolicyTag>();
+      if (cachePolicy == nullptr || cachePolicy->get().getPolicy() != lp::CachePolicyType::NO_CACHE) {
+        // InMemoryStorage keeps a shared_ptr to the Data
+        m_contentStore->insert(*make_shared<Data>(data), data.getFreshnessPeriod());
+      }
+    }
+
     bool shouldSendToForwarder = satisfyPendingInterests(data);
     if (!shouldSendToForwarder) {
       return;
     }
 
+    sendData(data);
+  }
+
+  void
+  sendData(const Data& data)
+  {
     this->ensureConnected(true);
 
     lp::Packet lpPacket;
     addFieldFromTag<lp::CachePolicyField, lp::CachePolicyTag>(lpPacket, data);
     addFieldFromTag<lp::CongestionMarkField, lp::CongestionMarkTag>(lpPacket, data);
 
-    m_face.m_transport->send(finishEncoding(std::move(lpPacket), data.wireEncode(),
-                                            'D', data.getName()));
+    sendPacket(lpPacket, data.wireEncode(), 'D', data.getName());
   }
 
   void
@@ -247,20 +525,28 @@ public: // producer
     addFieldFromTag<lp::CongestionMarkField, lp::CongestionMarkTag>(lpPacket, *outNack);
 
     const Interest& interest = outNack->getInterest();
-    m_face.m_transport->send(finishEncoding(std::move(lpPacket), interest.wireEncode(),
-                                            'N', interest.getName()));
+    sendPacket(lpPacket, interest.wireEncode(), 'N', interest.getName());
+  }
+
+  void
+  asyncPutDataBatch(const std::vector<Data>& data)
+  {
+    sendBatch([&] {
+      for (const Data& d : data) {
+        asyncPutData(d);
+      }
+    });
   }
 
 public: // prefix registration
-  RecordId
-  registerPrefix(const Name& prefix,
+  void
+  registerPrefix(RecordId id, const Name& prefix,
                  const RegisterPrefixSuccessCallback& onSuccess,
                  const RegisterPrefixFailureCallback& onFailure,
                  uint64_t flags, const nfd::CommandOptions& options,
                  const optional<InterestFilter>& filter, const InterestCallback& onInterest)
   {
     NDN_LOG_INFO("registering prefix: " << prefix);
-    auto id = m_registeredPrefixTable.allocateId();
 
     m_face.m_nfdController->start<nfd::RibRegisterCommand>(
       nfd::ControlParameters().setName(prefix).setFlags(flags),
@@ -285,8 +571,6 @@ public: // prefix registration
         onFailure(prefix, resp.getText());
       },
       options);
-
-    return id;
   }
 
   void
@@ -348,28 +632,115 @@ public: // IO routine
     }
   }
 
+  /** @brief extract local fields from NDNLPv2 packet and tag onto a network layer packet
+   *
+   *  Consecutive packets from the forwarder usually carry the same IncomingFaceId and
+   *  CongestionMark, so the last tag of each type is shared instead of allocating a new one.
+   */
+  template<typename NetPkt>
+  void
+  extractLpLocalFields(NetPkt& netPacket, const lp::Packet& lpPacket)
+  {
+    addTagFromField<lp::IncomingFaceIdTag, lp::IncomingFaceIdField>(netPacket, lpPacket,
+                                                                     m_lastIncomingFaceIdTag);
+    addTagFromField<lp::CongestionMarkTag, lp::CongestionMarkField>(netPacket, lpPacket,
+                                                                    m_lastCongestionMarkTag);
+  }
+
+  /** @brief decode @p wire into a recycled packet object
+   *
+   *  The object in @p slot is reused when nothing else refers to it any more, i.e., when no
+   *  callback retained it through shared_from_this() or a pending Interest entry. Otherwise,
+   *  a new object is allocated and takes its place in @p slot.
+   */
+  template<typename Packet>
+  static shared_ptr<Packet>
+  decodeRecycled(shared_ptr<Packet>& slot, const Block& wire)
+  {
+    if (slot != nullptr && slot.use_count() == 1) {
+      *slot = Packet(wire); // also clears the tags of the previous packet
+      return slot;
+    }
+    slot = make_shared<Packet>(wire);
+    return slot;
+  }
+
 private:
-  /** @brief Finish packet encoding
+  /** @brief Execute @p f, and hand the packets it sends to the transport as one batch
+   *
+   *  Packets sent before an exception is thrown from @p f are still transmitted.
+   */
+  template<typename F>
+  void
+  sendBatch(const F& f)
+  {
+    BOOST_ASSERT(!m_isBatchingSends);
+    m_isBatchingSends = true;
+    try {
+      f();
+    }
+    catch (...) {
+      flushBatch();
+      throw;
+    }
+    flushBatch();
+  }
+
+  void
+  flushBatch()
+  {
+    m_isBatchingSends = false;
+    if (m_outgoingBatch.empty()) {
+      return;
+    }
+
+    std::vector<Transport::Packet> packets;
+    packets.swap(m_outgoingBatch);
+    m_face.m_transport->sendBatch(packets);
+    packets.clear();
+    packets.swap(m_outgoingBatch); // keep the storage for the next batch
+  }
+
+  /** @brief Send a network packet, wrapped in NDNLP if there are any header fields
    *  @param lpPacket NDNLP packet without FragmentField
    *  @param wire wire encoding of Interest or Data
    *  @param pktType packet type, 'I' for Interest, 'D' for Data, 'N' for Nack
    *  @param name packet name
-   *  @return wire encoding of either NDNLP or bare network packet
    *  @throw Face::OversizedPacketError wire encoding exceeds limit
+   *
+   *  If NDNLP framing is needed, the NDNLP header is encoded into a separate block and written
+   *  together with @p wire as a gather write, so that the network packet is never copied.
    */
-  Block
-  finishEncoding(lp::Packet&& lpPacket, Block wire, char pktType, const Name& name)
+  void
+  sendPacket(const lp::Packet& lpPacket, const Block& wire, char pktType, const Name& name)
   {
-    if (!lpPacket.empty()) {
-      lpPacket.add<lp::FragmentField>(std::make_pair(wire.begin(), wire.end()));
-      wire = lpPacket.wireEncode();
+    if (lpPacket.empty()) {
+      checkPacketSize(wire.size(), pktType, name);
+      if (m_isBatchingSends) {
+        m_outgoingBatch.push_back({Block(), wire});
+      }
+      else {
+        m_face.m_transport->send(wire);
+      }
+      return;
     }
 
-    if (wire.size() > MAX_NDN_PACKET_SIZE) {
-      NDN_THROW(Face::OversizedPacketError(pktType, name, wire.size()));
+    Block header = lpPacket.wireEncodeHeader(wire.size());
+    checkPacketSize(header.size() + wire.size(), pktType, name);
+    if (m_isBatchingSends) {
+      m_outgoingBatch.push_back({std::move(header), wire});
+    }
+    else {
+      m_face.m_transport->send(header, wire);
     }
+  }
 
-    return wire;
+  static void
+  checkPacketSize(size_t size, char pktType, const Name& name)
+  {
+    if (size > MAX_NDN_PACKET_SIZE) {
+      NDN_THROW(Face::OversizedPacketError(pktType, name, size));
+    }
   }
 
 private:
@@ -383,6 +754,25 @@ private:
 
   unique_ptr<boost::asio::io_service::work> m_ioServiceWork; // if thread needs to be preserved
 
+  unique_ptr<SubmissionQueue> m_submissionQueue; // non-null in multi-threaded mode
+  SubmissionQueue::Batch m_submissionBatch;
+  CallbackExecutor m_callbackExecutor;
+
+  shared_ptr<InMemoryStorage> m_contentStore;
+
+  bool m_isAggregatingInterests = false;
+  /// outstanding Interest that later identical Interests are aggregated with, by Name
+  std::unordered_map<Name, RecordId> m_aggregationIndex;
+
+  bool m_isBatchingSends = false;
+  std::vector<Transport::Packet> m_outgoingBatch;
+
+  // receive path
+  shared_ptr<Interest> m_recycledInterest;
+  shared_ptr<Data> m_recycledData;
+  shared_ptr<lp::IncomingFaceIdTag> m_lastIncomingFaceIdTag;
+  shared_ptr<lp::CongestionMarkTag> m_lastCongestionMarkTag;
+
   friend class Face;
 };
 
@@ -46,6 +46,24 @@ addTagFromField(Packet& packet, const lp::Packet& lpPacket)
   }
 }
 
+/** \brief same as addTagFromField, but reuses \p lastTag if it holds the same value
+ *
+ *  \p lastTag is updated to the tag attached to \p packet. This is safe because tags
+ *  are immutable once attached.
+ */
+template<typename Tag, typename Field, typename Packet>
+void
+addTagFromField(Packet& packet, const lp::Packet& lpPacket, shared_ptr<Tag>& lastTag)
+{
+  if (lpPacket.has<Field>()) {
+    auto value = lpPacket.get<Field>();
+    if (lastTag == nullptr || lastTag->get() != value) {
+      lastTag = make_shared<Tag>(value);
+    }
+    packet.setTag(lastTag);
+  }
+}
+
 } // namespace ndn
 
 #endif // NDN_IMPL_LP_FIELD_TAG_HPP
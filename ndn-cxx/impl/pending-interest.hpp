@@ -61,7 +61,65 @@ operator<<(std::ostream& os, PendingInterestOrigin origin)
 }
 
 /**
- * @brief Stores a pending Interest and associated callbacks
+ * @brief InterestContinuation that invokes the callbacks given to Face::expressInterest
+ *
+ * The three callbacks are kept in a single object, which is shared by every PIT record of
+ * a Face::expressInterests batch.
+ */
+class InterestCallbacks : public InterestContinuation
+{
+public:
+  InterestCallbacks(DataCallback dataCallback, NackCallback nackCallback,
+                    TimeoutCallback timeoutCallback,
+                    function<void(const Interest&)> cancelCallback = nullptr)
+    : m_dataCallback(std::move(dataCallback))
+    , m_nackCallback(std::move(nackCallback))
+    , m_timeoutCallback(std::move(timeoutCallback))
+    , m_cancelCallback(std::move(cancelCallback))
+  {
+  }
+
+  void
+  onData(const Interest& interest, const Data& data) final
+  {
+    if (m_dataCallback != nullptr) {
+      m_dataCallback(interest, data);
+    }
+  }
+
+  void
+  onNack(const Interest& interest, const lp::Nack& nack) final
+  {
+    if (m_nackCallback != nullptr) {
+      m_nackCallback(interest, nack);
+    }
+  }
+
+  void
+  onTimeout(const Interest& interest) final
+  {
+    if (m_timeoutCallback != nullptr) {
+      m_timeoutCallback(interest);
+    }
+  }
+
+  void
+  onCancel(const Interest& interest) final
+  {
+    if (m_cancelCallback != nullptr) {
+      m_cancelCallback(interest);
+    }
+  }
+
+private:
+  DataCallback m_dataCallback;
+  NackCallback m_nackCallback;
+  TimeoutCallback m_timeoutCallback;
+  function<void(const Interest&)> m_cancelCallback;
+};
+
+/**
+ * @brief Stores a pending Interest and its continuation
  */
 class PendingInterest : public RecordBase<PendingInterest>
 {
@@ -70,18 +128,18 @@ public:
    * @brief Construct a pending Interest record for an Interest from Face::expressInterest
    *
    * The timeout is set based on the current time and InterestLifetime.
-   * This class will invoke the timeout callback unless the record is deleted before timeout.
+   * This class will notify the continuation of the timeout unless the record is deleted before
+   * timeout.
    */
-  PendingInterest(shared_ptr<const Interest> interest, const DataCallback& dataCallback,
-                  const NackCallback& nackCallback, const TimeoutCallback& timeoutCallback,
+  PendingInterest(shared_ptr<const Interest> interest,
+                  shared_ptr<InterestContinuation> continuation,
                   Scheduler& scheduler)
     : m_interest(std::move(interest))
     , m_origin(PendingInterestOrigin::APP)
-    , m_dataCallback(dataCallback)
-    , m_nackCallback(nackCallback)
-    , m_timeoutCallback(timeoutCallback)
+    , m_continuation(std::move(continuation))
     , m_nNotNacked(0)
   {
+    BOOST_ASSERT(m_continuation != nullptr);
     scheduleTimeoutEvent(scheduler);
   }
 
@@ -108,6 +166,64 @@ public:
     return m_origin;
   }
 
+  /**
+   * @brief Get the continuation of an Interest from Face::expressInterest
+   * @retval nullptr the Interest comes from a local InterestFilter
+   */
+  shared_ptr<InterestContinuation>
+  getContinuation() const
+  {
+    return m_continuation;
+  }
+
+  /**
+   * @brief Get the time at which the Interest times out
+   */
+  time::steady_clock::TimePoint
+  getExpiry() const
+  {
+    return m_expiry;
+  }
+
+  /**
+   * @brief Get the ID of the record that this Interest is aggregated with
+   * @retval 0 the Interest has been forwarded on its own
+   *
+   * An aggregated Interest is not forwarded. It is satisfied by the same Data as its leader,
+   * and Nacked when its leader is Nacked.
+   */
+  RecordId
+  getLeaderId() const
+  {
+    return m_leaderId;
+  }
+
+  /**
+   * @brief Aggregate the Interest with @p leader, or with nothing if @p leader is null
+   */
+  void
+  setLeader(PendingInterest* leader)
+  {
+    if (leader == nullptr) {
+      m_leaderId = 0;
+      return;
+    }
+
+    BOOST_ASSERT(leader->getLeaderId() == 0);
+    m_leaderId = leader->getId();
+    leader->m_hasFollowers = true;
+  }
+
+  /**
+   * @brief Whether other Interests have been aggregated with this one
+   * @note Aggregated Interests that have since timed out are not accounted for
+   */
+  bool
+  hasFollowers() const
+  {
+    return m_hasFollowers;
+  }
+
   /**
    * @brief Record that the Interest has been forwarded to one destination
    *
@@ -138,45 +254,42 @@ public:
   }
 
   /**
-   * @brief Invoke the Data callback
-   * @note This method does nothing if the Data callback is empty
+   * @brief Notify the continuation of the Data
+   * @pre the Interest comes from Face::expressInterest
    */
   void
   invokeDataCallback(const Data& data)
   {
-    if (m_dataCallback != nullptr) {
-      m_dataCallback(*m_interest, data);
-    }
+    m_continuation->onData(*m_interest, data);
   }
 
   /**
-   * @brief Invoke the Nack callback
-   * @note This method does nothing if the Nack callback is empty
+   * @brief Notify the continuation of the Nack
+   * @pre the Interest comes from Face::expressInterest
    */
   void
   invokeNackCallback(const lp::Nack& nack)
   {
-    if (m_nackCallback != nullptr) {
-      m_nackCallback(*m_interest, nack);
-    }
+    m_continuation->onNack(*m_interest, nack);
   }
 
 private:
   void
   scheduleTimeoutEvent(Scheduler& scheduler)
   {
+    m_expiry = time::steady_clock::now() + m_interest->getInterestLifetime();
     m_timeoutEvent = scheduler.schedule(m_interest->getInterestLifetime(),
                                         [=] { this->invokeTimeoutCallback(); });
   }
 
   /**
-   * @brief Invoke the timeout callback (if non-empty) and the deleter
+   * @brief Notify the continuation (if any) of the timeout, and invoke the deleter
    */
   void
   invokeTimeoutCallback()
   {
-    if (m_timeoutCallback) {
-      m_timeoutCallback(*m_interest);
+    if (m_continuation != nullptr) {
+      m_continuation->onTimeout(*m_interest);
     }
 
     deleteSelf();
@@ -185,12 +298,13 @@ private:
 private:
   shared_ptr<const Interest> m_interest;
   PendingInterestOrigin m_origin;
-  DataCallback m_dataCallback;
-  NackCallback m_nackCallback;
-  TimeoutCallback m_timeoutCallback;
+  shared_ptr<InterestContinuation> m_continuation;
   scheduler::ScopedEventId m_timeoutEvent;
   int m_nNotNacked; ///< number of Interest destinations that have not Nacked
   optional<lp::Nack> m_leastSevereNack;
+  time::steady_clock::TimePoint m_expiry;
+  RecordId m_leaderId = 0;
+  bool m_hasFollowers = false;
   std::function<void()> m_deleter;
 };
 
@@ -111,6 +111,15 @@ public:
     return ++m_lastId;
   }
 
+  /** \brief Allocate \p n consecutive IDs.
+   *  \return the first ID
+   */
+  RecordId
+  allocateIds(size_t n)
+  {
+    return m_lastId.fetch_add(n) + 1;
+  }
+
   /** \brief Insert a record with newly assigned ID.
    */
   template<typename ...TArgs>
@@ -0,0 +1,84 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_IMPL_SUBMISSION_QUEUE_HPP
+#define NDN_IMPL_SUBMISSION_QUEUE_HPP
+
+#include "ndn-cxx/detail/common.hpp"
+
+#include <mutex>
+
+namespace ndn {
+
+/** \brief Multi-producer single-consumer queue of operations submitted to an I/O thread.
+ *
+ *  Producers append under a short critical section. The consumer takes every queued operation
+ *  at once by swapping vectors, so that it acquires the mutex once per batch rather than once
+ *  per operation, and so that the vectors' storage is reused between batches.
+ */
+class SubmissionQueue : noncopyable
+{
+public:
+  using Task = function<void()>;
+  using Batch = std::vector<Task>;
+
+  /** \brief append an operation
+   *  \return whether the queue was empty, i.e. the consumer must be notified
+   */
+  bool
+  push(Task task)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tasks.push_back(std::move(task));
+    return m_tasks.size() == 1;
+  }
+
+  /** \brief take every queued operation
+   *  \param[in,out] batch an empty vector, whose storage is given to the queue
+   */
+  void
+  popAll(Batch& batch)
+  {
+    BOOST_ASSERT(batch.empty());
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tasks.swap(batch);
+  }
+
+  /** \brief put back operations that have not been executed, ahead of those queued since
+   *  \return whether the queue was empty, i.e. the consumer must be notified
+   */
+  bool
+  pushFront(Batch::iterator first, Batch::iterator last)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    bool wasEmpty = m_tasks.empty();
+    m_tasks.insert(m_tasks.begin(), std::make_move_iterator(first), std::make_move_iterator(last));
+    return wasEmpty && !m_tasks.empty();
+  }
+
+private:
+  std::mutex m_mutex;
+  Batch m_tasks;
+};
+
+} // namespace ndn
+
+#endif // NDN_IMPL_SUBMISSION_QUEUE_HPP
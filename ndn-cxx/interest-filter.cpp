@@ -20,6 +20,7 @@
  */
 
 #include "ndn-cxx/interest-filter.hpp"
+#include "ndn-cxx/util/regex/regex-compiled-matcher.hpp"
 #include "ndn-cxx/util/regex/regex-pattern-list-matcher.hpp"
 
 namespace ndn {
@@ -42,9 +43,31 @@ InterestFilter::InterestFilter(const std::string& prefixUri)
 InterestFilter::InterestFilter(const Name& prefix, const std::string& regexFilter)
   : m_prefix(prefix)
   , m_regexFilter(make_shared<RegexPatternListMatcher>(regexFilter, nullptr))
+  , m_compiledRegexFilter(make_shared<RegexCompiledMatcher>("^" + regexFilter + "$"))
 {
 }
 
+InterestFilter::InterestFilter(const InterestFilter& other)
+  : m_prefix(other.m_prefix)
+  , m_regexFilter(other.m_regexFilter)
+  , m_allowsLoopback(other.m_allowsLoopback)
+{
+  if (other.m_compiledRegexFilter != nullptr) {
+    m_compiledRegexFilter = make_shared<RegexCompiledMatcher>(*other.m_compiledRegexFilter);
+  }
+}
+
+InterestFilter&
+InterestFilter::operator=(const InterestFilter& other)
+{
+  if (this != &other) {
+    *this = InterestFilter(other);
+  }
+  return *this;
+}
+
+InterestFilter::~InterestFilter() = default;
+
 InterestFilter::operator const Name&() const
 {
   if (hasRegexFilter()) {
@@ -59,7 +82,7 @@ InterestFilter::doesMatch(const Name& name) const
 {
   return m_prefix.isPrefixOf(name) &&
          (!hasRegexFilter() ||
-          m_regexFilter->match(name, m_prefix.size(), name.size() - m_prefix.size()));
+          m_compiledRegexFilter->match(name.begin() + m_prefix.size(), name.end()));
 }
 
 std::ostream&
@@ -26,6 +26,7 @@
 
 namespace ndn {
 
+class RegexCompiledMatcher;
 class RegexPatternListMatcher;
 
 /**
@@ -90,6 +91,24 @@ public:
    */
   InterestFilter(const Name& prefix, const std::string& regexFilter);
 
+  /**
+   * @brief Copy constructor
+   *
+   * The copy gets its own instance of the matcher of the regular expression, whose automaton
+   * cache is not thread-safe, so that the copy and the original can be used on different threads.
+   */
+  InterestFilter(const InterestFilter& other);
+
+  InterestFilter(InterestFilter&&) = default;
+
+  InterestFilter&
+  operator=(const InterestFilter& other);
+
+  InterestFilter&
+  operator=(InterestFilter&&) = default;
+
+  ~InterestFilter();
+
   /**
    * @brief Implicit conversion to Name
    * @note This allows InterestCallback to be declared with `Name` rather than `InterestFilter`,
@@ -144,6 +163,7 @@ public:
 private:
   Name m_prefix;
   shared_ptr<RegexPatternListMatcher> m_regexFilter;
+  shared_ptr<RegexCompiledMatcher> m_compiledRegexFilter; ///< m_regexFilter anchored at both ends
   bool m_allowsLoopback = true;
 };
 
@@ -129,6 +129,34 @@ Packet::wireEncode() const
   return m_wire;
 }
 
+Block
+Packet::wireEncodeHeader(size_t fragmentSize) const
+{
+  BOOST_ASSERT(!has<FragmentField>());
+
+  EncodingEstimator estimator;
+  size_t headerLength = estimator.prependVarNumber(fragmentSize);
+  headerLength += estimator.prependVarNumber(FragmentField::TlvType::value);
+  for (const Block& element : m_wire.elements()) {
+    headerLength += estimator.prependBlock(element);
+  }
+  size_t lpLength = headerLength + fragmentSize;
+  size_t totalLength = headerLength + estimator.prependVarNumber(lpLength) +
+                       estimator.prependVarNumber(tlv::LpPacket);
+
+  EncodingBuffer encoder(totalLength, 0);
+  encoder.prependVarNumber(fragmentSize);
+  encoder.prependVarNumber(FragmentField::TlvType::value);
+  for (const Block& element : m_wire.elements() | boost::adaptors::reversed) {
+    encoder.prependBlock(element);
+  }
+  encoder.prependVarNumber(lpLength);
+  encoder.prependVarNumber(tlv::LpPacket);
+
+  // TLV-LENGTH covers the fragment that is not part of this buffer
+  return encoder.block(false);
+}
+
 void
 Packet::wireDecode(const Block& wire)
 {
@@ -47,6 +47,22 @@ public:
   Block
   wireEncode() const;
 
+  /**
+   * \brief encode the part of the packet that precedes the fragment
+   * \param fragmentSize size of the fragment, i.e., TLV-VALUE of FragmentField
+   * \pre packet does not have FragmentField
+   *
+   * The returned block contains the LpPacket TLV-TYPE and TLV-LENGTH, all header fields, and the
+   * TLV-TYPE and TLV-LENGTH of FragmentField. Sending it immediately followed by the
+   * \p fragmentSize octets of the fragment yields the same wire encoding as wireEncode() on a
+   * packet containing that fragment, without copying the fragment into a new buffer.
+   *
+   * \note The returned block's TLV-VALUE is truncated; it is only meant to be written to a
+   *       transport together with the fragment, e.g., via Transport::send(header, payload).
+   */
+  Block
+  wireEncodeHeader(size_t fragmentSize) const;
+
   /**
    * \brief decode packet from wire format
    * \throws Error unknown TLV-TYPE
@@ -21,6 +21,7 @@
 
 #include "ndn-cxx/mgmt/nfd/channel-status.hpp"
 #include "ndn-cxx/encoding/block-helpers.hpp"
+#include "ndn-cxx/encoding/record-decl.hpp"
 #include "ndn-cxx/encoding/tlv-nfd.hpp"
 #include "ndn-cxx/util/concepts.hpp"
 
@@ -29,6 +30,11 @@ namespace nfd {
 
 BOOST_CONCEPT_ASSERT((StatusDatasetItem<ChannelStatus>));
 
+struct ChannelStatus::Schema : encoding::RecordDecl<tlv::nfd::ChannelStatus,
+  NDN_CXX_RECORD_FIELD(tlv::nfd::LocalUri, StringTag, &ChannelStatus::m_localUri)>
+{
+};
+
 ChannelStatus::ChannelStatus() = default;
 
 ChannelStatus::ChannelStatus(const Block& payload)
@@ -40,11 +46,7 @@ template<encoding::Tag TAG>
 size_t
 ChannelStatus::wireEncode(EncodingImpl<TAG>& encoder) const
 {
-  size_t totalLength = 0;
-  totalLength += prependStringBlock(encoder, tlv::nfd::LocalUri, m_localUri);
-  totalLength += encoder.prependVarNumber(totalLength);
-  totalLength += encoder.prependVarNumber(tlv::nfd::ChannelStatus);
-  return totalLength;
+  return Schema::encode(encoder, *this);
 }
 
 NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(ChannelStatus);
@@ -52,37 +54,17 @@ NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(ChannelStatus);
 const Block&
 ChannelStatus::wireEncode() const
 {
-  if (m_wire.hasWire())
-    return m_wire;
-
-  EncodingEstimator estimator;
-  size_t estimatedSize = wireEncode(estimator);
-
-  EncodingBuffer buffer(estimatedSize, 0);
-  wireEncode(buffer);
-
-  m_wire = buffer.block();
+  if (!m_wire.hasWire()) {
+    m_wire = Schema::encode(*this);
+  }
   return m_wire;
 }
 
 void
 ChannelStatus::wireDecode(const Block& block)
 {
-  if (block.type() != tlv::nfd::ChannelStatus) {
-    NDN_THROW(Error("ChannelStatus", block.type()));
-  }
-
+  Schema::decode<Error>(block, *this);
   m_wire = block;
-  m_wire.parse();
-  auto val = m_wire.elements_begin();
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::LocalUri) {
-    m_localUri = readString(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("Missing required LocalUri field"));
-  }
 }
 
 ChannelStatus&
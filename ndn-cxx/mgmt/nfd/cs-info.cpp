@@ -22,6 +22,7 @@
 #include "ndn-cxx/mgmt/nfd/cs-info.hpp"
 #include "ndn-cxx/encoding/block-helpers.hpp"
 #include "ndn-cxx/encoding/encoding-buffer.hpp"
+#include "ndn-cxx/encoding/record-decl.hpp"
 #include "ndn-cxx/encoding/tlv-nfd.hpp"
 #include "ndn-cxx/util/concepts.hpp"
 
@@ -30,6 +31,15 @@ namespace nfd {
 
 BOOST_CONCEPT_ASSERT((StatusDatasetItem<CsInfo>));
 
+struct CsInfo::Schema : encoding::RecordDecl<tlv::nfd::CsInfo,
+  NDN_CXX_RECORD_FIELD(tlv::nfd::Capacity, NonNegativeIntegerTag, &CsInfo::m_capacity),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::Flags, NonNegativeIntegerTag, &CsInfo::m_flags),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::NCsEntries, NonNegativeIntegerTag, &CsInfo::m_nEntries),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::NHits, NonNegativeIntegerTag, &CsInfo::m_nHits),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::NMisses, NonNegativeIntegerTag, &CsInfo::m_nMisses)>
+{
+};
+
 CsInfo::CsInfo()
   : m_capacity(0)
   , m_nEntries(0)
@@ -47,17 +57,7 @@ template<encoding::Tag TAG>
 size_t
 CsInfo::wireEncode(EncodingImpl<TAG>& encoder) const
 {
-  size_t totalLength = 0;
-
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NMisses, m_nMisses);
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NHits, m_nHits);
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NCsEntries, m_nEntries);
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::Flags, m_flags.to_ullong());
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::Capacity, m_capacity);
-
-  totalLength += encoder.prependVarNumber(totalLength);
-  totalLength += encoder.prependVarNumber(tlv::nfd::CsInfo);
-  return totalLength;
+  return Schema::encode(encoder, *this);
 }
 
 NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(CsInfo);
@@ -65,68 +65,17 @@ NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(CsInfo);
 const Block&
 CsInfo::wireEncode() const
 {
-  if (m_wire.hasWire())
-    return m_wire;
-
-  EncodingEstimator estimator;
-  size_t estimatedSize = wireEncode(estimator);
-
-  EncodingBuffer buffer(estimatedSize, 0);
-  wireEncode(buffer);
-
-  m_wire = buffer.block();
+  if (!m_wire.hasWire()) {
+    m_wire = Schema::encode(*this);
+  }
   return m_wire;
 }
 
 void
 CsInfo::wireDecode(const Block& block)
 {
-  if (block.type() != tlv::nfd::CsInfo) {
-    NDN_THROW(Error("CsInfo", block.type()));
-  }
+  Schema::decode<Error>(block, *this);
   m_wire = block;
-  m_wire.parse();
-  auto val = m_wire.elements_begin();
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::Capacity) {
-    m_capacity = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required Capacity field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::Flags) {
-    m_flags = FlagsBitSet(static_cast<unsigned long long>(readNonNegativeInteger(*val)));
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required Flags field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NCsEntries) {
-    m_nEntries = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required NCsEntries field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NHits) {
-    m_nHits = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required NHits field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NMisses) {
-    m_nMisses = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required NMisses field"));
-  }
 }
 
 CsInfo&
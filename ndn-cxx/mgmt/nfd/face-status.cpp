@@ -22,6 +22,7 @@
 #include "ndn-cxx/mgmt/nfd/face-status.hpp"
 #include "ndn-cxx/encoding/block-helpers.hpp"
 #include "ndn-cxx/encoding/encoding-buffer.hpp"
+#include "ndn-cxx/encoding/record-decl.hpp"
 #include "ndn-cxx/encoding/tlv-nfd.hpp"
 #include "ndn-cxx/util/concepts.hpp"
 #include "ndn-cxx/util/string-helper.hpp"
@@ -31,6 +32,29 @@ namespace nfd {
 
 BOOST_CONCEPT_ASSERT((StatusDatasetItem<FaceStatus>));
 
+struct FaceStatus::Schema : encoding::RecordDecl<tlv::nfd::FaceStatus,
+  NDN_CXX_RECORD_FIELD(tlv::nfd::FaceId, NonNegativeIntegerTag, &FaceStatus::m_faceId),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::Uri, StringTag, &FaceStatus::m_remoteUri),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::LocalUri, StringTag, &FaceStatus::m_localUri),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::ExpirationPeriod, NonNegativeIntegerTag, &FaceStatus::m_expirationPeriod),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::FaceScope, NonNegativeIntegerTag, &FaceStatus::m_faceScope),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::FacePersistency, NonNegativeIntegerTag, &FaceStatus::m_facePersistency),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::LinkType, NonNegativeIntegerTag, &FaceStatus::m_linkType),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::BaseCongestionMarkingInterval, NonNegativeIntegerTag, &FaceStatus::m_baseCongestionMarkingInterval),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::DefaultCongestionThreshold, NonNegativeIntegerTag, &FaceStatus::m_defaultCongestionThreshold),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::Mtu, NonNegativeIntegerTag, &FaceStatus::m_mtu),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::NInInterests, NonNegativeIntegerTag, &FaceStatus::m_nInInterests),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::NInData, NonNegativeIntegerTag, &FaceStatus::m_nInData),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::NInNacks, NonNegativeIntegerTag, &FaceStatus::m_nInNacks),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::NOutInterests, NonNegativeIntegerTag, &FaceStatus::m_nOutInterests),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::NOutData, NonNegativeIntegerTag, &FaceStatus::m_nOutData),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::NOutNacks, NonNegativeIntegerTag, &FaceStatus::m_nOutNacks),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::NInBytes, NonNegativeIntegerTag, &FaceStatus::m_nInBytes),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::NOutBytes, NonNegativeIntegerTag, &FaceStatus::m_nOutBytes),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::Flags, NonNegativeIntegerTag, &FaceStatus::m_flags)>
+{
+};
+
 FaceStatus::FaceStatus()
   : m_nInInterests(0)
   , m_nInData(0)
@@ -52,42 +76,7 @@ template<encoding::Tag TAG>
 size_t
 FaceStatus::wireEncode(EncodingImpl<TAG>& encoder) const
 {
-  size_t totalLength = 0;
-
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::Flags, m_flags);
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NOutBytes, m_nOutBytes);
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NInBytes, m_nInBytes);
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NOutNacks, m_nOutNacks);
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NOutData, m_nOutData);
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NOutInterests, m_nOutInterests);
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NInNacks, m_nInNacks);
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NInData, m_nInData);
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NInInterests, m_nInInterests);
-  if (m_mtu) {
-    totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::Mtu, *m_mtu);
-  }
-  if (m_defaultCongestionThreshold) {
-    totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::DefaultCongestionThreshold,
-                                                  *m_defaultCongestionThreshold);
-  }
-  if (m_baseCongestionMarkingInterval) {
-    totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::BaseCongestionMarkingInterval,
-                                                  m_baseCongestionMarkingInterval->count());
-  }
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::LinkType, m_linkType);
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::FacePersistency, m_facePersistency);
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::FaceScope, m_faceScope);
-  if (m_expirationPeriod) {
-    totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::ExpirationPeriod,
-                                                  m_expirationPeriod->count());
-  }
-  totalLength += prependStringBlock(encoder, tlv::nfd::LocalUri, m_localUri);
-  totalLength += prependStringBlock(encoder, tlv::nfd::Uri, m_remoteUri);
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::FaceId, m_faceId);
-
-  totalLength += encoder.prependVarNumber(totalLength);
-  totalLength += encoder.prependVarNumber(tlv::nfd::FaceStatus);
-  return totalLength;
+  return Schema::encode(encoder, *this);
 }
 
 NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(FaceStatus);
@@ -95,181 +84,17 @@ NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(FaceStatus);
 const Block&
 FaceStatus::wireEncode() const
 {
-  if (m_wire.hasWire())
-    return m_wire;
-
-  EncodingEstimator estimator;
-  size_t estimatedSize = wireEncode(estimator);
-
-  EncodingBuffer buffer(estimatedSize, 0);
-  wireEncode(buffer);
-
-  m_wire = buffer.block();
+  if (!m_wire.hasWire()) {
+    m_wire = Schema::encode(*this);
+  }
   return m_wire;
 }
 
 void
 FaceStatus::wireDecode(const Block& block)
 {
-  if (block.type() != tlv::nfd::FaceStatus) {
-    NDN_THROW(Error("FaceStatus", block.type()));
-  }
-
+  Schema::decode<Error>(block, *this);
   m_wire = block;
-  m_wire.parse();
-  auto val = m_wire.elements_begin();
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::FaceId) {
-    m_faceId = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required FaceId field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::Uri) {
-    m_remoteUri = readString(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required Uri field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::LocalUri) {
-    m_localUri = readString(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required LocalUri field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::ExpirationPeriod) {
-    m_expirationPeriod.emplace(readNonNegativeInteger(*val));
-    ++val;
-  }
-  else {
-    m_expirationPeriod = nullopt;
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::FaceScope) {
-    m_faceScope = readNonNegativeIntegerAs<FaceScope>(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required FaceScope field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::FacePersistency) {
-    m_facePersistency = readNonNegativeIntegerAs<FacePersistency>(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required FacePersistency field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::LinkType) {
-    m_linkType = readNonNegativeIntegerAs<LinkType>(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required LinkType field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::BaseCongestionMarkingInterval) {
-    m_baseCongestionMarkingInterval.emplace(readNonNegativeInteger(*val));
-    ++val;
-  }
-  else {
-    m_baseCongestionMarkingInterval = nullopt;
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::DefaultCongestionThreshold) {
-    m_defaultCongestionThreshold = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    m_defaultCongestionThreshold = nullopt;
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::Mtu) {
-    m_mtu = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    m_mtu = nullopt;
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NInInterests) {
-    m_nInInterests = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required NInInterests field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NInData) {
-    m_nInData = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required NInData field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NInNacks) {
-    m_nInNacks = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required NInNacks field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NOutInterests) {
-    m_nOutInterests = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required NOutInterests field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NOutData) {
-    m_nOutData = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required NOutData field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NOutNacks) {
-    m_nOutNacks = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required NOutNacks field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NInBytes) {
-    m_nInBytes = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required NInBytes field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NOutBytes) {
-    m_nOutBytes = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required NOutBytes field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::Flags) {
-    m_flags = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required Flags field"));
-  }
 }
 
 FaceStatus&
@@ -22,17 +22,23 @@
 #include "ndn-cxx/mgmt/nfd/fib-entry.hpp"
 #include "ndn-cxx/encoding/block-helpers.hpp"
 #include "ndn-cxx/encoding/encoding-buffer.hpp"
+#include "ndn-cxx/encoding/record-decl.hpp"
 #include "ndn-cxx/encoding/tlv-nfd.hpp"
 #include "ndn-cxx/util/concepts.hpp"
 
-#include <boost/range/adaptor/reversed.hpp>
-
 namespace ndn {
 namespace nfd {
 
 BOOST_CONCEPT_ASSERT((StatusDatasetItem<NextHopRecord>));
 BOOST_CONCEPT_ASSERT((StatusDatasetItem<FibEntry>));
 
+struct NextHopRecord::Schema : encoding::RecordDecl<tlv::nfd::NextHopRecord,
+  NDN_CXX_RECORD_FIELD(tlv::nfd::FaceId, NonNegativeIntegerTag, &NextHopRecord::m_faceId),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::Cost, NonNegativeIntegerTag, &NextHopRecord::m_cost),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::EndpointId, NonNegativeIntegerTag, &NextHopRecord::m_endpointId)>
+{
+};
+
 NextHopRecord::NextHopRecord()
   : m_faceId(INVALID_FACE_ID)
   , m_cost(0)
@@ -80,17 +86,7 @@ template<encoding::Tag TAG>
 size_t
 NextHopRecord::wireEncode(EncodingImpl<TAG>& block) const
 {
-  size_t totalLength = 0;
-
-  if (m_endpointId) {
-    totalLength += prependNonNegativeIntegerBlock(block, ndn::tlv::nfd::EndpointId, *m_endpointId);
-  }
-  totalLength += prependNonNegativeIntegerBlock(block, ndn::tlv::nfd::Cost, m_cost);
-  totalLength += prependNonNegativeIntegerBlock(block, ndn::tlv::nfd::FaceId, m_faceId);
-
-  totalLength += block.prependVarNumber(totalLength);
-  totalLength += block.prependVarNumber(ndn::tlv::nfd::NextHopRecord);
-  return totalLength;
+  return Schema::encode(block, *this);
 }
 
 NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(NextHopRecord);
@@ -98,55 +94,17 @@ NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(NextHopRecord);
 const Block&
 NextHopRecord::wireEncode() const
 {
-  if (m_wire.hasWire())
-    return m_wire;
-
-  EncodingEstimator estimator;
-  size_t estimatedSize = wireEncode(estimator);
-
-  EncodingBuffer buffer(estimatedSize, 0);
-  wireEncode(buffer);
-
-  m_wire = buffer.block();
+  if (!m_wire.hasWire()) {
+    m_wire = Schema::encode(*this);
+  }
   return m_wire;
 }
 
 void
 NextHopRecord::wireDecode(const Block& block)
 {
-  if (block.type() != tlv::nfd::NextHopRecord) {
-    NDN_THROW(Error("NextHopRecord", block.type()));
-  }
-
+  Schema::decode<Error>(block, *this);
   m_wire = block;
-  m_wire.parse();
-  auto val = m_wire.elements_begin();
-
-  if (val == m_wire.elements_end()) {
-    NDN_THROW(Error("unexpected end of NextHopRecord"));
-  }
-  else if (val->type() != tlv::nfd::FaceId) {
-    NDN_THROW(Error("FaceId", val->type()));
-  }
-  m_faceId = readNonNegativeInteger(*val);
-  ++val;
-
-  if (val == m_wire.elements_end()) {
-    NDN_THROW(Error("unexpected end of NextHopRecord"));
-  }
-  else if (val->type() != tlv::nfd::Cost) {
-    NDN_THROW(Error("Cost", val->type()));
-  }
-  m_cost = readNonNegativeInteger(*val);
-  ++val;
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::EndpointId) {
-    m_endpointId = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    m_endpointId = nullopt;
-  }
 }
 
 bool
@@ -175,6 +133,12 @@ operator<<(std::ostream& os, const NextHopRecord& nh)
 
 ////////////////////
 
+struct FibEntry::Schema : encoding::RecordDecl<tlv::nfd::FibEntry,
+  NDN_CXX_RECORD_FIELD(tlv::Name, NestedTag, &FibEntry::m_prefix),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::NextHopRecord, NestedTag, &FibEntry::m_nextHopRecords)>
+{
+};
+
 FibEntry::FibEntry() = default;
 
 FibEntry::FibEntry(const Block& block)
@@ -210,16 +174,7 @@ template<encoding::Tag TAG>
 size_t
 FibEntry::wireEncode(EncodingImpl<TAG>& block) const
 {
-  size_t totalLength = 0;
-
-  for (const auto& nh : m_nextHopRecords | boost::adaptors::reversed) {
-    totalLength += nh.wireEncode(block);
-  }
-  totalLength += m_prefix.wireEncode(block);
-
-  totalLength += block.prependVarNumber(totalLength);
-  totalLength += block.prependVarNumber(tlv::nfd::FibEntry);
-  return totalLength;
+  return Schema::encode(block, *this);
 }
 
 NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(FibEntry);
@@ -227,46 +182,17 @@ NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(FibEntry);
 const Block&
 FibEntry::wireEncode() const
 {
-  if (m_wire.hasWire())
-    return m_wire;
-
-  EncodingEstimator estimator;
-  size_t estimatedSize = wireEncode(estimator);
-
-  EncodingBuffer buffer(estimatedSize, 0);
-  wireEncode(buffer);
-
-  m_wire = buffer.block();
+  if (!m_wire.hasWire()) {
+    m_wire = Schema::encode(*this);
+  }
   return m_wire;
 }
 
 void
 FibEntry::wireDecode(const Block& block)
 {
-  if (block.type() != tlv::nfd::FibEntry) {
-    NDN_THROW(Error("FibEntry", block.type()));
-  }
-
+  Schema::decode<Error>(block, *this);
   m_wire = block;
-  m_wire.parse();
-  auto val = m_wire.elements_begin();
-
-  if (val == m_wire.elements_end()) {
-    NDN_THROW(Error("unexpected end of FibEntry"));
-  }
-  else if (val->type() != tlv::Name) {
-    NDN_THROW(Error("Name", val->type()));
-  }
-  m_prefix.wireDecode(*val);
-  ++val;
-
-  m_nextHopRecords.clear();
-  for (; val != m_wire.elements_end(); ++val) {
-    if (val->type() != tlv::nfd::NextHopRecord) {
-      NDN_THROW(Error("NextHopRecord", val->type()));
-    }
-    m_nextHopRecords.emplace_back(*val);
-  }
 }
 
 bool
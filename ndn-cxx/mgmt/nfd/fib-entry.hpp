@@ -93,6 +93,8 @@ public:
   wireDecode(const Block& block);
 
 private:
+  struct Schema;
+
   uint64_t m_faceId;
   optional<uint64_t> m_endpointId;
   uint64_t m_cost;
@@ -173,6 +175,8 @@ public:
   wireDecode(const Block& block);
 
 private:
+  struct Schema;
+
   Name m_prefix;
   std::vector<NextHopRecord> m_nextHopRecords;
 
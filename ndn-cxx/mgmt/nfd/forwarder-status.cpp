@@ -22,6 +22,7 @@
 #include "ndn-cxx/mgmt/nfd/forwarder-status.hpp"
 #include "ndn-cxx/encoding/block-helpers.hpp"
 #include "ndn-cxx/encoding/encoding-buffer.hpp"
+#include "ndn-cxx/encoding/record-decl.hpp"
 #include "ndn-cxx/encoding/tlv-nfd.hpp"
 #include "ndn-cxx/util/concepts.hpp"
 
@@ -30,6 +31,26 @@ namespace nfd {
 
 BOOST_CONCEPT_ASSERT((StatusDatasetItem<ForwarderStatus>));
 
+struct ForwarderStatus::Schema : encoding::RecordDecl<tlv::Content,
+  NDN_CXX_RECORD_FIELD(tlv::nfd::NfdVersion, StringTag, &ForwarderStatus::m_nfdVersion),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::StartTimestamp, NonNegativeIntegerTag, &ForwarderStatus::m_startTimestamp),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::CurrentTimestamp, NonNegativeIntegerTag, &ForwarderStatus::m_currentTimestamp),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::NNameTreeEntries, NonNegativeIntegerTag, &ForwarderStatus::m_nNameTreeEntries),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::NFibEntries, NonNegativeIntegerTag, &ForwarderStatus::m_nFibEntries),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::NPitEntries, NonNegativeIntegerTag, &ForwarderStatus::m_nPitEntries),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::NMeasurementsEntries, NonNegativeIntegerTag, &ForwarderStatus::m_nMeasurementsEntries),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::NCsEntries, NonNegativeIntegerTag, &ForwarderStatus::m_nCsEntries),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::NInInterests, NonNegativeIntegerTag, &ForwarderStatus::m_nInInterests),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::NInData, NonNegativeIntegerTag, &ForwarderStatus::m_nInData),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::NInNacks, NonNegativeIntegerTag, &ForwarderStatus::m_nInNacks),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::NOutInterests, NonNegativeIntegerTag, &ForwarderStatus::m_nOutInterests),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::NOutData, NonNegativeIntegerTag, &ForwarderStatus::m_nOutData),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::NOutNacks, NonNegativeIntegerTag, &ForwarderStatus::m_nOutNacks),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::NSatisfiedInterests, NonNegativeIntegerTag, &ForwarderStatus::m_nSatisfiedInterests),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::NUnsatisfiedInterests, NonNegativeIntegerTag, &ForwarderStatus::m_nUnsatisfiedInterests)>
+{
+};
+
 ForwarderStatus::ForwarderStatus()
   : m_nNameTreeEntries(0)
   , m_nFibEntries(0)
@@ -56,30 +77,7 @@ template<encoding::Tag TAG>
 size_t
 ForwarderStatus::wireEncode(EncodingImpl<TAG>& encoder) const
 {
-  size_t totalLength = 0;
-
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NUnsatisfiedInterests, m_nUnsatisfiedInterests);
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NSatisfiedInterests, m_nSatisfiedInterests);
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NOutNacks, m_nOutNacks);
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NOutData, m_nOutData);
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NOutInterests, m_nOutInterests);
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NInNacks, m_nInNacks);
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NInData, m_nInData);
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NInInterests, m_nInInterests);
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NCsEntries, m_nCsEntries);
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NMeasurementsEntries, m_nMeasurementsEntries);
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NPitEntries, m_nPitEntries);
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NFibEntries, m_nFibEntries);
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NNameTreeEntries, m_nNameTreeEntries);
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::CurrentTimestamp,
-                                                time::toUnixTimestamp(m_currentTimestamp).count());
-  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::StartTimestamp,
-                                                time::toUnixTimestamp(m_startTimestamp).count());
-  totalLength += prependStringBlock(encoder, tlv::nfd::NfdVersion, m_nfdVersion);
-
-  totalLength += encoder.prependVarNumber(totalLength);
-  totalLength += encoder.prependVarNumber(tlv::Content);
-  return totalLength;
+  return Schema::encode(encoder, *this);
 }
 
 NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(ForwarderStatus);
@@ -87,157 +85,17 @@ NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(ForwarderStatus);
 const Block&
 ForwarderStatus::wireEncode() const
 {
-  if (m_wire.hasWire())
-    return m_wire;
-
-  EncodingEstimator estimator;
-  size_t estimatedSize = wireEncode(estimator);
-
-  EncodingBuffer buffer(estimatedSize, 0);
-  wireEncode(buffer);
-
-  m_wire = buffer.block();
+  if (!m_wire.hasWire()) {
+    m_wire = Schema::encode(*this);
+  }
   return m_wire;
 }
 
 void
 ForwarderStatus::wireDecode(const Block& block)
 {
-  if (block.type() != tlv::Content) {
-    NDN_THROW(Error("Content", block.type()));
-  }
-
+  Schema::decode<Error>(block, *this);
   m_wire = block;
-  m_wire.parse();
-  auto val = m_wire.elements_begin();
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NfdVersion) {
-    m_nfdVersion = readString(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required NfdVersion field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::StartTimestamp) {
-    m_startTimestamp = time::fromUnixTimestamp(time::milliseconds(readNonNegativeInteger(*val)));
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required StartTimestamp field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::CurrentTimestamp) {
-    m_currentTimestamp = time::fromUnixTimestamp(time::milliseconds(readNonNegativeInteger(*val)));
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required CurrentTimestamp field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NNameTreeEntries) {
-    m_nNameTreeEntries = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required NNameTreeEntries field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NFibEntries) {
-    m_nFibEntries = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required NFibEntries field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NPitEntries) {
-    m_nPitEntries = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required NPitEntries field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NMeasurementsEntries) {
-    m_nMeasurementsEntries = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required NMeasurementsEntries field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NCsEntries) {
-    m_nCsEntries = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required NCsEntries field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NInInterests) {
-    m_nInInterests = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required NInInterests field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NInData) {
-    m_nInData = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required NInData field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NInNacks) {
-    m_nInNacks = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required NInNacks field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NOutInterests) {
-    m_nOutInterests = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required NOutInterests field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NOutData) {
-    m_nOutData = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required NOutData field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NOutNacks) {
-    m_nOutNacks = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required NOutNacks field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NSatisfiedInterests) {
-    m_nSatisfiedInterests = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required NSatisfiedInterests field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NUnsatisfiedInterests) {
-    m_nUnsatisfiedInterests = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required NUnsatisfiedInterests field"));
-  }
 }
 
 ForwarderStatus&
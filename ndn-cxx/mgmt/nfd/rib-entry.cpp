@@ -22,18 +22,26 @@
 #include "ndn-cxx/mgmt/nfd/rib-entry.hpp"
 #include "ndn-cxx/encoding/block-helpers.hpp"
 #include "ndn-cxx/encoding/encoding-buffer.hpp"
+#include "ndn-cxx/encoding/record-decl.hpp"
 #include "ndn-cxx/encoding/tlv-nfd.hpp"
 #include "ndn-cxx/util/concepts.hpp"
 #include "ndn-cxx/util/string-helper.hpp"
 
-#include <boost/range/adaptor/reversed.hpp>
-
 namespace ndn {
 namespace nfd {
 
 BOOST_CONCEPT_ASSERT((StatusDatasetItem<Route>));
 BOOST_CONCEPT_ASSERT((StatusDatasetItem<RibEntry>));
 
+struct Route::Schema : encoding::RecordDecl<tlv::nfd::Route,
+  NDN_CXX_RECORD_FIELD(tlv::nfd::FaceId, NonNegativeIntegerTag, &Route::m_faceId),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::Origin, NonNegativeIntegerTag, &Route::m_origin),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::Cost, NonNegativeIntegerTag, &Route::m_cost),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::Flags, NonNegativeIntegerTag, &Route::m_flags),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::ExpirationPeriod, NonNegativeIntegerTag, &Route::m_expirationPeriod)>
+{
+};
+
 Route::Route()
   : m_faceId(INVALID_FACE_ID)
   , m_origin(ROUTE_ORIGIN_APP)
@@ -102,20 +110,7 @@ template<encoding::Tag TAG>
 size_t
 Route::wireEncode(EncodingImpl<TAG>& block) const
 {
-  size_t totalLength = 0;
-
-  if (m_expirationPeriod) {
-    totalLength += prependNonNegativeIntegerBlock(block, ndn::tlv::nfd::ExpirationPeriod,
-                                                  static_cast<uint64_t>(m_expirationPeriod->count()));
-  }
-  totalLength += prependNonNegativeIntegerBlock(block, ndn::tlv::nfd::Flags, m_flags);
-  totalLength += prependNonNegativeIntegerBlock(block, ndn::tlv::nfd::Cost, m_cost);
-  totalLength += prependNonNegativeIntegerBlock(block, ndn::tlv::nfd::Origin, m_origin);
-  totalLength += prependNonNegativeIntegerBlock(block, ndn::tlv::nfd::FaceId, m_faceId);
-
-  totalLength += block.prependVarNumber(totalLength);
-  totalLength += block.prependVarNumber(ndn::tlv::nfd::Route);
-  return totalLength;
+  return Schema::encode(block, *this);
 }
 
 NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(Route);
@@ -123,69 +118,17 @@ NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(Route);
 const Block&
 Route::wireEncode() const
 {
-  if (m_wire.hasWire())
-    return m_wire;
-
-  EncodingEstimator estimator;
-  size_t estimatedSize = wireEncode(estimator);
-
-  EncodingBuffer buffer(estimatedSize, 0);
-  wireEncode(buffer);
-
-  m_wire = buffer.block();
+  if (!m_wire.hasWire()) {
+    m_wire = Schema::encode(*this);
+  }
   return m_wire;
 }
 
 void
 Route::wireDecode(const Block& block)
 {
-  if (block.type() != tlv::nfd::Route) {
-    NDN_THROW(Error("Route", block.type()));
-  }
-
+  Schema::decode<Error>(block, *this);
   m_wire = block;
-  m_wire.parse();
-  auto val = m_wire.elements_begin();
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::FaceId) {
-    m_faceId = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required FaceId field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::Origin) {
-    m_origin = readNonNegativeIntegerAs<RouteOrigin>(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required Origin field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::Cost) {
-    m_cost = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required Cost field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::Flags) {
-    m_flags = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required Flags field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::ExpirationPeriod) {
-    m_expirationPeriod.emplace(readNonNegativeInteger(*val));
-    ++val;
-  }
-  else {
-    m_expirationPeriod = nullopt;
-  }
 }
 
 bool
@@ -219,6 +162,12 @@ operator<<(std::ostream& os, const Route& route)
 
 ////////////////////
 
+struct RibEntry::Schema : encoding::RecordDecl<tlv::nfd::RibEntry,
+  NDN_CXX_RECORD_FIELD(tlv::Name, NestedTag, &RibEntry::m_prefix),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::Route, NestedTag, &RibEntry::m_routes)>
+{
+};
+
 RibEntry::RibEntry() = default;
 
 RibEntry::RibEntry(const Block& block)
@@ -254,16 +203,7 @@ template<encoding::Tag TAG>
 size_t
 RibEntry::wireEncode(EncodingImpl<TAG>& block) const
 {
-  size_t totalLength = 0;
-
-  for (const auto& route : m_routes | boost::adaptors::reversed) {
-    totalLength += route.wireEncode(block);
-  }
-  totalLength += m_prefix.wireEncode(block);
-
-  totalLength += block.prependVarNumber(totalLength);
-  totalLength += block.prependVarNumber(tlv::nfd::RibEntry);
-  return totalLength;
+  return Schema::encode(block, *this);
 }
 
 NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(RibEntry);
@@ -271,46 +211,17 @@ NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(RibEntry);
 const Block&
 RibEntry::wireEncode() const
 {
-  if (m_wire.hasWire())
-    return m_wire;
-
-  EncodingEstimator estimator;
-  size_t estimatedSize = wireEncode(estimator);
-
-  EncodingBuffer buffer(estimatedSize, 0);
-  wireEncode(buffer);
-
-  m_wire = buffer.block();
+  if (!m_wire.hasWire()) {
+    m_wire = Schema::encode(*this);
+  }
   return m_wire;
 }
 
 void
 RibEntry::wireDecode(const Block& block)
 {
-  if (block.type() != tlv::nfd::RibEntry) {
-    NDN_THROW(Error("RibEntry", block.type()));
-  }
-
+  Schema::decode<Error>(block, *this);
   m_wire = block;
-  m_wire.parse();
-  auto val = m_wire.elements_begin();
-
-  if (val == m_wire.elements_end()) {
-    NDN_THROW(Error("unexpected end of RibEntry"));
-  }
-  else if (val->type() != tlv::Name) {
-    NDN_THROW(Error("Name", val->type()));
-  }
-  m_prefix.wireDecode(*val);
-  ++val;
-
-  m_routes.clear();
-  for (; val != m_wire.elements_end(); ++val) {
-    if (val->type() != tlv::nfd::Route) {
-      NDN_THROW(Error("Route", val->type()));
-    }
-    m_routes.emplace_back(*val);
-  }
 }
 
 bool
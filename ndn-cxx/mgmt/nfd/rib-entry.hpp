@@ -118,6 +118,8 @@ public:
   wireDecode(const Block& block);
 
 private:
+  struct Schema;
+
   uint64_t m_faceId;
   RouteOrigin m_origin;
   uint64_t m_cost;
@@ -205,6 +207,8 @@ public:
   wireDecode(const Block& block);
 
 private:
+  struct Schema;
+
   Name m_prefix;
   std::vector<Route> m_routes;
 
@@ -22,6 +22,7 @@
 #include "ndn-cxx/mgmt/nfd/strategy-choice.hpp"
 #include "ndn-cxx/encoding/block-helpers.hpp"
 #include "ndn-cxx/encoding/encoding-buffer.hpp"
+#include "ndn-cxx/encoding/record-decl.hpp"
 #include "ndn-cxx/encoding/tlv-nfd.hpp"
 #include "ndn-cxx/util/concepts.hpp"
 
@@ -30,6 +31,12 @@ namespace nfd {
 
 BOOST_CONCEPT_ASSERT((StatusDatasetItem<StrategyChoice>));
 
+struct StrategyChoice::Schema : encoding::RecordDecl<tlv::nfd::StrategyChoice,
+  NDN_CXX_RECORD_FIELD(tlv::Name, NestedTag, &StrategyChoice::m_name),
+  NDN_CXX_RECORD_FIELD(tlv::nfd::Strategy, WrappedTag, &StrategyChoice::m_strategy)>
+{
+};
+
 StrategyChoice::StrategyChoice() = default;
 
 StrategyChoice::StrategyChoice(const Block& payload)
@@ -41,14 +48,7 @@ template<encoding::Tag TAG>
 size_t
 StrategyChoice::wireEncode(EncodingImpl<TAG>& encoder) const
 {
-  size_t totalLength = 0;
-
-  totalLength += prependNestedBlock(encoder, tlv::nfd::Strategy, m_strategy);
-  totalLength += m_name.wireEncode(encoder);
-
-  totalLength += encoder.prependVarNumber(totalLength);
-  totalLength += encoder.prependVarNumber(tlv::nfd::StrategyChoice);
-  return totalLength;
+  return Schema::encode(encoder, *this);
 }
 
 NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(StrategyChoice);
@@ -56,51 +56,17 @@ NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(StrategyChoice);
 const Block&
 StrategyChoice::wireEncode() const
 {
-  if (m_wire.hasWire())
-    return m_wire;
-
-  EncodingEstimator estimator;
-  size_t estimatedSize = wireEncode(estimator);
-
-  EncodingBuffer buffer(estimatedSize, 0);
-  wireEncode(buffer);
-
-  m_wire = buffer.block();
+  if (!m_wire.hasWire()) {
+    m_wire = Schema::encode(*this);
+  }
   return m_wire;
 }
 
 void
 StrategyChoice::wireDecode(const Block& block)
 {
-  if (block.type() != tlv::nfd::StrategyChoice) {
-    NDN_THROW(Error("StrategyChoice", block.type()));
-  }
-
+  Schema::decode<Error>(block, *this);
   m_wire = block;
-  m_wire.parse();
-  auto val = m_wire.elements_begin();
-
-  if (val != m_wire.elements_end() && val->type() == tlv::Name) {
-    m_name.wireDecode(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required Name field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::Strategy) {
-    val->parse();
-    if (val->elements().empty()) {
-      NDN_THROW(Error("expecting Strategy/Name"));
-    }
-    else {
-      m_strategy.wireDecode(*val->elements_begin());
-    }
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required Strategy field"));
-  }
 }
 
 StrategyChoice&
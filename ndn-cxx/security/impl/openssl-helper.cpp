@@ -69,6 +69,26 @@ getEvpPkeyType(EVP_PKEY* key)
 #endif
 }
 
+ConstBufferPtr
+computeDigest(DigestAlgorithm algo, const uint8_t* buf, size_t size)
+{
+  const EVP_MD* md = digestAlgorithmToEvpMd(algo);
+  if (md == nullptr)
+    return nullptr;
+
+  static thread_local EvpMdCtx ctx;
+
+  auto digest = make_shared<Buffer>(EVP_MD_size(md));
+  unsigned int digestLen = 0;
+  if (EVP_DigestInit_ex(ctx, md, nullptr) != 1 ||
+      EVP_DigestUpdate(ctx, buf, size) != 1 ||
+      EVP_DigestFinal_ex(ctx, digest->data(), &digestLen) != 1)
+    return nullptr;
+
+  BOOST_ASSERT(digestLen == digest->size());
+  return digest;
+}
+
 EvpMdCtx::EvpMdCtx()
 #if OPENSSL_VERSION_NUMBER < 0x1010000fL
   : m_ctx(EVP_MD_CTX_create())
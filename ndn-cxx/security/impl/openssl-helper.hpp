@@ -22,6 +22,7 @@
 #ifndef NDN_CXX_SECURITY_IMPL_OPENSSL_HELPER_HPP
 #define NDN_CXX_SECURITY_IMPL_OPENSSL_HELPER_HPP
 
+#include "ndn-cxx/encoding/buffer.hpp"
 #include "ndn-cxx/security/impl/openssl.hpp"
 #include "ndn-cxx/security/security-common.hpp"
 
@@ -35,6 +36,17 @@ digestAlgorithmToEvpMd(DigestAlgorithm algo);
 int
 getEvpPkeyType(EVP_PKEY* key);
 
+/**
+ * @brief Compute the digest of a buffer in one shot
+ *
+ * Unlike a transform chain, this does not allocate any state besides the returned buffer:
+ * the digest context is owned by the calling thread and reused by its subsequent calls.
+ *
+ * @return the digest, or nullptr if @p algo is not supported or the computation fails
+ */
+ConstBufferPtr
+computeDigest(DigestAlgorithm algo, const uint8_t* buf, size_t size);
+
 class EvpMdCtx : noncopyable
 {
 public:
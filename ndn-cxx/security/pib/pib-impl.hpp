@@ -274,6 +274,22 @@ public: // Certificate Management
    */
   virtual v2::Certificate
   getDefaultCertificateOfKey(const Name& keyName) const = 0;
+
+public: // Modification tracking
+  /**
+   * @brief Get the version of PIB contents
+   *
+   * The version changes whenever an identity, key, or certificate is added or removed, or a
+   * default is changed.  KeyChain relies on it to reuse signing parameters resolved from
+   * the PIB.
+   *
+   * @return a non-zero version, or zero if this PIB does not track modifications
+   */
+  virtual uint64_t
+  getVersion() const
+  {
+    return 0;
+  }
 };
 
 } // namespace pib
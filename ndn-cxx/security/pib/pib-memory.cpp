@@ -62,6 +62,7 @@ PibMemory::hasIdentity(const Name& identity) const
 void
 PibMemory::addIdentity(const Name& identity)
 {
+  ++m_version;
   m_identities.insert(identity);
 
   if (!m_hasDefaultIdentity) {
@@ -73,6 +74,7 @@ PibMemory::addIdentity(const Name& identity)
 void
 PibMemory::removeIdentity(const Name& identity)
 {
+  ++m_version;
   m_identities.erase(identity);
   if (identity == m_defaultIdentity) {
     m_hasDefaultIdentity = false;
@@ -88,6 +90,7 @@ PibMemory::removeIdentity(const Name& identity)
 void
 PibMemory::clearIdentities()
 {
+  ++m_version;
   m_hasDefaultIdentity = false;
   m_defaultIdentity.clear();
   m_identities.clear();
@@ -106,6 +109,7 @@ PibMemory::getIdentities() const
 void
 PibMemory::setDefaultIdentity(const Name& identityName)
 {
+  ++m_version;
   addIdentity(identityName);
   m_defaultIdentity = identityName;
   m_hasDefaultIdentity = true;
@@ -131,6 +135,7 @@ void
 PibMemory::addKey(const Name& identity, const Name& keyName,
                   const uint8_t* key, size_t keyLen)
 {
+  ++m_version;
   addIdentity(identity);
 
   m_keys[keyName] = Buffer(key, keyLen);
@@ -143,6 +148,7 @@ PibMemory::addKey(const Name& identity, const Name& keyName,
 void
 PibMemory::removeKey(const Name& keyName)
 {
+  ++m_version;
   Name identity = v2::extractIdentityFromKeyName(keyName);
 
   m_keys.erase(keyName);
@@ -185,6 +191,7 @@ PibMemory::setDefaultKeyOfIdentity(const Name& identity, const Name& keyName)
     NDN_THROW(Pib::Error("Key `" + keyName.toUri() + "` not found"));
   }
 
+  ++m_version;
   m_defaultKeys[identity] = keyName;
 }
 
@@ -208,6 +215,7 @@ PibMemory::hasCertificate(const Name& certName) const
 void
 PibMemory::addCertificate(const v2::Certificate& certificate)
 {
+  ++m_version;
   Name certName = certificate.getName();
   Name keyName = certificate.getKeyName();
   Name identity = certificate.getIdentity();
@@ -223,6 +231,7 @@ PibMemory::addCertificate(const v2::Certificate& certificate)
 void
 PibMemory::removeCertificate(const Name& certName)
 {
+  ++m_version;
   m_certs.erase(certName);
   auto defaultCert = m_defaultCerts.find(v2::extractKeyNameFromCertName(certName));
   if (defaultCert != m_defaultCerts.end() && defaultCert->second == certName) {
@@ -260,6 +269,7 @@ PibMemory::setDefaultCertificateOfKey(const Name& keyName, const Name& certName)
     NDN_THROW(Pib::Error("Certificate `" + certName.toUri() +  "` does not exist"));
   }
 
+  ++m_version;
   m_defaultCerts[keyName] = certName;
 }
 
@@ -120,8 +120,16 @@ public: // Certificate management
   v2::Certificate
   getDefaultCertificateOfKey(const Name& keyName) const override;
 
+public: // Modification tracking
+  uint64_t
+  getVersion() const override
+  {
+    return m_version;
+  }
+
 private:
   std::string m_tpmLocator;
+  uint64_t m_version = 1;
 
   bool m_hasDefaultIdentity;
   Name m_defaultIdentity;
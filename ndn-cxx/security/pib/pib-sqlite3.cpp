@@ -239,6 +239,8 @@ PibSqlite3::PibSqlite3(const std::string& location)
 
 PibSqlite3::~PibSqlite3()
 {
+  // prepared statements must be finalized before the connection can be closed
+  m_statements.clear();
   sqlite3_close(m_database);
 }
 
@@ -249,28 +251,117 @@ PibSqlite3::getScheme()
   return scheme;
 }
 
+void
+PibSqlite3::StatementReset::operator()(Sqlite3Statement* statement) const
+{
+  statement->reset();
+}
+
+PibSqlite3::CachedStatement
+PibSqlite3::prepare(const std::string& sql) const
+{
+  auto& statement = m_statements[sql];
+  if (statement == nullptr) {
+    statement = make_unique<Sqlite3Statement>(m_database, sql);
+  }
+  return CachedStatement(statement.get());
+}
+
+void
+PibSqlite3::execute(const CachedStatement& statement)
+{
+  ++m_version;
+  if (statement->step() != SQLITE_DONE) {
+    m_mirror.isLoaded = false;
+  }
+}
+
+PibSqlite3::Mirror&
+PibSqlite3::getMirror() const
+{
+  // data_version changes only when another connection has committed a modification
+  int dataVersion = -1;
+  {
+    auto statement = prepare("PRAGMA data_version");
+    if (statement->step() == SQLITE_ROW) {
+      dataVersion = statement->getInt(0);
+    }
+  }
+
+  if (!m_mirror.isLoaded || dataVersion < 0 || dataVersion != m_mirror.dataVersion) {
+    loadMirror();
+    m_mirror.dataVersion = dataVersion;
+  }
+  return m_mirror;
+}
+
+void
+PibSqlite3::loadMirror() const
+{
+  m_mirror = Mirror();
+  ++m_nMirrorLoads;
+  ++m_version;
+
+  auto identities = prepare("SELECT identity, is_default FROM identities");
+  while (identities->step() == SQLITE_ROW) {
+    Name identity(identities->getBlock(0));
+    if (identities->getInt(1) != 0) {
+      m_mirror.hasDefaultIdentity = true;
+      m_mirror.defaultIdentity = identity;
+    }
+    m_mirror.identities.insert(std::move(identity));
+  }
+
+  auto keys = prepare("SELECT identities.identity, keys.key_name, keys.key_bits, keys.is_default "
+                      "FROM keys JOIN identities ON keys.identity_id=identities.id");
+  while (keys->step() == SQLITE_ROW) {
+    Name identity(keys->getBlock(0));
+    Name keyName(keys->getBlock(1));
+    if (keys->getInt(3) != 0) {
+      m_mirror.defaultKeys[identity] = keyName;
+    }
+    m_mirror.keys[keyName] = {std::move(identity), Buffer(keys->getBlob(2), keys->getSize(2))};
+  }
+
+  auto certs = prepare("SELECT keys.key_name, certificates.certificate_name, "
+                       "certificates.certificate_data, certificates.is_default "
+                       "FROM certificates JOIN keys ON certificates.key_id=keys.id");
+  while (certs->step() == SQLITE_ROW) {
+    Name keyName(certs->getBlock(0));
+    Name certName(certs->getBlock(1));
+    if (certs->getInt(3) != 0) {
+      m_mirror.defaultCerts[keyName] = certName;
+    }
+    m_mirror.certs[certName] = {std::move(keyName), v2::Certificate(certs->getBlock(2))};
+  }
+
+  m_mirror.isLoaded = true;
+}
+
 void
 PibSqlite3::setTpmLocator(const std::string& tpmLocator)
 {
-  Sqlite3Statement statement(m_database, "UPDATE tpmInfo SET tpm_locator=?");
-  statement.bind(1, tpmLocator, SQLITE_TRANSIENT);
-  statement.step();
+  {
+    auto statement = prepare("UPDATE tpmInfo SET tpm_locator=?");
+    statement->bind(1, tpmLocator, SQLITE_TRANSIENT);
+    statement->step();
+  }
 
   if (sqlite3_changes(m_database) == 0) {
     // no row is updated, tpm_locator does not exist, insert it directly
-    Sqlite3Statement insertStatement(m_database, "INSERT INTO tpmInfo (tpm_locator) values (?)");
-    insertStatement.bind(1, tpmLocator, SQLITE_TRANSIENT);
-    insertStatement.step();
+    auto insertStatement = prepare("INSERT INTO tpmInfo (tpm_locator) values (?)");
+    insertStatement->bind(1, tpmLocator, SQLITE_TRANSIENT);
+    insertStatement->step();
   }
 }
 
 std::string
 PibSqlite3::getTpmLocator() const
 {
-  Sqlite3Statement statement(m_database, "SELECT tpm_locator FROM tpmInfo");
-  int res = statement.step();
+  auto statement = prepare("SELECT tpm_locator FROM tpmInfo");
+  int res = statement->step();
   if (res == SQLITE_ROW)
-    return statement.getString(0);
+    return statement->getString(0);
   else
     return "";
 }
@@ -278,18 +369,19 @@ PibSqlite3::getTpmLocator() const
 bool
 PibSqlite3::hasIdentity(const Name& identity) const
 {
-  Sqlite3Statement statement(m_database, "SELECT id FROM identities WHERE identity=?");
-  statement.bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
-  return statement.step() == SQLITE_ROW;
+  return getMirror().identities.count(identity) > 0;
 }
 
 void
 PibSqlite3::addIdentity(const Name& identity)
 {
+  Mirror& mirror = getMirror();
+
   if (!hasIdentity(identity)) {
-    Sqlite3Statement statement(m_database, "INSERT INTO identities (identity) values (?)");
-    statement.bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
-    statement.step();
+    auto statement = prepare("INSERT INTO identities (identity) values (?)");
+    statement->bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
+    execute(statement);
+    mirror.identities.insert(identity);
   }
 
   if (!hasDefaultIdentity()) {
@@ -300,45 +392,79 @@ PibSqlite3::addIdentity(const Name& identity)
 void
 PibSqlite3::removeIdentity(const Name& identity)
 {
-  Sqlite3Statement statement(m_database, "DELETE FROM identities WHERE identity=?");
-  statement.bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
-  statement.step();
+  Mirror& mirror = getMirror();
+
+  auto statement = prepare("DELETE FROM identities WHERE identity=?");
+  statement->bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
+  execute(statement);
+
+  // keys and certificates of the identity are removed by ON DELETE CASCADE
+  mirror.identities.erase(identity);
+  if (mirror.hasDefaultIdentity && mirror.defaultIdentity == identity) {
+    mirror.hasDefaultIdentity = false;
+    mirror.defaultIdentity.clear();
+  }
+  mirror.defaultKeys.erase(identity);
+  for (auto key = mirror.keys.begin(); key != mirror.keys.end();) {
+    if (key->second.identity == identity) {
+      const Name& keyName = key->first;
+      mirror.defaultCerts.erase(keyName);
+      for (auto cert = mirror.certs.begin(); cert != mirror.certs.end();) {
+        cert = cert->second.keyName == keyName ? mirror.certs.erase(cert) : std::next(cert);
+      }
+      key = mirror.keys.erase(key);
+    }
+    else {
+      ++key;
+    }
+  }
 }
 
 void
 PibSqlite3::clearIdentities()
 {
-  Sqlite3Statement statement(m_database, "DELETE FROM identities");
-  statement.step();
+  Mirror& mirror = getMirror();
+
+  auto statement = prepare("DELETE FROM identities");
+  execute(statement);
+
+  mirror.identities.clear();
+  mirror.hasDefaultIdentity = false;
+  mirror.defaultIdentity.clear();
+  mirror.keys.clear();
+  mirror.defaultKeys.clear();
+  mirror.certs.clear();
+  mirror.defaultCerts.clear();
 }
 
 std::set<Name>
 PibSqlite3::getIdentities() const
 {
-  std::set<Name> identities;
-  Sqlite3Statement statement(m_database, "SELECT identity FROM identities");
-
-  while (statement.step() == SQLITE_ROW)
-    identities.insert(Name(statement.getBlock(0)));
-
-  return identities;
+  return getMirror().identities;
 }
 
 void
 PibSqlite3::setDefaultIdentity(const Name& identityName)
 {
-  Sqlite3Statement statement(m_database, "UPDATE identities SET is_default=1 WHERE identity=?");
-  statement.bind(1, identityName.wireEncode(), SQLITE_TRANSIENT);
-  statement.step();
+  Mirror& mirror = getMirror();
+
+  auto statement = prepare("UPDATE identities SET is_default=1 WHERE identity=?");
+  statement->bind(1, identityName.wireEncode(), SQLITE_TRANSIENT);
+  execute(statement);
+
+  if (mirror.identities.count(identityName) > 0) {
+    mirror.hasDefaultIdentity = true;
+    mirror.defaultIdentity = identityName;
+  }
 }
 
 Name
 PibSqlite3::getDefaultIdentity() const
 {
-  Sqlite3Statement statement(m_database, "SELECT identity FROM identities WHERE is_default=1");
+  const Mirror& mirror = getMirror();
 
-  if (statement.step() == SQLITE_ROW)
-    return Name(statement.getBlock(0));
+  if (mirror.hasDefaultIdentity)
+    return mirror.defaultIdentity;
   else
     NDN_THROW(Pib::Error("No default identity"));
 }
@@ -346,17 +472,13 @@ PibSqlite3::getDefaultIdentity() const
 bool
 PibSqlite3::hasDefaultIdentity() const
 {
-  Sqlite3Statement statement(m_database, "SELECT identity FROM identities WHERE is_default=1");
-  return (statement.step() == SQLITE_ROW);
+  return getMirror().hasDefaultIdentity;
 }
 
 bool
 PibSqlite3::hasKey(const Name& keyName) const
 {
-  Sqlite3Statement statement(m_database, "SELECT id FROM keys WHERE key_name=?");
-  statement.bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
-
-  return (statement.step() == SQLITE_ROW);
+  return getMirror().keys.count(keyName) > 0;
 }
 
 void
@@ -366,21 +488,27 @@ PibSqlite3::addKey(const Name& identity, const Name& keyName,
   // ensure identity exists
   addIdentity(identity);
 
+  Mirror& mirror = getMirror();
+
   if (!hasKey(keyName)) {
-    Sqlite3Statement statement(m_database,
-                               "INSERT INTO keys (identity_id, key_name, key_bits) "
-                               "VALUES ((SELECT id FROM identities WHERE identity=?), ?, ?)");
-    statement.bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
-    statement.bind(2, keyName.wireEncode(), SQLITE_TRANSIENT);
-    statement.bind(3, key, keyLen, SQLITE_STATIC);
-    statement.step();
+    auto statement = prepare("INSERT INTO keys (identity_id, key_name, key_bits) "
+                             "VALUES ((SELECT id FROM identities WHERE identity=?), ?, ?)");
+    statement->bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
+    statement->bind(2, keyName.wireEncode(), SQLITE_TRANSIENT);
+    statement->bind(3, key, keyLen, SQLITE_STATIC);
+    execute(statement);
+
+    mirror.keys[keyName] = {identity, Buffer(key, keyLen)};
+    // key_default_after_insert_trigger
+    mirror.defaultKeys.emplace(identity, keyName);
   }
   else {
-    Sqlite3Statement statement(m_database,
-                               "UPDATE keys SET key_bits=? WHERE key_name=?");
-    statement.bind(1, key, keyLen, SQLITE_STATIC);
-    statement.bind(2, keyName.wireEncode(), SQLITE_TRANSIENT);
-    statement.step();
+    auto statement = prepare("UPDATE keys SET key_bits=? WHERE key_name=?");
+    statement->bind(1, key, keyLen, SQLITE_STATIC);
+    statement->bind(2, keyName.wireEncode(), SQLITE_TRANSIENT);
+    execute(statement);
+
+    mirror.keys[keyName].bits = Buffer(key, keyLen);
   }
 
   if (!hasDefaultKeyOfIdentity(identity)) {
@@ -391,19 +519,36 @@ PibSqlite3::addKey(const Name& identity, const Name& keyName,
 void
 PibSqlite3::removeKey(const Name& keyName)
 {
-  Sqlite3Statement statement(m_database, "DELETE FROM keys WHERE key_name=?");
-  statement.bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
-  statement.step();
+  Mirror& mirror = getMirror();
+
+  auto statement = prepare("DELETE FROM keys WHERE key_name=?");
+  statement->bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
+  execute(statement);
+
+  // certificates of the key are removed by ON DELETE CASCADE
+  auto key = mirror.keys.find(keyName);
+  if (key == mirror.keys.end()) {
+    return;
+  }
+  auto defaultKey = mirror.defaultKeys.find(key->second.identity);
+  if (defaultKey != mirror.defaultKeys.end() && defaultKey->second == keyName) {
+    mirror.defaultKeys.erase(defaultKey);
+  }
+  mirror.keys.erase(key);
+  mirror.defaultCerts.erase(keyName);
+  for (auto cert = mirror.certs.begin(); cert != mirror.certs.end();) {
+    cert = cert->second.keyName == keyName ? mirror.certs.erase(cert) : std::next(cert);
+  }
 }
 
 Buffer
 PibSqlite3::getKeyBits(const Name& keyName) const
 {
-  Sqlite3Statement statement(m_database, "SELECT key_bits FROM keys WHERE key_name=?");
-  statement.bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
+  const Mirror& mirror = getMirror();
 
-  if (statement.step() == SQLITE_ROW)
-    return Buffer(statement.getBlob(0), statement.getSize(0));
+  auto key = mirror.keys.find(keyName);
+  if (key != mirror.keys.end())
+    return key->second.bits;
   else
     NDN_THROW(Pib::Error("Key `" + keyName.toUri() + "` does not exist"));
 }
@@ -413,14 +558,10 @@ PibSqlite3::getKeysOfIdentity(const Name& identity) const
 {
   std::set<Name> keyNames;
 
-  Sqlite3Statement statement(m_database,
-                             "SELECT key_name "
-                             "FROM keys JOIN identities ON keys.identity_id=identities.id "
-                             "WHERE identities.identity=?");
-  statement.bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
-
-  while (statement.step() == SQLITE_ROW) {
-    keyNames.insert(Name(statement.getBlock(0)));
+  for (const auto& key : getMirror().keys) {
+    if (key.second.identity == identity) {
+      keyNames.insert(key.first);
+    }
   }
 
   return keyNames;
@@ -433,9 +574,14 @@ PibSqlite3::setDefaultKeyOfIdentity(const Name& identity, const Name& keyName)
     NDN_THROW(Pib::Error("Key `" + keyName.toUri() + "` does not exist"));
   }
 
-  Sqlite3Statement statement(m_database, "UPDATE keys SET is_default=1 WHERE key_name=?");
-  statement.bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
-  statement.step();
+  Mirror& mirror = getMirror();
+
+  auto statement = prepare("UPDATE keys SET is_default=1 WHERE key_name=?");
+  statement->bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
+  execute(statement);
+
+  // key_default_update_trigger applies to the identity that owns the key
+  mirror.defaultKeys[mirror.keys.at(keyName).identity] = keyName;
 }
 
 Name
@@ -445,14 +591,11 @@ PibSqlite3::getDefaultKeyOfIdentity(const Name& identity) const
     NDN_THROW(Pib::Error("Identity `" + identity.toUri() + "` does not exist"));
   }
 
-  Sqlite3Statement statement(m_database,
-                             "SELECT key_name "
-                             "FROM keys JOIN identities ON keys.identity_id=identities.id "
-                             "WHERE identities.identity=? AND keys.is_default=1");
-  statement.bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
+  const Mirror& mirror = getMirror();
 
-  if (statement.step() == SQLITE_ROW) {
-    return Name(statement.getBlock(0));
+  auto defaultKey = mirror.defaultKeys.find(identity);
+  if (defaultKey != mirror.defaultKeys.end()) {
+    return defaultKey->second;
   }
   else
     NDN_THROW(Pib::Error("No default key for identity `" + identity.toUri() + "`"));
@@ -461,21 +604,13 @@ PibSqlite3::getDefaultKeyOfIdentity(const Name& identity) const
 bool
 PibSqlite3::hasDefaultKeyOfIdentity(const Name& identity) const
 {
-  Sqlite3Statement statement(m_database,
-                             "SELECT key_name "
-                             "FROM keys JOIN identities ON keys.identity_id=identities.id "
-                             "WHERE identities.identity=? AND keys.is_default=1");
-  statement.bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
-
-  return (statement.step() == SQLITE_ROW);
+  return getMirror().defaultKeys.count(identity) > 0;
 }
 
 bool
 PibSqlite3::hasCertificate(const Name& certName) const
 {
-  Sqlite3Statement statement(m_database, "SELECT id FROM certificates WHERE certificate_name=?");
-  statement.bind(1, certName.wireEncode(), SQLITE_TRANSIENT);
-  return (statement.step() == SQLITE_ROW);
+  return getMirror().certs.count(certName) > 0;
 }
 
 void
@@ -485,22 +620,28 @@ PibSqlite3::addCertificate(const v2::Certificate& certificate)
   const Block& content = certificate.getContent();
   addKey(certificate.getIdentity(), certificate.getKeyName(), content.value(), content.value_size());
 
+  Mirror& mirror = getMirror();
+
   if (!hasCertificate(certificate.getName())) {
-    Sqlite3Statement statement(m_database,
-                               "INSERT INTO certificates "
-                               "(key_id, certificate_name, certificate_data) "
-                               "VALUES ((SELECT id FROM keys WHERE key_name=?), ?, ?)");
-    statement.bind(1, certificate.getKeyName().wireEncode(), SQLITE_TRANSIENT);
-    statement.bind(2, certificate.getName().wireEncode(), SQLITE_TRANSIENT);
-    statement.bind(3, certificate.wireEncode(), SQLITE_STATIC);
-    statement.step();
+    auto statement = prepare("INSERT INTO certificates "
+                             "(key_id, certificate_name, certificate_data) "
+                             "VALUES ((SELECT id FROM keys WHERE key_name=?), ?, ?)");
+    statement->bind(1, certificate.getKeyName().wireEncode(), SQLITE_TRANSIENT);
+    statement->bind(2, certificate.getName().wireEncode(), SQLITE_TRANSIENT);
+    statement->bind(3, certificate.wireEncode(), SQLITE_STATIC);
+    execute(statement);
+
+    mirror.certs[certificate.getName()] = {certificate.getKeyName(), certificate};
+    // cert_default_after_insert_trigger
+    mirror.defaultCerts.emplace(certificate.getKeyName(), certificate.getName());
   }
   else {
-    Sqlite3Statement statement(m_database,
-                               "UPDATE certificates SET certificate_data=? WHERE certificate_name=?");
-    statement.bind(1, certificate.wireEncode(), SQLITE_STATIC);
-    statement.bind(2, certificate.getName().wireEncode(), SQLITE_TRANSIENT);
-    statement.step();
+    auto statement = prepare("UPDATE certificates SET certificate_data=? WHERE certificate_name=?");
+    statement->bind(1, certificate.wireEncode(), SQLITE_STATIC);
+    statement->bind(2, certificate.getName().wireEncode(), SQLITE_TRANSIENT);
+    execute(statement);
+
+    mirror.certs[certificate.getName()].cert = certificate;
   }
 
   if (!hasDefaultCertificateOfKey(certificate.getKeyName())) {
@@ -511,20 +652,31 @@ PibSqlite3::addCertificate(const v2::Certificate& certificate)
 void
 PibSqlite3::removeCertificate(const Name& certName)
 {
-  Sqlite3Statement statement(m_database, "DELETE FROM certificates WHERE certificate_name=?");
-  statement.bind(1, certName.wireEncode(), SQLITE_TRANSIENT);
-  statement.step();
+  Mirror& mirror = getMirror();
+
+  auto statement = prepare("DELETE FROM certificates WHERE certificate_name=?");
+  statement->bind(1, certName.wireEncode(), SQLITE_TRANSIENT);
+  execute(statement);
+
+  auto cert = mirror.certs.find(certName);
+  if (cert == mirror.certs.end()) {
+    return;
+  }
+  auto defaultCert = mirror.defaultCerts.find(cert->second.keyName);
+  if (defaultCert != mirror.defaultCerts.end() && defaultCert->second == certName) {
+    mirror.defaultCerts.erase(defaultCert);
+  }
+  mirror.certs.erase(cert);
 }
 
 v2::Certificate
 PibSqlite3::getCertificate(const Name& certName) const
 {
-  Sqlite3Statement statement(m_database,
-                             "SELECT certificate_data FROM certificates WHERE certificate_name=?");
-  statement.bind(1, certName.wireEncode(), SQLITE_TRANSIENT);
+  const Mirror& mirror = getMirror();
 
-  if (statement.step() == SQLITE_ROW)
-    return v2::Certificate(statement.getBlock(0));
+  auto cert = mirror.certs.find(certName);
+  if (cert != mirror.certs.end())
+    return cert->second.cert;
   else
     NDN_THROW(Pib::Error("Certificate `" + certName.toUri() + "` does not exit"));
 }
@@ -534,14 +686,11 @@ PibSqlite3::getCertificatesOfKey(const Name& keyName) const
 {
   std::set<Name> certNames;
 
-  Sqlite3Statement statement(m_database,
-                             "SELECT certificate_name "
-                             "FROM certificates JOIN keys ON certificates.key_id=keys.id "
-                             "WHERE keys.key_name=?");
-  statement.bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
-
-  while (statement.step() == SQLITE_ROW)
-    certNames.insert(Name(statement.getBlock(0)));
+  for (const auto& cert : getMirror().certs) {
+    if (cert.second.keyName == keyName) {
+      certNames.insert(cert.first);
+    }
+  }
 
   return certNames;
 }
@@ -553,23 +702,24 @@ PibSqlite3::setDefaultCertificateOfKey(const Name& keyName, const Name& certName
     NDN_THROW(Pib::Error("Certificate `" + certName.toUri() + "` does not exist"));
   }
 
-  Sqlite3Statement statement(m_database,
-                             "UPDATE certificates SET is_default=1 WHERE certificate_name=?");
-  statement.bind(1, certName.wireEncode(), SQLITE_TRANSIENT);
-  statement.step();
+  Mirror& mirror = getMirror();
+
+  auto statement = prepare("UPDATE certificates SET is_default=1 WHERE certificate_name=?");
+  statement->bind(1, certName.wireEncode(), SQLITE_TRANSIENT);
+  execute(statement);
+
+  // cert_default_update_trigger applies to the key that owns the certificate
+  mirror.defaultCerts[mirror.certs.at(certName).keyName] = certName;
 }
 
 v2::Certificate
 PibSqlite3::getDefaultCertificateOfKey(const Name& keyName) const
 {
-  Sqlite3Statement statement(m_database,
-                             "SELECT certificate_data "
-                             "FROM certificates JOIN keys ON certificates.key_id=keys.id "
-                             "WHERE certificates.is_default=1 AND keys.key_name=?");
-  statement.bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
+  const Mirror& mirror = getMirror();
 
-  if (statement.step() == SQLITE_ROW)
-    return v2::Certificate(statement.getBlock(0));
+  auto defaultCert = mirror.defaultCerts.find(keyName);
+  if (defaultCert != mirror.defaultCerts.end())
+    return mirror.certs.at(defaultCert->second).cert;
   else
     NDN_THROW(Pib::Error("No default certificate for key `" + keyName.toUri() + "`"));
 }
@@ -577,13 +727,15 @@ PibSqlite3::getDefaultCertificateOfKey(const Name& keyName) const
 bool
 PibSqlite3::hasDefaultCertificateOfKey(const Name& keyName) const
 {
-  Sqlite3Statement statement(m_database,
-                             "SELECT certificate_data "
-                             "FROM certificates JOIN keys ON certificates.key_id=keys.id "
-                             "WHERE certificates.is_default=1 AND keys.key_name=?");
-  statement.bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
+  return getMirror().defaultCerts.count(keyName) > 0;
+}
 
-  return statement.step() == SQLITE_ROW;
+uint64_t
+PibSqlite3::getVersion() const
+{
+  // reload the mirror, and thus change the version, if another connection modified the database
+  getMirror();
+  return m_version;
 }
 
 } // namespace pib
@@ -24,9 +24,16 @@
 
 #include "ndn-cxx/security/pib/pib-impl.hpp"
 
+#include <map>
+#include <unordered_map>
+
 struct sqlite3;
 
 namespace ndn {
+namespace util {
+class Sqlite3Statement;
+} // namespace util
+
 namespace security {
 namespace pib {
 
@@ -35,6 +42,12 @@ namespace pib {
  *
  * All the contents in Pib are stored in a SQLite3 database file.
  * This backend provides more persistent storage than PibMemory.
+ *
+ * Prepared statements are cached for the lifetime of the database connection.  Identities,
+ * keys, and certificates are also kept in an in-memory mirror, which answers all lookups
+ * and is updated by every modification made through this object.  The mirror is reloaded
+ * when the database has been modified through another connection, as detected by
+ * SQLite's data_version.
  */
 class PibSqlite3 : public PibImpl
 {
@@ -136,6 +149,10 @@ public: // Certificate Management
   v2::Certificate
   getDefaultCertificateOfKey(const Name& keyName) const final;
 
+public: // Modification tracking
+  uint64_t
+  getVersion() const final;
+
 private:
   bool
   hasDefaultIdentity() const;
@@ -146,8 +163,85 @@ private:
   bool
   hasDefaultCertificateOfKey(const Name& keyName) const;
 
+private:
+  /**
+   * @brief Resets a cached statement instead of destroying it
+   */
+  struct StatementReset
+  {
+    void
+    operator()(util::Sqlite3Statement* statement) const;
+  };
+
+  using CachedStatement = std::unique_ptr<util::Sqlite3Statement, StatementReset>;
+
+  /**
+   * @brief Get the prepared statement for @p sql from the cache of this connection
+   *
+   * The statement is reset, releasing its bindings and any read transaction, when the
+   * returned handle is destroyed.
+   */
+  CachedStatement
+  prepare(const std::string& sql) const;
+
+  /**
+   * @brief Execute a statement that modifies the database
+   *
+   * The mirror is discarded if the modification fails, so that it does not diverge from
+   * the database.
+   */
+  void
+  execute(const CachedStatement& statement);
+
+  struct KeyEntry
+  {
+    Name identity;
+    Buffer bits;
+  };
+
+  struct CertificateEntry
+  {
+    Name keyName;
+    v2::Certificate cert;
+  };
+
+  /**
+   * @brief In-memory copy of the identities, keys, and certificates tables
+   */
+  struct Mirror
+  {
+    bool isLoaded = false;
+    int dataVersion = 0;
+
+    std::set<Name> identities;
+    bool hasDefaultIdentity = false;
+    Name defaultIdentity;
+    std::map<Name, KeyEntry> keys;
+    std::map<Name, Name> defaultKeys; ///< identity => its default key
+    std::map<Name, CertificateEntry> certs;
+    std::map<Name, Name> defaultCerts; ///< key name => its default certificate
+  };
+
+  /**
+   * @brief Get the mirror, reloading it if the database has been modified by another connection
+   */
+  Mirror&
+  getMirror() const;
+
+  void
+  loadMirror() const;
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /**
+   * @brief number of times the mirror has been loaded from the database
+   */
+  mutable size_t m_nMirrorLoads = 0;
+
 private:
   sqlite3* m_database;
+  mutable std::unordered_map<std::string, unique_ptr<util::Sqlite3Statement>> m_statements;
+  mutable Mirror m_mirror;
+  mutable uint64_t m_version = 1;
 };
 
 } // namespace pib
@@ -22,27 +22,69 @@
 #include "ndn-cxx/security/v2/certificate-cache.hpp"
 #include "ndn-cxx/util/logger.hpp"
 
+#include <boost/functional/hash.hpp>
+
 namespace ndn {
 namespace security {
 namespace v2 {
 
 NDN_LOG_INIT(ndn.security.v2.CertificateCache);
 
+/**
+ * @brief Check whether the identity part of @p certName contains a KEY component
+ *
+ * Certificates of such identities do not necessarily reside in the shard that a lookup
+ * derives from the first KEY component of the searched prefix.
+ */
+static bool
+isIrregularName(const Name& certName)
+{
+  auto identityEnd = certName.end() + Certificate::KEY_COMPONENT_OFFSET;
+  BOOST_ASSERT(identityEnd >= certName.begin());
+  return std::find(certName.begin(), identityEnd, Certificate::KEY_COMPONENT) != identityEnd;
+}
+
 time::nanoseconds
 CertificateCache::getDefaultLifetime()
 {
   return 1_h;
 }
 
+time::nanoseconds
+CertificateCache::getDefaultRefreshPeriod()
+{
+  return 1_min;
+}
+
 CertificateCache::CertificateCache(const time::nanoseconds& maxLifetime)
-  : m_certsByTime(m_certs.get<0>())
-  , m_certsByName(m_certs.get<1>())
+  : m_nIrregularNames(0)
   , m_maxLifetime(maxLifetime)
 {
+  for (auto& shard : m_shards) {
+    shard.snapshot = make_shared<const Snapshot>();
+  }
 }
 
+CertificateCache::CertificateCache(boost::asio::io_service& ioService,
+                                   const time::nanoseconds& maxLifetime,
+                                   const time::nanoseconds& refreshPeriod)
+  : CertificateCache(maxLifetime)
+{
+  m_scheduler = make_unique<Scheduler>(ioService);
+  m_refreshPeriod = refreshPeriod;
+  scheduleRefresh();
+}
+
+CertificateCache::~CertificateCache() = default;
+
 void
 CertificateCache::insert(const Certificate& cert)
+{
+  insert(cert, time::system_clock::TimePoint::max());
+}
+
+void
+CertificateCache::insert(const Certificate& cert, const time::system_clock::TimePoint& maxRemovalTime)
 {
   time::system_clock::TimePoint notAfterTime = cert.getValidityPeriod().getPeriod().second;
   time::system_clock::TimePoint now = time::system_clock::now();
@@ -51,60 +93,196 @@ CertificateCache::insert(const Certificate& cert)
     return;
   }
 
-  time::system_clock::TimePoint removalTime = std::min(notAfterTime, now + m_maxLifetime);
+  time::system_clock::TimePoint removalTime = std::min({notAfterTime, now + m_maxLifetime, maxRemovalTime});
+  if (removalTime <= now) {
+    NDN_LOG_DEBUG("Not adding " << cert.getName() << ": removal time has passed");
+    return;
+  }
+
   NDN_LOG_DEBUG("Adding " << cert.getName() << ", will remove in "
                 << time::duration_cast<time::seconds>(removalTime - now));
-  m_certs.insert(Entry(cert, removalTime));
+
+  const Name& certName = cert.getName();
+  size_t keyNameSize = static_cast<size_t>(static_cast<ssize_t>(certName.size()) + Certificate::KEY_ID_OFFSET + 1);
+  Shard& shard = m_shards[getShardIndex(certName, keyNameSize)];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  const auto& entries = shard.snapshot->entries;
+  auto it = entries.find(certName);
+  if (it != entries.end() && it->second.removalTime >= now) {
+    return;
+  }
+
+  updateShard(shard, now, [&] (Snapshot& snapshot) {
+    snapshot.entries.emplace(certName, Entry{make_shared<const Certificate>(cert), removalTime});
+    if (isIrregularName(certName)) {
+      ++snapshot.nIrregularNames;
+    }
+  });
 }
 
 void
 CertificateCache::clear()
 {
-  m_certs.clear();
+  for (auto& shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    m_nIrregularNames -= shard.snapshot->nIrregularNames;
+    std::atomic_store(&shard.snapshot, make_shared<const Snapshot>());
+  }
 }
 
 const Certificate*
 CertificateCache::find(const Name& certPrefix) const
 {
-  const_cast<CertificateCache*>(this)->refresh();
+  // the certificate remains owned by the current snapshot of its shard
+  return findShared(certPrefix).get();
+}
+
+const Certificate*
+CertificateCache::find(const Interest& interest) const
+{
+  return findShared(interest).get();
+}
+
+shared_ptr<const Certificate>
+CertificateCache::findShared(const Name& certPrefix) const
+{
   if (certPrefix.size() > 0 && certPrefix[-1].isImplicitSha256Digest()) {
     NDN_LOG_INFO("Certificate search using name with the implicit digest is not yet supported");
   }
-  auto itr = m_certsByName.lower_bound(certPrefix);
-  if (itr == m_certsByName.end() || !certPrefix.isPrefixOf(itr->getCertName()))
-    return nullptr;
-  return &itr->cert;
+  return findFirst(certPrefix, [] (const Certificate&) { return true; });
 }
 
-const Certificate*
-CertificateCache::find(const Interest& interest) const
+shared_ptr<const Certificate>
+CertificateCache::findShared(const Interest& interest) const
 {
   if (interest.getName().size() > 0 && interest.getName()[-1].isImplicitSha256Digest()) {
     NDN_LOG_INFO("Certificate search using name with implicit digest is not yet supported");
   }
-  const_cast<CertificateCache*>(this)->refresh();
-
-  for (auto i = m_certsByName.lower_bound(interest.getName());
-       i != m_certsByName.end() && interest.getName().isPrefixOf(i->getCertName());
-       ++i) {
-    const auto& cert = i->cert;
-    if (interest.matchesData(cert)) {
-      return &cert;
+  return findFirst(interest.getName(), [&] (const Certificate& cert) { return interest.matchesData(cert); });
+}
+
+void
+CertificateCache::refresh()
+{
+  time::system_clock::TimePoint now = time::system_clock::now();
+
+  for (auto& shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const auto& entries = shard.snapshot->entries;
+    bool hasExpired = std::any_of(entries.begin(), entries.end(),
+                                  [&] (const auto& entry) { return entry.second.removalTime < now; });
+    if (hasExpired) {
+      updateShard(shard, now, [] (Snapshot&) {});
     }
   }
-  return nullptr;
+}
+
+size_t
+CertificateCache::getNStoredCertificates() const
+{
+  size_t nCerts = 0;
+  for (const auto& shard : m_shards) {
+    nCerts += std::atomic_load(&shard.snapshot)->entries.size();
+  }
+  return nCerts;
+}
+
+size_t
+CertificateCache::getShardIndex(const Name& name, size_t keyNameSize)
+{
+  BOOST_ASSERT(keyNameSize <= name.size());
+
+  size_t hash = 0;
+  for (size_t i = 0; i < keyNameSize; ++i) {
+    boost::hash_combine(hash, name[i].type());
+    boost::hash_range(hash, name[i].value_begin(), name[i].value_end());
+  }
+  return hash % N_SHARDS;
+}
+
+const CertificateCache::Shard*
+CertificateCache::findShard(const Name& certPrefix) const
+{
+  if (m_nIrregularNames > 0) {
+    return nullptr;
+  }
+
+  // Every cached certificate has a single KEY component, followed by the last component
+  // of its key name, so the first KEY component of the prefix pins down the key name.
+  auto keyComp = std::find(certPrefix.begin(), certPrefix.end(), Certificate::KEY_COMPONENT);
+  size_t keyNameSize = static_cast<size_t>(keyComp - certPrefix.begin()) + 2;
+  if (keyComp == certPrefix.end() || keyNameSize > certPrefix.size()) {
+    return nullptr;
+  }
+  return &m_shards[getShardIndex(certPrefix, keyNameSize)];
 }
 
 void
-CertificateCache::refresh()
+CertificateCache::updateShard(Shard& shard, const time::system_clock::TimePoint& now,
+                              const std::function<void(Snapshot&)>& modify)
+{
+  const Snapshot& oldSnapshot = *shard.snapshot;
+  auto newSnapshot = make_shared<Snapshot>();
+  newSnapshot->nIrregularNames = oldSnapshot.nIrregularNames;
+
+  for (const auto& entry : oldSnapshot.entries) {
+    if (entry.second.removalTime >= now) {
+      newSnapshot->entries.emplace_hint(newSnapshot->entries.end(), entry);
+    }
+    else if (isIrregularName(entry.first)) {
+      --newSnapshot->nIrregularNames;
+    }
+  }
+  modify(*newSnapshot);
+
+  m_nIrregularNames += newSnapshot->nIrregularNames;
+  m_nIrregularNames -= oldSnapshot.nIrregularNames;
+  std::atomic_store(&shard.snapshot, shared_ptr<const Snapshot>(std::move(newSnapshot)));
+}
+
+template<typename Pred>
+shared_ptr<const Certificate>
+CertificateCache::findFirst(const Name& prefix, const Pred& pred) const
 {
   time::system_clock::TimePoint now = time::system_clock::now();
+  shared_ptr<const Certificate> found;
 
-  auto cIt = m_certsByTime.begin();
-  while (cIt != m_certsByTime.end() && cIt->removalTime < now) {
-    m_certsByTime.erase(cIt);
-    cIt = m_certsByTime.begin();
+  auto searchShard = [&] (const Shard& shard) {
+    auto snapshot = std::atomic_load(&shard.snapshot);
+    for (auto it = snapshot->entries.lower_bound(prefix);
+         it != snapshot->entries.end() && prefix.isPrefixOf(it->first);
+         ++it) {
+      if (found != nullptr && found->getName() < it->first) {
+        // an earlier match has been found in another shard
+        return;
+      }
+      if (it->second.removalTime >= now && pred(*it->second.cert)) {
+        found = it->second.cert;
+        return;
+      }
+    }
+  };
+
+  const Shard* shard = findShard(prefix);
+  if (shard != nullptr) {
+    searchShard(*shard);
+  }
+  else {
+    for (const auto& s : m_shards) {
+      searchShard(s);
+    }
   }
+  return found;
+}
+
+void
+CertificateCache::scheduleRefresh()
+{
+  m_refreshEvent = m_scheduler->schedule(m_refreshPeriod, [this] {
+    refresh();
+    scheduleRefresh();
+  });
 }
 
 } // namespace v2
@@ -24,11 +24,12 @@
 
 #include "ndn-cxx/interest.hpp"
 #include "ndn-cxx/security/v2/certificate.hpp"
+#include "ndn-cxx/util/scheduler.hpp"
 
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/mem_fun.hpp>
-#include <boost/multi_index/member.hpp>
+#include <array>
+#include <atomic>
+#include <map>
+#include <mutex>
 
 namespace ndn {
 namespace security {
@@ -39,6 +40,16 @@ namespace v2 {
  *
  * A certificate is removed no later than its NotAfter time, or maxLifetime after it has been
  * added to the cache.
+ *
+ * The cache can be shared by validators running in different threads.  Certificates are
+ * distributed among shards by a hash of their key name.  Each shard publishes an immutable
+ * snapshot of its certificates, while insertions and removals replace the snapshot under the
+ * shard's mutex.  Lookups do not take the shard's mutex, and therefore never wait for a
+ * modification in progress; they do, however, pin the snapshot with std::atomic_load, which is
+ * not lock-free in libstdc++ (it briefly holds one of a small pool of internal mutexes).
+ *
+ * Each insertion or removal copies the whole snapshot of the affected shard, i.e., it costs
+ * O(n/16) for n cached certificates.  The cache favors lookups over modifications.
  */
 class CertificateCache : noncopyable
 {
@@ -46,11 +57,27 @@ public:
   /**
    * @brief Create an object for certificate cache.
    *
+   * Expired certificates are never returned by lookups, and are released when their shard
+   * is modified next time.
+   *
    * @param maxLifetime the maximum time that certificates could live inside cache (default: 1 hour)
    */
   explicit
   CertificateCache(const time::nanoseconds& maxLifetime = getDefaultLifetime());
 
+  /**
+   * @brief Create an object for certificate cache that releases expired certificates periodically.
+   *
+   * @param ioService the io_service on which expired certificates are removed
+   * @param maxLifetime the maximum time that certificates could live inside cache
+   * @param refreshPeriod the interval between removals of expired certificates
+   */
+  CertificateCache(boost::asio::io_service& ioService,
+                   const time::nanoseconds& maxLifetime = getDefaultLifetime(),
+                   const time::nanoseconds& refreshPeriod = getDefaultRefreshPeriod());
+
+  ~CertificateCache();
+
   /**
    * @brief Insert certificate into cache.
    *
@@ -62,6 +89,18 @@ public:
   void
   insert(const Certificate& cert);
 
+  /**
+   * @brief Insert certificate into cache, to be removed no later than @p maxRemovalTime.
+   *
+   * The inserted certificate will also be removed no later than its NotAfter time, or
+   * maxLifetime defined during cache construction.
+   *
+   * @param cert  the certificate packet.
+   * @param maxRemovalTime  the latest time when the certificate should be removed from the cache.
+   */
+  void
+  insert(const Certificate& cert, const time::system_clock::TimePoint& maxRemovalTime);
+
   /**
    * @brief Remove all certificates from cache
    */
@@ -73,7 +112,9 @@ public:
    * @param certPrefix  Certificate prefix for searching the certificate.
    * @return The found certificate, nullptr if not found.
    *
-   * @note The returned value may be invalidated after next call to one of find methods.
+   * @note The returned value is invalidated when the certificate is removed from the cache,
+   *       which may happen at any time if other threads modify the cache.  Use findShared()
+   *       in that case.
    */
   const Certificate*
   find(const Name& certPrefix) const;
@@ -83,31 +124,28 @@ public:
    * @param interest  The input interest packet.
    * @return The found certificate that matches the interest, nullptr if not found.
    *
-   * @note The returned value may be invalidated after next call to one of find methods.
+   * @note The returned value is invalidated when the certificate is removed from the cache,
+   *       which may happen at any time if other threads modify the cache.  Use findShared()
+   *       in that case.
    */
   const Certificate*
   find(const Interest& interest) const;
 
-private:
-  class Entry
-  {
-  public:
-    Entry(const Certificate& cert, const time::system_clock::TimePoint& removalTime)
-      : cert(cert)
-      , removalTime(removalTime)
-    {
-    }
-
-    const Name&
-    getCertName() const
-    {
-      return cert.getName();
-    }
-
-  public:
-    Certificate cert;
-    time::system_clock::TimePoint removalTime;
-  };
+  /**
+   * @brief Get certificate given key name, sharing the ownership of the certificate
+   * @param certPrefix  Certificate prefix for searching the certificate.
+   * @return The found certificate, nullptr if not found.
+   */
+  shared_ptr<const Certificate>
+  findShared(const Name& certPrefix) const;
+
+  /**
+   * @brief Find certificate given interest, sharing the ownership of the certificate
+   * @param interest  The input interest packet.
+   * @return The found certificate that matches the interest, nullptr if not found.
+   */
+  shared_ptr<const Certificate>
+  findShared(const Interest& interest) const;
 
   /**
    * @brief Remove all outdated certificate entries.
@@ -115,30 +153,89 @@ private:
   void
   refresh();
 
+  /**
+   * @return the maximum time that certificates could live inside cache
+   */
+  time::nanoseconds
+  getMaxLifetime() const
+  {
+    return m_maxLifetime;
+  }
+
 public:
   static time::nanoseconds
   getDefaultLifetime();
 
+  static time::nanoseconds
+  getDefaultRefreshPeriod();
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /**
+   * @return number of stored certificates, including expired ones that have not been removed yet
+   */
+  size_t
+  getNStoredCertificates() const;
+
+  static constexpr size_t N_SHARDS = 16;
+
+private:
+  struct Entry
+  {
+    shared_ptr<const Certificate> cert;
+    time::system_clock::TimePoint removalTime;
+  };
+
+  struct Snapshot
+  {
+    std::map<Name, Entry> entries;
+    /// number of certificates whose identity contains a KEY component
+    size_t nIrregularNames = 0;
+  };
+
+  struct Shard
+  {
+    mutable std::mutex mutex; ///< serializes modifications of the shard
+    shared_ptr<const Snapshot> snapshot; ///< must be accessed with std::atomic_load/store
+  };
+
+  /**
+   * @brief Get the index of the shard for certificates of the key named by the first
+   *        @p keyNameSize components of @p name
+   */
+  static size_t
+  getShardIndex(const Name& name, size_t keyNameSize);
+
+  /**
+   * @brief Get the shard containing all certificates under @p certPrefix
+   * @return the shard, or nullptr if such certificates may reside in several shards
+   */
+  const Shard*
+  findShard(const Name& certPrefix) const;
+
+  /**
+   * @brief Replace the snapshot of @p shard, dropping entries expired before @p now
+   *
+   * The caller must hold the shard mutex. @p modify is applied to the new snapshot.
+   */
+  void
+  updateShard(Shard& shard, const time::system_clock::TimePoint& now,
+              const std::function<void(Snapshot&)>& modify);
+
+  template<typename Pred>
+  shared_ptr<const Certificate>
+  findFirst(const Name& prefix, const Pred& pred) const;
+
+  void
+  scheduleRefresh();
+
 private:
-  /// @todo Switch to InMemoryStorateTimeout after it is available (task #3917)
-  typedef boost::multi_index::multi_index_container<
-    Entry,
-    boost::multi_index::indexed_by<
-      boost::multi_index::ordered_non_unique<
-        boost::multi_index::member<Entry, const time::system_clock::TimePoint, &Entry::removalTime>
-      >,
-      boost::multi_index::ordered_unique<
-        boost::multi_index::const_mem_fun<Entry, const Name&, &Entry::getCertName>
-      >
-    >
-  > CertIndex;
-
-  typedef CertIndex::nth_index<0>::type CertIndexByTime;
-  typedef CertIndex::nth_index<1>::type CertIndexByName;
-  CertIndex m_certs;
-  CertIndexByTime& m_certsByTime;
-  CertIndexByName& m_certsByName;
+  std::array<Shard, N_SHARDS> m_shards;
+  std::atomic<size_t> m_nIrregularNames;
   time::nanoseconds m_maxLifetime;
+
+  unique_ptr<Scheduler> m_scheduler;
+  time::nanoseconds m_refreshPeriod;
+  scheduler::ScopedEventId m_refreshEvent;
 };
 
 } // namespace v2
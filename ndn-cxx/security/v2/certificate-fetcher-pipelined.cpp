@@ -0,0 +1,251 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/security/v2/certificate-fetcher-pipelined.hpp"
+#include "ndn-cxx/face.hpp"
+#include "ndn-cxx/util/logger.hpp"
+
+namespace ndn {
+namespace security {
+namespace v2 {
+
+NDN_LOG_INIT(ndn.security.v2.CertificateFetcherPipelined);
+
+#define NDN_LOG_DEBUG_DEPTH(x) NDN_LOG_DEBUG(std::string(state->getDepth() + 1, '>') << " " << x)
+
+CertificateFetcherPipelined::CertificateFetcherPipelined(Face& face)
+  : CertificateFetcherFromNetwork(face)
+  , m_prefetchHint([] (const Name& keyLocator) { return guessAncestorKeys(keyLocator); })
+{
+}
+
+void
+CertificateFetcherPipelined::setPrefetchHint(PrefetchHint hint)
+{
+  m_prefetchHint = std::move(hint);
+}
+
+std::vector<Name>
+CertificateFetcherPipelined::guessAncestorKeys(const Name& keyLocator, size_t depth)
+{
+  Name identity;
+  if (keyLocator.size() >= 2 && keyLocator[-2] == Certificate::KEY_COMPONENT) {
+    identity = keyLocator.getPrefix(-2); // key name
+  }
+  else if (keyLocator.size() >= 4 && keyLocator[Certificate::KEY_COMPONENT_OFFSET] == Certificate::KEY_COMPONENT) {
+    identity = keyLocator.getPrefix(Certificate::KEY_COMPONENT_OFFSET); // certificate name
+  }
+  else {
+    return {};
+  }
+
+  std::vector<Name> prefixes;
+  for (size_t i = 1; i <= depth && i < identity.size(); ++i) {
+    prefixes.push_back(identity.getPrefix(-static_cast<ssize_t>(i)).append(Certificate::KEY_COMPONENT));
+  }
+  return prefixes;
+}
+
+void
+CertificateFetcherPipelined::doFetch(const shared_ptr<CertificateRequest>& certRequest,
+                                     const shared_ptr<ValidationState>& state,
+                                     const ValidationContinuation& continueValidation)
+{
+  const Name& name = certRequest->interest.getName();
+
+  PendingFetch* pending = findPendingFetch(name);
+  if (pending != nullptr) {
+    NDN_LOG_DEBUG_DEPTH("Waiting for outstanding fetch of " << name);
+    pending->waiters.push_back({certRequest, state, continueValidation});
+  }
+  else {
+    PendingFetch& fetch = m_pendingFetches[name];
+    fetch.certRequest = certRequest;
+    fetch.waiters.push_back({certRequest, state, continueValidation});
+    expressInterest(name, certRequest->interest);
+  }
+
+  prefetch(name);
+}
+
+CertificateFetcherPipelined::PendingFetch*
+CertificateFetcherPipelined::findPendingFetch(const Name& name)
+{
+  auto it = m_pendingFetches.find(name);
+  if (it != m_pendingFetches.end()) {
+    return &it->second;
+  }
+
+  // a speculative fetch of a shorter prefix may bring the certificate too
+  for (size_t len = name.size(); len-- > 0;) {
+    it = m_pendingFetches.find(name.getPrefix(len));
+    if (it != m_pendingFetches.end() && it->second.certRequest == nullptr) {
+      return &it->second;
+    }
+  }
+  return nullptr;
+}
+
+void
+CertificateFetcherPipelined::prefetch(const Name& keyLocator)
+{
+  if (!m_prefetchHint) {
+    return;
+  }
+
+  for (const Name& prefix : m_prefetchHint(keyLocator)) {
+    Interest interest(prefix);
+    interest.setCanBePrefix(true);
+
+    if (m_certStorage->findTrustedCert(interest) != nullptr) {
+      // the chain is expected to end here
+      break;
+    }
+
+    auto pendingIt = m_pendingFetches.lower_bound(prefix);
+    if ((pendingIt != m_pendingFetches.end() && prefix.isPrefixOf(pendingIt->first)) ||
+        findPendingFetch(prefix) != nullptr ||
+        m_certStorage->getUnverifiedCertCache().find(interest) != nullptr) {
+      continue;
+    }
+
+    NDN_LOG_DEBUG("Prefetching " << prefix << " for " << keyLocator);
+    m_pendingFetches[prefix]; // speculative fetch without waiters
+    expressInterest(prefix, interest);
+  }
+}
+
+void
+CertificateFetcherPipelined::expressInterest(const Name& pendingName, const Interest& interest)
+{
+  m_face.expressInterest(interest,
+                         [=] (const Interest&, const Data& data) {
+                           onData(pendingName, data);
+                         },
+                         [=] (const Interest&, const lp::Nack&) {
+                           onFailure(pendingName, true);
+                         },
+                         [=] (const Interest&) {
+                           onFailure(pendingName, false);
+                         });
+}
+
+void
+CertificateFetcherPipelined::onData(const Name& pendingName, const Data& data)
+{
+  auto it = m_pendingFetches.find(pendingName);
+  if (it == m_pendingFetches.end()) {
+    return;
+  }
+  // continuations can start new fetches, so the entry is detached first
+  PendingFetch fetch = std::move(it->second);
+  m_pendingFetches.erase(it);
+  bool isSpeculative = fetch.certRequest == nullptr;
+
+  NDN_LOG_DEBUG("Fetched certificate from network " << data.getName()
+                << (isSpeculative ? " (prefetched)" : ""));
+
+  Certificate cert;
+  try {
+    cert = Certificate(data);
+  }
+  catch (const tlv::Error& e) {
+    if (isSpeculative) {
+      NDN_LOG_DEBUG("Prefetched a malformed certificate " << data.getName());
+      return refetch(fetch.waiters);
+    }
+    return failWaiters(fetch.waiters, {ValidationError::Code::MALFORMED_CERT,
+                                       "Fetched a malformed certificate `" + data.getName().toUri() +
+                                       "` (" + e.what() + ")"});
+  }
+
+  if (isSpeculative) {
+    m_certStorage->cacheUnverifiedCert(Certificate(cert));
+  }
+
+  for (auto& waiter : fetch.waiters) {
+    if (!isSpeculative || waiter.certRequest->interest.matchesData(cert)) {
+      waiter.continueValidation(cert, waiter.state);
+    }
+    else {
+      // the speculation did not bring the requested certificate
+      doFetch(waiter.certRequest, waiter.state, waiter.continueValidation);
+    }
+  }
+}
+
+void
+CertificateFetcherPipelined::onFailure(const Name& pendingName, bool isNack)
+{
+  auto it = m_pendingFetches.find(pendingName);
+  if (it == m_pendingFetches.end()) {
+    return;
+  }
+  PendingFetch& fetch = it->second;
+
+  if (fetch.certRequest == nullptr) {
+    NDN_LOG_DEBUG("Cannot prefetch " << pendingName);
+    auto waiters = std::move(fetch.waiters);
+    m_pendingFetches.erase(it);
+    return refetch(waiters);
+  }
+
+  auto certRequest = fetch.certRequest;
+  NDN_LOG_DEBUG((isNack ? "NACK" : "Timeout") << " while fetching certificate " << pendingName);
+
+  --certRequest->nRetriesLeft;
+  if (certRequest->nRetriesLeft >= 0) {
+    if (isNack) {
+      m_scheduler.schedule(certRequest->waitAfterNack,
+                           [=] { expressInterest(pendingName, certRequest->interest); });
+      certRequest->waitAfterNack *= 2;
+    }
+    else {
+      expressInterest(pendingName, certRequest->interest);
+    }
+    return;
+  }
+
+  auto waiters = std::move(fetch.waiters);
+  m_pendingFetches.erase(it);
+  failWaiters(waiters, {ValidationError::Code::CANNOT_RETRIEVE_CERT, "Cannot fetch certificate after all "
+                        "retries `" + pendingName.toUri() + "`"});
+}
+
+void
+CertificateFetcherPipelined::refetch(std::vector<Waiter>& waiters)
+{
+  for (auto& waiter : waiters) {
+    doFetch(waiter.certRequest, waiter.state, waiter.continueValidation);
+  }
+}
+
+void
+CertificateFetcherPipelined::failWaiters(std::vector<Waiter>& waiters, ValidationError error)
+{
+  for (auto& waiter : waiters) {
+    waiter.state->fail(error);
+  }
+}
+
+} // namespace v2
+} // namespace security
+} // namespace ndn
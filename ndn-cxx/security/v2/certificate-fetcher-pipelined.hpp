@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_SECURITY_V2_CERTIFICATE_FETCHER_PIPELINED_HPP
+#define NDN_SECURITY_V2_CERTIFICATE_FETCHER_PIPELINED_HPP
+
+#include "ndn-cxx/security/v2/certificate-fetcher-from-network.hpp"
+
+#include <map>
+
+namespace ndn {
+namespace security {
+namespace v2 {
+
+/**
+ * @brief Extends CertificateFetcherFromNetwork to retrieve a certificate chain in parallel
+ *
+ * When a certificate is requested, this fetcher also expresses speculative Interests for the
+ * certificates that are expected further up the chain, as suggested by a prefetch hint.  By
+ * default, the hint assumes a hierarchical trust model and guesses that the signer of a key is
+ * a key of an ancestor identity.  Speculatively retrieved certificates are added to the
+ * unverified certificate cache, from which subsequent requests of the validator are satisfied.
+ *
+ * Concurrent requests for the same certificate, including requests from different validation
+ * states, are coalesced into a single Interest.
+ */
+class CertificateFetcherPipelined : public CertificateFetcherFromNetwork
+{
+public:
+  /**
+   * @brief Function that guesses the names of certificates needed after the one named @p keyLocator
+   * @return name prefixes of the expected certificates, closest to @p keyLocator first
+   */
+  using PrefetchHint = std::function<std::vector<Name>(const Name& keyLocator)>;
+
+  explicit
+  CertificateFetcherPipelined(Face& face);
+
+  /**
+   * @brief Set the function that suggests certificates to prefetch
+   *
+   * An empty function disables prefetching.
+   */
+  void
+  setPrefetchHint(PrefetchHint hint);
+
+  /**
+   * @brief Default prefetch hint for hierarchical trust models
+   * @return KEY prefixes of up to @p depth closest ancestors of the identity of @p keyLocator
+   */
+  static std::vector<Name>
+  guessAncestorKeys(const Name& keyLocator, size_t depth = getDefaultPrefetchDepth());
+
+  static constexpr size_t
+  getDefaultPrefetchDepth()
+  {
+    return 3;
+  }
+
+protected:
+  void
+  doFetch(const shared_ptr<CertificateRequest>& certRequest, const shared_ptr<ValidationState>& state,
+          const ValidationContinuation& continueValidation) override;
+
+private:
+  struct Waiter
+  {
+    shared_ptr<CertificateRequest> certRequest;
+    shared_ptr<ValidationState> state;
+    ValidationContinuation continueValidation;
+  };
+
+  struct PendingFetch
+  {
+    /// the request whose retry budget is used; nullptr for speculative fetches
+    shared_ptr<CertificateRequest> certRequest;
+    std::vector<Waiter> waiters;
+  };
+
+  /**
+   * @brief Find an outstanding fetch that may bring a certificate named @p name
+   */
+  PendingFetch*
+  findPendingFetch(const Name& name);
+
+  void
+  prefetch(const Name& keyLocator);
+
+  void
+  expressInterest(const Name& pendingName, const Interest& interest);
+
+  void
+  onData(const Name& pendingName, const Data& data);
+
+  void
+  onFailure(const Name& pendingName, bool isNack);
+
+  /**
+   * @brief Fetch the certificates of @p waiters with non-speculative Interests
+   */
+  void
+  refetch(std::vector<Waiter>& waiters);
+
+  void
+  failWaiters(std::vector<Waiter>& waiters, ValidationError error);
+
+private:
+  PrefetchHint m_prefetchHint;
+  std::map<Name, PendingFetch> m_pendingFetches;
+};
+
+} // namespace v2
+} // namespace security
+} // namespace ndn
+
+#endif // NDN_SECURITY_V2_CERTIFICATE_FETCHER_PIPELINED_HPP
@@ -73,6 +73,10 @@ CertificateStorage::resetAnchors()
 void
 CertificateStorage::cacheVerifiedCert(Certificate&& cert)
 {
+  if (m_persistentStore != nullptr) {
+    m_persistentStore->insert(cert, true,
+                              time::system_clock::now() + m_verifiedCertCache.getMaxLifetime());
+  }
   m_verifiedCertCache.insert(std::move(cert));
 }
 
@@ -80,14 +84,38 @@ void
 CertificateStorage::resetVerifiedCerts()
 {
   m_verifiedCertCache.clear();
+  if (m_persistentStore != nullptr) {
+    m_persistentStore->clear(true);
+  }
 }
 
 void
 CertificateStorage::cacheUnverifiedCert(Certificate&& cert)
 {
+  if (m_persistentStore != nullptr) {
+    m_persistentStore->insert(cert, false,
+                              time::system_clock::now() + m_unverifiedCertCache.getMaxLifetime());
+  }
   m_unverifiedCertCache.insert(std::move(cert));
 }
 
+void
+CertificateStorage::setPersistentStore(shared_ptr<CertificateStoreSqlite3> store)
+{
+  m_persistentStore = std::move(store);
+  if (m_persistentStore == nullptr) {
+    return;
+  }
+
+  // certificates verified by a previous instance are not trusted: the file may have been
+  // modified, and the trust anchors or policy may have changed since
+  for (bool isVerified : {true, false}) {
+    for (const auto& record : m_persistentStore->load(isVerified)) {
+      m_unverifiedCertCache.insert(record.cert, record.removalTime);
+    }
+  }
+}
+
 const TrustAnchorContainer&
 CertificateStorage::getTrustAnchors() const
 {
@@ -24,6 +24,7 @@
 
 #include "ndn-cxx/security/v2/certificate.hpp"
 #include "ndn-cxx/security/v2/certificate-cache.hpp"
+#include "ndn-cxx/security/v2/certificate-store-sqlite3.hpp"
 #include "ndn-cxx/security/v2/trust-anchor-container.hpp"
 
 namespace ndn {
@@ -130,10 +131,26 @@ protected:
   void
   resetVerifiedCerts();
 
+  /**
+   * @brief Keep verified and unverified certificate caches in a persistent store.
+   *
+   * Certificates found in @p store are loaded into the unverified certificate cache, unless
+   * their validity period or their remaining cache lifetime has expired.  This includes the
+   * certificates that were verified when they were stored: they are verified again against the
+   * current trust anchors and policy before being trusted.  Afterwards, every cached certificate
+   * is also written to @p store, and resetVerifiedCerts() clears the verified certificates in
+   * @p store as well.
+   *
+   * @param store the persistent store, nullptr to stop using the current one.
+   */
+  void
+  setPersistentStore(shared_ptr<CertificateStoreSqlite3> store);
+
 protected:
   TrustAnchorContainer m_trustAnchors;
   CertificateCache m_verifiedCertCache;
   CertificateCache m_unverifiedCertCache;
+  shared_ptr<CertificateStoreSqlite3> m_persistentStore;
 };
 
 } // namespace v2
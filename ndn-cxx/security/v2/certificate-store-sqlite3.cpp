@@ -0,0 +1,186 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/security/v2/certificate-store-sqlite3.hpp"
+#include "ndn-cxx/util/logger.hpp"
+#include "ndn-cxx/util/sqlite3-statement.hpp"
+
+#include <sqlite3.h>
+#include <boost/filesystem.hpp>
+
+namespace ndn {
+namespace security {
+namespace v2 {
+
+NDN_LOG_INIT(ndn.security.v2.CertificateStoreSqlite3);
+
+using util::Sqlite3Statement;
+
+static const std::string INITIALIZATION = R"SQL(
+CREATE TABLE IF NOT EXISTS
+  certificates(
+    certificate_name      BLOB NOT NULL,
+    is_verified           INTEGER NOT NULL,
+    certificate_data      BLOB NOT NULL,
+    removal_time          INTEGER NOT NULL,
+    PRIMARY KEY(certificate_name, is_verified)
+  );
+)SQL";
+
+static int64_t
+toMilliseconds(const time::system_clock::TimePoint& tp)
+{
+  return time::toUnixTimestamp(tp).count();
+}
+
+CertificateStoreSqlite3::CertificateStoreSqlite3(const std::string& path)
+{
+  boost::filesystem::path dbPath(path);
+  if (dbPath.has_parent_path()) {
+    boost::filesystem::create_directories(dbPath.parent_path());
+  }
+
+  int result = sqlite3_open_v2(dbPath.c_str(), &m_database,
+                               SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE,
+#ifdef NDN_CXX_DISABLE_SQLITE3_FS_LOCKING
+                               "unix-dotfile"
+#else
+                               nullptr
+#endif
+                               );
+
+  if (result != SQLITE_OK) {
+    sqlite3_close(m_database);
+    NDN_THROW(Error("Certificate store cannot be opened/created in " + path));
+  }
+
+  // readers are not blocked by write-through of newly cached certificates;
+  // losing the most recent writes on power failure is acceptable for a cache
+  sqlite3_exec(m_database, "PRAGMA journal_mode=WAL", nullptr, nullptr, nullptr);
+  sqlite3_exec(m_database, "PRAGMA synchronous=NORMAL", nullptr, nullptr, nullptr);
+
+  char* errmsg = nullptr;
+  result = sqlite3_exec(m_database, INITIALIZATION.c_str(), nullptr, nullptr, &errmsg);
+  if (result != SQLITE_OK && errmsg != nullptr) {
+    std::string what = "Certificate store cannot be initialized: "s + errmsg;
+    sqlite3_free(errmsg);
+    sqlite3_close(m_database);
+    NDN_THROW(Error(what));
+  }
+}
+
+CertificateStoreSqlite3::~CertificateStoreSqlite3()
+{
+  sqlite3_close(m_database);
+}
+
+void
+CertificateStoreSqlite3::insert(const Certificate& cert, bool isVerified,
+                                const time::system_clock::TimePoint& removalTime)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  Sqlite3Statement statement(m_database,
+                             "INSERT OR REPLACE INTO certificates "
+                             "(certificate_name, is_verified, certificate_data, removal_time) "
+                             "VALUES (?, ?, ?, ?)");
+  statement.bind(1, cert.getName().wireEncode(), SQLITE_TRANSIENT);
+  statement.bind(2, isVerified ? 1 : 0);
+  statement.bind(3, cert.wireEncode(), SQLITE_STATIC);
+  sqlite3_bind_int64(statement, 4, toMilliseconds(removalTime));
+  if (statement.step() != SQLITE_DONE) {
+    NDN_LOG_WARN("Cannot store " << cert.getName() << ": " << sqlite3_errmsg(m_database));
+  }
+}
+
+std::vector<CertificateStoreSqlite3::Record>
+CertificateStoreSqlite3::load(bool isVerified)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto now = time::system_clock::now();
+
+  Sqlite3Statement deleteStatement(m_database,
+                                   "DELETE FROM certificates WHERE is_verified=? AND removal_time<=?");
+  deleteStatement.bind(1, isVerified ? 1 : 0);
+  sqlite3_bind_int64(deleteStatement, 2, toMilliseconds(now));
+  deleteStatement.step();
+
+  std::vector<Record> records;
+  std::vector<Block> invalidNames;
+  Sqlite3Statement statement(m_database,
+                             "SELECT certificate_name, certificate_data, removal_time "
+                             "FROM certificates WHERE is_verified=?");
+  statement.bind(1, isVerified ? 1 : 0);
+  while (statement.step() == SQLITE_ROW) {
+    auto removalTime = time::fromUnixTimestamp(time::milliseconds(sqlite3_column_int64(statement, 2)));
+    try {
+      Certificate cert(statement.getBlock(1));
+      if (cert.isValid(now)) {
+        records.push_back({std::move(cert), removalTime});
+        continue;
+      }
+      NDN_LOG_DEBUG("Dropping " << cert.getName() << ": outside of validity period");
+    }
+    catch (const tlv::Error& e) {
+      NDN_LOG_WARN("Dropping malformed certificate: " << e.what());
+    }
+    invalidNames.push_back(statement.getBlock(0));
+  }
+
+  for (const auto& name : invalidNames) {
+    Sqlite3Statement removeStatement(m_database,
+                                     "DELETE FROM certificates WHERE certificate_name=? AND is_verified=?");
+    removeStatement.bind(1, name, SQLITE_TRANSIENT);
+    removeStatement.bind(2, isVerified ? 1 : 0);
+    removeStatement.step();
+  }
+
+  NDN_LOG_DEBUG("Loaded " << records.size() << (isVerified ? " verified" : " unverified")
+                << " certificates");
+  return records;
+}
+
+void
+CertificateStoreSqlite3::clear(bool isVerified)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  Sqlite3Statement statement(m_database, "DELETE FROM certificates WHERE is_verified=?");
+  statement.bind(1, isVerified ? 1 : 0);
+  statement.step();
+}
+
+size_t
+CertificateStoreSqlite3::size(bool isVerified) const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  Sqlite3Statement statement(m_database, "SELECT count(*) FROM certificates WHERE is_verified=?");
+  statement.bind(1, isVerified ? 1 : 0);
+  if (statement.step() == SQLITE_ROW) {
+    return static_cast<size_t>(statement.getInt(0));
+  }
+  return 0;
+}
+
+} // namespace v2
+} // namespace security
+} // namespace ndn
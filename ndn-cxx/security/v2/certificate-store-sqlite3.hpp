@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_SECURITY_V2_CERTIFICATE_STORE_SQLITE3_HPP
+#define NDN_SECURITY_V2_CERTIFICATE_STORE_SQLITE3_HPP
+
+#include "ndn-cxx/security/v2/certificate.hpp"
+
+#include <mutex>
+
+struct sqlite3;
+
+namespace ndn {
+namespace security {
+namespace v2 {
+
+/**
+ * @brief Persistent storage of cached certificates, based on SQLite3 database
+ *
+ * The store keeps a copy of the verified and unverified certificate caches of a validator
+ * on disk, so that a restarted validator can be warmed up without fetching intermediate
+ * certificates again.  The content of the store is not authenticated: a validator treats
+ * every stored certificate as unverified.  The database is opened in write-ahead logging mode, so
+ * that write-through of newly cached certificates does not block concurrent readers.
+ *
+ * @sa CertificateStorage::setPersistentStore
+ */
+class CertificateStoreSqlite3 : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  /**
+   * @brief A certificate loaded from the store
+   */
+  struct Record
+  {
+    Certificate cert;
+    time::system_clock::TimePoint removalTime;
+  };
+
+  /**
+   * @brief Open or create the store
+   * @param path path of the database file; missing parent directories are created.
+   * @throw Error the database cannot be opened or initialized.
+   */
+  explicit
+  CertificateStoreSqlite3(const std::string& path);
+
+  ~CertificateStoreSqlite3();
+
+  /**
+   * @brief Store @p cert, replacing a previously stored certificate with the same name
+   * @param cert the certificate
+   * @param isVerified whether @p cert belongs to the verified certificate cache
+   * @param removalTime the time when @p cert is to be removed from the cache
+   */
+  void
+  insert(const Certificate& cert, bool isVerified, const time::system_clock::TimePoint& removalTime);
+
+  /**
+   * @brief Load stored certificates
+   *
+   * Certificates whose removal time has passed, or which are outside of their validity
+   * period, are deleted from the store and not returned.
+   *
+   * @param isVerified whether to load certificates of the verified or unverified cache
+   */
+  std::vector<Record>
+  load(bool isVerified);
+
+  /**
+   * @brief Delete all certificates of the verified or unverified cache
+   */
+  void
+  clear(bool isVerified);
+
+  /**
+   * @return number of stored certificates of the verified or unverified cache
+   */
+  size_t
+  size(bool isVerified) const;
+
+private:
+  sqlite3* m_database;
+  mutable std::mutex m_mutex;
+};
+
+} // namespace v2
+} // namespace security
+} // namespace ndn
+
+#endif // NDN_SECURITY_V2_CERTIFICATE_STORE_SQLITE3_HPP
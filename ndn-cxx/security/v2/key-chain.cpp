@@ -429,32 +429,58 @@ KeyChain::importSafeBag(const SafeBag& safeBag, const char* pw, size_t pwLen)
 void
 KeyChain::sign(Data& data, const SigningInfo& params)
 {
-  Name keyName;
-  SignatureInfo sigInfo;
-  std::tie(keyName, sigInfo) = prepareSignatureInfo(params);
+  ResolvedSigner signer = resolveSigner(params);
+  sign(data, signer);
+}
+
+void
+KeyChain::sign(Interest& interest, const SigningInfo& params)
+{
+  ResolvedSigner signer = resolveSigner(params);
+  sign(interest, signer);
+}
+
+Block
+KeyChain::sign(const uint8_t* buffer, size_t bufferLength, const SigningInfo& params)
+{
+  ResolvedSigner signer = resolveSigner(params);
+  return sign(buffer, bufferLength, signer);
+}
 
-  data.setSignature(Signature(sigInfo));
+KeyChain::ResolvedSigner
+KeyChain::resolveSigner(const SigningInfo& params)
+{
+  ResolvedSigner signer;
+  signer.m_params = params;
+  resolve(signer);
+  return signer;
+}
+
+void
+KeyChain::sign(Data& data, ResolvedSigner& signer)
+{
+  refresh(signer);
+
+  data.setSignature(Signature(signer.m_sigInfo));
 
   EncodingBuffer encoder;
   data.wireEncode(encoder, true);
 
-  Block sigValue = sign(encoder.buf(), encoder.size(), keyName, params.getDigestAlgorithm());
+  Block sigValue = generateSignature(encoder.buf(), encoder.size(), signer);
 
   data.wireEncode(encoder, sigValue);
 }
 
 void
-KeyChain::sign(Interest& interest, const SigningInfo& params)
+KeyChain::sign(Interest& interest, ResolvedSigner& signer)
 {
-  Name keyName;
-  SignatureInfo sigInfo;
-  std::tie(keyName, sigInfo) = prepareSignatureInfo(params);
+  refresh(signer);
 
   Name signedName = interest.getName();
-  signedName.append(sigInfo.wireEncode()); // signatureInfo
+  signedName.append(signer.m_sigInfo.wireEncode()); // signatureInfo
 
-  Block sigValue = sign(signedName.wireEncode().value(), signedName.wireEncode().value_size(),
-                        keyName, params.getDigestAlgorithm());
+  Block sigValue = generateSignature(signedName.wireEncode().value(),
+                                     signedName.wireEncode().value_size(), signer);
 
   sigValue.encode();
   signedName.append(sigValue); // signatureValue
@@ -462,13 +488,11 @@ KeyChain::sign(Interest& interest, const SigningInfo& params)
 }
 
 Block
-KeyChain::sign(const uint8_t* buffer, size_t bufferLength, const SigningInfo& params)
+KeyChain::sign(const uint8_t* buffer, size_t bufferLength, ResolvedSigner& signer)
 {
-  Name keyName;
-  SignatureInfo sigInfo;
-  std::tie(keyName, sigInfo) = prepareSignatureInfo(params);
+  refresh(signer);
 
-  return sign(buffer, bufferLength, keyName, params.getDigestAlgorithm());
+  return generateSignature(buffer, bufferLength, signer);
 }
 
 // public: PIB/TPM creation helpers
@@ -669,14 +693,47 @@ KeyChain::prepareSignatureInfo(const SigningInfo& params)
   return std::make_tuple(key.getName(), sigInfo);
 }
 
+void
+KeyChain::resolve(ResolvedSigner& signer)
+{
+  // read the version first, so that modifications during resolution are not missed
+  uint64_t pibVersion = m_pib->m_impl->getVersion();
+
+  std::tie(signer.m_keyName, signer.m_sigInfo) = prepareSignatureInfo(signer.m_params);
+  signer.m_sigInfo.wireEncode();
+
+  if (signer.m_keyName == SigningInfo::getDigestSha256Identity()) {
+    signer.m_key = nullptr;
+  }
+  else {
+    // the key handle stays valid until the key is deleted, which also modifies the PIB
+    signer.m_key = m_tpm->findKey(signer.m_keyName);
+    if (signer.m_key == nullptr) {
+      NDN_THROW(Error("Private key `" + signer.m_keyName.toUri() + "` does not exist in TPM"));
+    }
+  }
+
+  signer.m_keyChain = this;
+  signer.m_pibVersion = pibVersion;
+}
+
+void
+KeyChain::refresh(ResolvedSigner& signer)
+{
+  uint64_t pibVersion = m_pib->m_impl->getVersion();
+  if (signer.m_keyChain != this || pibVersion == 0 || pibVersion != signer.m_pibVersion) {
+    NDN_LOG_TRACE("Resolving signer again for " << signer.m_params);
+    resolve(signer);
+  }
+}
+
 Block
-KeyChain::sign(const uint8_t* buf, size_t size,
-               const Name& keyName, DigestAlgorithm digestAlgorithm) const
+KeyChain::generateSignature(const uint8_t* buf, size_t size, const ResolvedSigner& signer) const
 {
-  if (keyName == SigningInfo::getDigestSha256Identity())
+  if (signer.m_key == nullptr)
     return Block(tlv::SignatureValue, util::Sha256::computeDigest(buf, size));
 
-  return Block(tlv::SignatureValue, m_tpm->sign(buf, size, keyName, digestAlgorithm));
+  return Block(tlv::SignatureValue, signer.m_key->sign(signer.getDigestAlgorithm(), buf, size));
 }
 
 tlv::SignatureTypeValue
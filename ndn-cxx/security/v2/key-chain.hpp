@@ -290,6 +290,101 @@ public: // signing
   Block
   sign(const uint8_t* buffer, size_t bufferLength, const SigningInfo& params = getDefaultSigningInfo());
 
+  /**
+   * @brief Signing parameters resolved from a SigningInfo
+   *
+   * A ResolvedSigner caches the private key, the encoded SignatureInfo, and the digest
+   * algorithm selected for a SigningInfo, so that signing packets with it involves no PIB
+   * lookups.  It is resolved again by the next signing operation after the PIB has been
+   * modified, e.g., when a default identity, key, or certificate is changed.
+   *
+   * @sa resolveSigner
+   */
+  class ResolvedSigner
+  {
+  public:
+    /**
+     * @return name of the signing key, or SigningInfo::getDigestSha256Identity()
+     */
+    const Name&
+    getKeyName() const
+    {
+      return m_keyName;
+    }
+
+    /**
+     * @return SignatureInfo placed in packets signed with this signer
+     */
+    const SignatureInfo&
+    getSignatureInfo() const
+    {
+      return m_sigInfo;
+    }
+
+    DigestAlgorithm
+    getDigestAlgorithm() const
+    {
+      return m_params.getDigestAlgorithm();
+    }
+
+  private:
+    SigningInfo m_params;
+    Name m_keyName;
+    SignatureInfo m_sigInfo; ///< encoded once and reused for every packet
+    const tpm::KeyHandle* m_key = nullptr; ///< nullptr when signing with DigestSha256
+    const KeyChain* m_keyChain = nullptr;
+    uint64_t m_pibVersion = 0;
+
+    friend KeyChain;
+  };
+
+  /**
+   * @brief Resolve the signing key and SignatureInfo selected by @p params
+   *
+   * The returned signer can be used to sign many packets with the same parameters.
+   *
+   * @throw Error the private key does not exist in the TPM
+   * @throw InvalidSigningInfoError invalid @p params is specified or specified identity, key,
+   *                                or certificate does not exist
+   */
+  ResolvedSigner
+  resolveSigner(const SigningInfo& params = getDefaultSigningInfo());
+
+  /**
+   * @brief Sign data with resolved signing parameters
+   *
+   * @p signer is resolved again if the PIB has been modified since it was resolved.
+   *
+   * @throw Error signing fails
+   * @throw InvalidSigningInfoError @p signer can no longer be resolved
+   */
+  void
+  sign(Data& data, ResolvedSigner& signer);
+
+  /**
+   * @brief Sign interest with resolved signing parameters
+   *
+   * @p signer is resolved again if the PIB has been modified since it was resolved.
+   *
+   * @throw Error signing fails
+   * @throw InvalidSigningInfoError @p signer can no longer be resolved
+   * @see docs/specs/signed-interest.rst
+   */
+  void
+  sign(Interest& interest, ResolvedSigner& signer);
+
+  /**
+   * @brief Sign buffer with resolved signing parameters
+   *
+   * @p signer is resolved again if the PIB has been modified since it was resolved.
+   *
+   * @return a SignatureValue TLV block
+   * @throw Error signing fails
+   * @throw InvalidSigningInfoError @p signer can no longer be resolved
+   */
+  Block
+  sign(const uint8_t* buffer, size_t bufferLength, ResolvedSigner& signer);
+
 public: // export & import
   /**
    * @brief Export a certificate and its corresponding private key.
@@ -414,12 +509,24 @@ private: // signing
   std::tuple<Name, SignatureInfo>
   prepareSignatureInfo(const SigningInfo& params);
 
+  /**
+   * @brief Resolve @p signer from its SigningInfo
+   */
+  void
+  resolve(ResolvedSigner& signer);
+
+  /**
+   * @brief Resolve @p signer again if it has not been resolved from the current PIB contents
+   */
+  void
+  refresh(ResolvedSigner& signer);
+
   /**
    * @brief Generate a SignatureValue block for a buffer @p buf with size @p size using
-   *        a key with name @p keyName and digest algorithm @p digestAlgorithm.
+   *        the key and digest algorithm of @p signer.
    */
   Block
-  sign(const uint8_t* buf, size_t size, const Name& keyName, DigestAlgorithm digestAlgorithm) const;
+  generateSignature(const uint8_t* buf, size_t size, const ResolvedSigner& signer) const;
 
 public:
   static const SigningInfo&
@@ -25,15 +25,83 @@ namespace ndn {
 namespace security {
 namespace v2 {
 
+ValidationPolicyCommandInterest::RecordTable::RecordTable(const Options& options)
+  : m_maxRecords(options.maxRecords)
+  , m_recordLifetime(options.recordLifetime)
+  , m_index(m_container.get<0>())
+  , m_queue(m_container.get<1>())
+{
+}
+
+optional<uint64_t>
+ValidationPolicyCommandInterest::RecordTable::find(const Name& keyName)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  cleanup();
+
+  auto it = m_index.find(keyName);
+  if (it == m_index.end()) {
+    return nullopt;
+  }
+  return it->timestamp;
+}
+
+void
+ValidationPolicyCommandInterest::RecordTable::insert(const Name& keyName, uint64_t timestamp)
+{
+  auto now = time::steady_clock::now();
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto it = m_index.find(keyName);
+  if (it == m_index.end()) {
+    m_queue.push_back({keyName, timestamp, now});
+    return;
+  }
+
+  // set lastRefreshed field, and move to queue tail
+  m_index.modify(it, [=] (LastTimestampRecord& record) {
+    record.timestamp = std::max(record.timestamp, timestamp);
+    record.lastRefreshed = now;
+  });
+  m_queue.relocate(m_queue.end(), m_container.project<1>(it));
+}
+
+size_t
+ValidationPolicyCommandInterest::RecordTable::size() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_container.size();
+}
+
+void
+ValidationPolicyCommandInterest::RecordTable::cleanup()
+{
+  auto expiring = time::steady_clock::now() - m_recordLifetime;
+
+  while ((!m_queue.empty() && m_queue.front().lastRefreshed <= expiring) ||
+         (m_maxRecords >= 0 && m_queue.size() > static_cast<size_t>(m_maxRecords))) {
+    m_queue.pop_front();
+  }
+}
+
 ValidationPolicyCommandInterest::ValidationPolicyCommandInterest(unique_ptr<ValidationPolicy> inner,
                                                                  const Options& options)
+  : ValidationPolicyCommandInterest(std::move(inner), options, make_shared<RecordTable>(options))
+{
+}
+
+ValidationPolicyCommandInterest::ValidationPolicyCommandInterest(unique_ptr<ValidationPolicy> inner,
+                                                                 const Options& options,
+                                                                 shared_ptr<RecordTable> records)
   : m_options(options)
-  , m_index(m_container.get<0>())
-  , m_queue(m_container.get<1>())
+  , m_records(std::move(records))
 {
   if (inner == nullptr) {
     NDN_THROW(std::invalid_argument("inner policy is missing"));
   }
+  if (m_records == nullptr) {
+    NDN_THROW(std::invalid_argument("record table is missing"));
+  }
   setInnerPolicy(std::move(inner));
 
   m_options.gracePeriod = std::max(m_options.gracePeriod, 0_ns);
@@ -64,18 +132,6 @@ ValidationPolicyCommandInterest::checkPolicy(const Interest& interest, const sha
   getInnerPolicy().checkPolicy(interest, state, std::bind(continueValidation, _1, _2));
 }
 
-void
-ValidationPolicyCommandInterest::cleanup()
-{
-  auto expiring = time::steady_clock::now() - m_options.recordLifetime;
-
-  while ((!m_queue.empty() && m_queue.front().lastRefreshed <= expiring) ||
-         (m_options.maxRecords >= 0 &&
-          m_queue.size() > static_cast<size_t>(m_options.maxRecords))) {
-    m_queue.pop_front();
-  }
-}
-
 std::tuple<bool, Name, uint64_t>
 ValidationPolicyCommandInterest::parseCommandInterest(const Interest& interest,
                                                       const shared_ptr<ValidationState>& state) const
@@ -106,8 +162,6 @@ bool
 ValidationPolicyCommandInterest::checkTimestamp(const shared_ptr<ValidationState>& state,
                                                 const Name& keyName, uint64_t timestamp)
 {
-  this->cleanup();
-
   auto now = time::system_clock::now();
   auto timestampPoint = time::fromUnixTimestamp(time::milliseconds(timestamp));
   if (timestampPoint < now - m_options.gracePeriod || timestampPoint > now + m_options.gracePeriod) {
@@ -116,41 +170,21 @@ ValidationPolicyCommandInterest::checkTimestamp(const shared_ptr<ValidationState
     return false;
   }
 
-  auto it = m_index.find(keyName);
-  if (it != m_index.end()) {
-    if (timestamp <= it->timestamp) {
-      state->fail({ValidationError::POLICY_ERROR,
-                   "Timestamp is reordered for key " + keyName.toUri()});
-      return false;
-    }
+  auto lastTimestamp = m_records->find(keyName);
+  if (lastTimestamp && timestamp <= *lastTimestamp) {
+    state->fail({ValidationError::POLICY_ERROR,
+                 "Timestamp is reordered for key " + keyName.toUri()});
+    return false;
   }
 
   auto interestState = dynamic_pointer_cast<InterestValidationState>(state);
   BOOST_ASSERT(interestState != nullptr);
-  interestState->afterSuccess.connect([=] (const Interest&) { insertNewRecord(keyName, timestamp); });
+  interestState->afterSuccess.connect([records = m_records, keyName, timestamp] (const Interest&) {
+    records->insert(keyName, timestamp);
+  });
   return true;
 }
 
-void
-ValidationPolicyCommandInterest::insertNewRecord(const Name& keyName, uint64_t timestamp)
-{
-  // try to insert new record
-  auto now = time::steady_clock::now();
-  auto i = m_queue.end();
-  bool isNew = false;
-  LastTimestampRecord newRecord{keyName, timestamp, now};
-  std::tie(i, isNew) = m_queue.push_back(newRecord);
-
-  if (!isNew) {
-    BOOST_ASSERT(i->keyName == keyName);
-
-    // set lastRefreshed field, and move to queue tail
-    m_queue.erase(i);
-    isNew = m_queue.push_back(newRecord).second;
-    BOOST_VERIFY(isNew);
-  }
-}
-
 } // namespace v2
 } // namespace security
 } // namespace ndn
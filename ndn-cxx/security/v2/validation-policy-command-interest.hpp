@@ -25,10 +25,12 @@
 #include "ndn-cxx/security/v2/validation-policy.hpp"
 
 #include <boost/multi_index_container.hpp>
-#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index/key_extractors.hpp>
 
+#include <mutex>
+
 namespace ndn {
 namespace security {
 namespace v2 {
@@ -92,6 +94,77 @@ public:
     time::nanoseconds recordLifetime = 1_h;
   };
 
+  /** \brief last timestamp records of public keys
+   *
+   *  A table can be shared by several policies, including policies used by validators
+   *  running in different threads, so that a command Interest accepted by one of them
+   *  cannot be replayed to another.  All operations are serialized by an internal mutex.
+   *
+   *  Records are indexed by a hash of the key name and kept in least-recently-refreshed order,
+   *  so that the cost of each operation does not depend on the number of tracked keys.
+   */
+  class RecordTable : ndn::noncopyable
+  {
+  public:
+    /** \brief constructor
+     *  \param options the table is limited by \p options.maxRecords and \p options.recordLifetime
+     */
+    explicit
+    RecordTable(const Options& options = {});
+
+    /** \brief erase expired records, then find the last timestamp recorded for \p keyName
+     *  \return the last timestamp, or nullopt if \p keyName is not tracked
+     */
+    optional<uint64_t>
+    find(const Name& keyName);
+
+    /** \brief record \p timestamp as the last timestamp of \p keyName, and refresh the record
+     *
+     *  If a larger timestamp has already been recorded, e.g., because another command Interest
+     *  signed by the same key has been validated concurrently, the larger timestamp is kept.
+     */
+    void
+    insert(const Name& keyName, uint64_t timestamp);
+
+    /** \return number of records, including records that have expired but not yet been erased
+     */
+    size_t
+    size() const;
+
+  private:
+    void
+    cleanup();
+
+  private:
+    struct LastTimestampRecord
+    {
+      Name keyName;
+      uint64_t timestamp;
+      time::steady_clock::TimePoint lastRefreshed;
+    };
+
+    using Container = boost::multi_index_container<
+      LastTimestampRecord,
+      boost::multi_index::indexed_by<
+        boost::multi_index::hashed_unique<
+          boost::multi_index::member<LastTimestampRecord, Name, &LastTimestampRecord::keyName>,
+          std::hash<Name>
+        >,
+        boost::multi_index::sequenced<>
+      >
+    >;
+    using Index = Container::nth_index<0>::type;
+    using Queue = Container::nth_index<1>::type;
+
+    const ssize_t m_maxRecords;
+    const time::nanoseconds m_recordLifetime;
+
+    mutable std::mutex m_mutex;
+    Container m_container;
+    Index& m_index;
+    Queue& m_queue;
+  };
+
   /** \brief constructor
    *  \param inner a Validator for signed Interest signature validation and Data validation;
    *               this must not be nullptr
@@ -102,6 +175,27 @@ public:
   ValidationPolicyCommandInterest(unique_ptr<ValidationPolicy> inner,
                                   const Options& options = {});
 
+  /** \brief constructor using a last timestamp record table that may be shared with other policies
+   *  \param inner a Validator for signed Interest signature validation and Data validation;
+   *               this must not be nullptr
+   *  \param options stop-and-wait command Interest validation options;
+   *                 \p options.maxRecords and \p options.recordLifetime are ignored in favor of
+   *                 the limits of \p records
+   *  \param records last timestamp record table; this must not be nullptr
+   *  \throw std::invalid_argument inner policy or record table is nullptr
+   */
+  ValidationPolicyCommandInterest(unique_ptr<ValidationPolicy> inner,
+                                  const Options& options,
+                                  shared_ptr<RecordTable> records);
+
+  /** \return last timestamp record table, which can be passed to other policies
+   */
+  const shared_ptr<RecordTable>&
+  getRecordTable() const
+  {
+    return m_records;
+  }
+
 protected:
   void
   checkPolicy(const Data& data, const shared_ptr<ValidationState>& state,
@@ -112,9 +206,6 @@ protected:
               const ValidationContinuation& continueValidation) override;
 
 private:
-  void
-  cleanup();
-
   std::tuple<bool, Name, uint64_t>
   parseCommandInterest(const Interest& interest, const shared_ptr<ValidationState>& state) const;
 
@@ -122,34 +213,9 @@ private:
   checkTimestamp(const shared_ptr<ValidationState>& state,
                  const Name& keyName, uint64_t timestamp);
 
-  void
-  insertNewRecord(const Name& keyName, uint64_t timestamp);
-
 private:
   Options m_options;
-
-  struct LastTimestampRecord
-  {
-    Name keyName;
-    uint64_t timestamp;
-    time::steady_clock::TimePoint lastRefreshed;
-  };
-
-  using Container = boost::multi_index_container<
-    LastTimestampRecord,
-    boost::multi_index::indexed_by<
-      boost::multi_index::ordered_unique<
-        boost::multi_index::member<LastTimestampRecord, Name, &LastTimestampRecord::keyName>
-      >,
-      boost::multi_index::sequenced<>
-    >
-  >;
-  using Index = Container::nth_index<0>::type;
-  using Queue = Container::nth_index<1>::type;
-
-  Container m_container;
-  Index& m_index;
-  Queue& m_queue;
+  shared_ptr<RecordTable> m_records;
 };
 
 } // namespace v2
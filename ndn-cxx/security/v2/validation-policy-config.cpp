@@ -100,10 +100,10 @@ ValidationPolicyConfig::load(const ConfigSection& configSection, const std::stri
     if (boost::iequals(sectionName, "rule")) {
       auto rule = Rule::create(section, filename);
       if (rule->getPktType() == tlv::Data) {
-        m_dataRules.push_back(std::move(rule));
+        m_dataRules.insert(std::move(rule));
       }
       else if (rule->getPktType() == tlv::Interest) {
-        m_interestRules.push_back(std::move(rule));
+        m_interestRules.insert(std::move(rule));
       }
     }
     else if (boost::iequals(sectionName, "trust-anchor")) {
@@ -255,14 +255,13 @@ ValidationPolicyConfig::checkPolicy(const Data& data, const shared_ptr<Validatio
     return;
   }
 
-  for (const auto& rule : m_dataRules) {
-    if (rule->match(tlv::Data, data.getName())) {
-      if (rule->check(tlv::Data, data.getName(), klName, state)) {
-        return continueValidation(make_shared<CertificateRequest>(klName), state);
-      }
-      // rule->check calls state->fail(...) if the check fails
-      return;
+  const Rule* rule = m_dataRules.findRule(tlv::Data, data.getName());
+  if (rule != nullptr) {
+    if (rule->check(tlv::Data, data.getName(), klName, state)) {
+      return continueValidation(make_shared<CertificateRequest>(klName), state);
     }
+    // rule->check calls state->fail(...) if the check fails
+    return;
   }
 
   return state->fail({ValidationError::POLICY_ERROR,
@@ -284,14 +283,13 @@ ValidationPolicyConfig::checkPolicy(const Interest& interest, const shared_ptr<V
     return;
   }
 
-  for (const auto& rule : m_interestRules) {
-    if (rule->match(tlv::Interest, interest.getName())) {
-      if (rule->check(tlv::Interest, interest.getName(), klName, state)) {
-        return continueValidation(make_shared<CertificateRequest>(klName), state);
-      }
-      // rule->check calls state->fail(...) if the check fails
-      return;
+  const Rule* rule = m_interestRules.findRule(tlv::Interest, interest.getName());
+  if (rule != nullptr) {
+    if (rule->check(tlv::Interest, interest.getName(), klName, state)) {
+      return continueValidation(make_shared<CertificateRequest>(klName), state);
     }
+    // rule->check calls state->fail(...) if the check fails
+    return;
   }
 
   return state->fail({ValidationError::POLICY_ERROR,
@@ -23,7 +23,7 @@
 #define NDN_SECURITY_V2_VALIDATION_POLICY_CONFIG_HPP
 
 #include "ndn-cxx/security/v2/validation-policy.hpp"
-#include "ndn-cxx/security/v2/validator-config/rule.hpp"
+#include "ndn-cxx/security/v2/validator-config/rule-index.hpp"
 #include "ndn-cxx/security/v2/validator-config/common.hpp"
 
 namespace ndn {
@@ -100,8 +100,8 @@ NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   bool m_shouldBypass;
   bool m_isConfigured;
 
-  std::vector<unique_ptr<Rule>> m_dataRules;
-  std::vector<unique_ptr<Rule>> m_interestRules;
+  RuleIndex m_dataRules;
+  RuleIndex m_interestRules;
 };
 
 } // namespace validator_config
@@ -41,11 +41,36 @@ Checker::check(uint32_t pktType, const Name& pktName, const Name& klName,
     if (pktName.size() < signed_interest::MIN_SIZE)
       return false;
 
-    return checkNames(pktName.getPrefix(-signed_interest::MIN_SIZE), klName, state);
+    return checkMemoized(pktName.getPrefix(-signed_interest::MIN_SIZE), klName, state);
   }
   else {
+    return checkMemoized(pktName, klName, state);
+  }
+}
+
+bool
+Checker::checkMemoized(const Name& pktName, const Name& klName, const shared_ptr<ValidationState>& state)
+{
+  size_t significantLength = getSignificantLength(pktName);
+  if (significantLength >= pktName.size()) {
     return checkNames(pktName, klName, state);
   }
+
+  auto key = std::make_pair(pktName.getPrefix(significantLength), klName);
+  if (m_passed.count(key) > 0) {
+    return true;
+  }
+
+  // failures are not remembered: they are rare, and the error message refers to the packet name
+  if (!checkNames(pktName, klName, state)) {
+    return false;
+  }
+
+  if (m_passed.size() >= MAX_PASSED_ENTRIES) {
+    m_passed.clear();
+  }
+  m_passed.insert(std::move(key));
+  return true;
 }
 
 NameRelationChecker::NameRelationChecker(const Name& name, const NameRelation& relation)
@@ -72,7 +97,7 @@ NameRelationChecker::checkNames(const Name& pktName, const Name& klName,
 }
 
 RegexChecker::RegexChecker(const Regex& regex)
-  : m_regex(regex)
+  : m_regex(regex.getExpr())
 {
 }
 
@@ -89,20 +114,51 @@ RegexChecker::checkNames(const Name& pktName, const Name& klName, const shared_p
   return result;
 }
 
+/**
+ * @brief Check whether @p expand refers to the entire match (\\0)
+ */
+static bool
+usesEntireMatch(const std::string& expand)
+{
+  for (size_t pos = expand.find('\\'); pos != std::string::npos; pos = expand.find('\\', pos)) {
+    size_t end = expand.find_first_not_of("0123456789", ++pos);
+    std::string digits = expand.substr(pos, end == std::string::npos ? end : end - pos);
+    if (!digits.empty() && digits.find_first_not_of('0') == std::string::npos) {
+      return true;
+    }
+  }
+  return false;
+}
+
 HyperRelationChecker::HyperRelationChecker(const std::string& pktNameExpr, const std::string pktNameExpand,
                                            const std::string& klNameExpr, const std::string klNameExpand,
                                            const NameRelation& hyperRelation)
   : m_hyperPRegex(pktNameExpr, pktNameExpand)
   , m_hyperKRegex(klNameExpr, klNameExpand)
   , m_hyperRelation(hyperRelation)
+  // The trailing <> consumes exactly the last component whatever it is, so the match and the
+  // captures of the rest of the expression only depend on the preceding components.
+  , m_ignoresLastPktComponent(boost::ends_with(pktNameExpr, "<>$") && !usesEntireMatch(pktNameExpand))
+  , m_isPktIdentity(pktNameExpr == "^(<>*)$" && pktNameExpand == "\\1")
 {
 }
 
+size_t
+HyperRelationChecker::getSignificantLength(const Name& pktName) const
+{
+  if (m_ignoresLastPktComponent && !pktName.empty()) {
+    return pktName.size() - 1;
+  }
+  return pktName.size();
+}
+
 bool
 HyperRelationChecker::checkNames(const Name& pktName, const Name& klName,
                                  const shared_ptr<ValidationState>& state)
 {
-  if (!m_hyperPRegex.match(pktName) || !m_hyperKRegex.match(klName)) {
+  bool isKlCached = !m_lastKlName.empty() && klName == m_lastKlName;
+  if ((!m_isPktIdentity && !m_hyperPRegex.match(pktName)) ||
+      (!isKlCached && !m_hyperKRegex.match(klName))) {
     std::ostringstream os;
     os << "Packet " << pktName << " (" << "KeyLocator=" << klName << ") does not match "
        << "the hyper relation rule pkt=" << m_hyperPRegex << ", key=" << m_hyperKRegex;
@@ -110,7 +166,13 @@ HyperRelationChecker::checkNames(const Name& pktName, const Name& klName,
     return false;
   }
 
-  bool result = checkNameRelation(m_hyperRelation, m_hyperKRegex.expand(), m_hyperPRegex.expand());
+  if (!isKlCached) {
+    m_lastKlName = klName;
+    m_lastKlExpanded = m_hyperKRegex.expand();
+  }
+
+  bool result = checkNameRelation(m_hyperRelation, m_lastKlExpanded,
+                                  m_isPktIdentity ? pktName : m_hyperPRegex.expand());
   if (!result) {
     std::ostringstream os;
     os << "KeyLocator check failed: hyper relation " << m_hyperRelation
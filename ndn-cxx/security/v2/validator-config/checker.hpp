@@ -26,6 +26,9 @@
 #include "ndn-cxx/security/v2/validator-config/common.hpp"
 #include "ndn-cxx/security/v2/validator-config/name-relation.hpp"
 #include "ndn-cxx/util/regex.hpp"
+#include "ndn-cxx/util/regex/regex-compiled-matcher.hpp"
+
+#include <set>
 
 namespace ndn {
 namespace security {
@@ -78,9 +81,35 @@ private:
   static unique_ptr<Checker>
   createKeyLocatorNameChecker(const ConfigSection& configSection, const std::string& configFilename);
 
+  bool
+  checkMemoized(const Name& pktName, const Name& klName, const shared_ptr<ValidationState>& state);
+
 protected:
   virtual bool
   checkNames(const Name& pktName, const Name& klName, const shared_ptr<ValidationState>& state) = 0;
+
+  /**
+   * @brief Get the number of leading components of @p pktName that can affect checkNames outcome
+   *
+   * Successful checks are remembered for the pair of this prefix and KeyLocator name, so that
+   * subsequent packets sharing both (e.g., segments of the same object) skip checkNames.
+   * The default implementation considers the whole packet name significant, which disables
+   * the memoization.
+   */
+  virtual size_t
+  getSignificantLength(const Name& pktName) const
+  {
+    return pktName.size();
+  }
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /** @brief (significant packet name prefix, KeyLocator name) pairs that passed the check
+   *
+   *  The set is emptied when it reaches MAX_PASSED_ENTRIES.
+   */
+  std::set<std::pair<Name, Name>> m_passed;
+
+  static constexpr size_t MAX_PASSED_ENTRIES = 1024;
 };
 
 class NameRelationChecker : public Checker
@@ -92,6 +121,12 @@ protected:
   bool
   checkNames(const Name& pktName, const Name& klName, const shared_ptr<ValidationState>& state) override;
 
+  size_t
+  getSignificantLength(const Name&) const override
+  {
+    return 0; // only the KeyLocator name is checked
+  }
+
 private:
   Name m_name;
   NameRelation m_relation;
@@ -107,8 +142,14 @@ protected:
   bool
   checkNames(const Name& pktName, const Name& klName, const shared_ptr<ValidationState>& state) override;
 
+  size_t
+  getSignificantLength(const Name&) const override
+  {
+    return 0; // only the KeyLocator name is checked
+  }
+
 private:
-  Regex m_regex;
+  RegexCompiledMatcher m_regex;
 };
 
 class HyperRelationChecker : public Checker
@@ -122,10 +163,22 @@ protected:
   bool
   checkNames(const Name& pktName, const Name& klName, const shared_ptr<ValidationState>& state) override;
 
+  size_t
+  getSignificantLength(const Name& pktName) const override;
+
 private:
   Regex m_hyperPRegex;
   Regex m_hyperKRegex;
   NameRelation m_hyperRelation;
+
+  /// packet name expression ends with a bare <>, and its expansion does not use \\0
+  bool m_ignoresLastPktComponent;
+  /// packet name expression matches any name and expands to the name itself
+  bool m_isPktIdentity;
+
+  /// KeyLocator name of the latest successful key expression match and its expansion
+  Name m_lastKlName;
+  Name m_lastKlExpanded;
 };
 
 } // namespace validator_config
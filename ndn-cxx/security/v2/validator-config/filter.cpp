@@ -28,6 +28,8 @@
 
 #include <boost/algorithm/string/predicate.hpp>
 
+#include <cstring>
+
 namespace ndn {
 namespace security {
 namespace v2 {
@@ -61,8 +63,48 @@ RelationNameFilter::matchName(const Name& name)
   return checkNameRelation(m_relation, m_name, name);
 }
 
+/**
+ * @brief Get the leading components that every name matched by @p expr must start with
+ *
+ * A component pattern is literal if it contains no regex metacharacter and is not repeated.
+ * As a component pattern is matched against the URI representation of the component,
+ * a literal pattern is satisfied only by the component it parses into.
+ */
+static Name
+getLiteralPrefix(const std::string& expr)
+{
+  static const char LITERAL_CHARS[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_~%=";
+
+  Name prefix;
+  if (expr.empty() || expr[0] != '^') {
+    return prefix;
+  }
+
+  size_t pos = 1;
+  while (pos < expr.size() && expr[pos] == '<') {
+    size_t end = expr.find('>', pos);
+    if (end == std::string::npos || end == pos + 1 ||
+        expr.find_first_not_of(LITERAL_CHARS, pos + 1) != end) {
+      break;
+    }
+    if (end + 1 < expr.size() && std::strchr("*+?{", expr[end + 1]) != nullptr) {
+      break;
+    }
+
+    try {
+      prefix.append(name::Component::fromEscapedString(expr.substr(pos + 1, end - pos - 1)));
+    }
+    catch (const name::Component::Error&) {
+      break;
+    }
+    pos = end + 1;
+  }
+  return prefix;
+}
+
 RegexNameFilter::RegexNameFilter(const Regex& regex)
-  : m_regex(regex)
+  : m_regex(regex.getExpr())
+  , m_prefix(getLiteralPrefix(regex.getExpr()))
 {
 }
 
@@ -27,6 +27,7 @@
 #include "ndn-cxx/security/v2/validator-config/common.hpp"
 #include "ndn-cxx/security/v2/validator-config/name-relation.hpp"
 #include "ndn-cxx/util/regex.hpp"
+#include "ndn-cxx/util/regex/regex-compiled-matcher.hpp"
 
 namespace ndn {
 namespace security {
@@ -49,6 +50,17 @@ public:
   bool
   match(uint32_t pktType, const Name& pktName);
 
+  /**
+   * @brief Get a prefix of every name accepted by the filter
+   *
+   * The default implementation returns an empty name, i.e., the filter may accept any name.
+   */
+  virtual Name
+  getRequiredPrefix() const
+  {
+    return Name();
+  }
+
 public:
   /**
    * @brief Create a filter from the configuration section
@@ -92,6 +104,15 @@ class RelationNameFilter : public Filter
 public:
   RelationNameFilter(const Name& name, NameRelation relation);
 
+  /**
+   * @return the configured name, which every relation requires to be a prefix of the packet name
+   */
+  Name
+  getRequiredPrefix() const override
+  {
+    return m_name;
+  }
+
 private:
   bool
   matchName(const Name& pktName) override;
@@ -126,12 +147,22 @@ public:
   explicit
   RegexNameFilter(const Regex& regex);
 
+  /**
+   * @return the leading literal components of an expression anchored with '^'
+   */
+  Name
+  getRequiredPrefix() const override
+  {
+    return m_prefix;
+  }
+
 private:
   bool
   matchName(const Name& pktName) override;
 
 private:
-  Regex m_regex;
+  RegexCompiledMatcher m_regex;
+  Name m_prefix;
 };
 
 } // namespace validator_config
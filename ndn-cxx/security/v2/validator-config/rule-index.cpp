@@ -0,0 +1,98 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/security/v2/validator-config/rule-index.hpp"
+
+#include <algorithm>
+
+namespace ndn {
+namespace security {
+namespace v2 {
+namespace validator_config {
+
+RuleIndex::RuleIndex()
+  : m_root(make_unique<Node>())
+{
+}
+
+RuleIndex::~RuleIndex() = default;
+
+void
+RuleIndex::insert(unique_ptr<Rule> rule)
+{
+  BOOST_ASSERT(rule != nullptr);
+  size_t pos = m_rules.size();
+
+  for (const Name& prefix : rule->getMatchPrefixes()) {
+    Node* node = m_root.get();
+    for (const auto& comp : prefix) {
+      auto& child = node->children[comp];
+      if (child == nullptr) {
+        child = make_unique<Node>();
+      }
+      node = child.get();
+    }
+    // a rule with several filters under the same prefix is attached only once
+    if (node->rules.empty() || node->rules.back() != pos) {
+      node->rules.push_back(pos);
+    }
+  }
+
+  m_rules.push_back(std::move(rule));
+}
+
+void
+RuleIndex::clear()
+{
+  m_rules.clear();
+  m_root = make_unique<Node>();
+}
+
+const Rule*
+RuleIndex::findRule(uint32_t pktType, const Name& pktName) const
+{
+  std::vector<size_t> candidates(m_root->rules);
+
+  const Node* node = m_root.get();
+  for (const auto& comp : pktName) {
+    auto it = node->children.find(comp);
+    if (it == node->children.end()) {
+      break;
+    }
+    node = it->second.get();
+    candidates.insert(candidates.end(), node->rules.begin(), node->rules.end());
+  }
+
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+  for (size_t pos : candidates) {
+    if (m_rules[pos]->match(pktType, pktName)) {
+      return m_rules[pos].get();
+    }
+  }
+  return nullptr;
+}
+
+} // namespace validator_config
+} // namespace v2
+} // namespace security
+} // namespace ndn
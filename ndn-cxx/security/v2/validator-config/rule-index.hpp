@@ -0,0 +1,96 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_SECURITY_V2_VALIDATOR_CONFIG_RULE_INDEX_HPP
+#define NDN_SECURITY_V2_VALIDATOR_CONFIG_RULE_INDEX_HPP
+
+#include "ndn-cxx/security/v2/validator-config/rule.hpp"
+
+#include <map>
+
+namespace ndn {
+namespace security {
+namespace v2 {
+namespace validator_config {
+
+/**
+ * @brief Ordered collection of rules, indexed by the name prefixes under which they may match
+ *
+ * Each rule is attached to the name prefix tree node of every prefix returned by
+ * Rule::getMatchPrefixes.  A lookup walks down the tree along the packet name and evaluates
+ * only the rules attached to the visited nodes, in insertion order.  The result is therefore
+ * the same as evaluating all rules in insertion order and taking the first match.
+ */
+class RuleIndex : noncopyable
+{
+public:
+  RuleIndex();
+
+  ~RuleIndex();
+
+  /**
+   * @brief Append @p rule after all previously inserted rules
+   */
+  void
+  insert(unique_ptr<Rule> rule);
+
+  /**
+   * @brief Remove all rules
+   */
+  void
+  clear();
+
+  size_t
+  size() const
+  {
+    return m_rules.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_rules.empty();
+  }
+
+  /**
+   * @brief Find the first inserted rule that matches the packet
+   * @return the matching rule, or nullptr if no rule matches
+   */
+  const Rule*
+  findRule(uint32_t pktType, const Name& pktName) const;
+
+private:
+  struct Node
+  {
+    std::map<name::Component, unique_ptr<Node>> children;
+    std::vector<size_t> rules; ///< positions in m_rules, ascending
+  };
+
+  std::vector<unique_ptr<Rule>> m_rules;
+  unique_ptr<Node> m_root;
+};
+
+} // namespace validator_config
+} // namespace v2
+} // namespace security
+} // namespace ndn
+
+#endif // NDN_SECURITY_V2_VALIDATOR_CONFIG_RULE_INDEX_HPP
@@ -72,6 +72,20 @@ Rule::match(uint32_t pktType, const Name& pktName) const
   return retval;
 }
 
+std::vector<Name>
+Rule::getMatchPrefixes() const
+{
+  if (m_filters.empty()) {
+    return {Name()};
+  }
+
+  std::vector<Name> prefixes;
+  for (const auto& filter : m_filters) {
+    prefixes.push_back(filter->getRequiredPrefix());
+  }
+  return prefixes;
+}
+
 bool
 Rule::check(uint32_t pktType, const Name& pktName, const Name& klName,
             const shared_ptr<ValidationState>& state) const
@@ -71,6 +71,15 @@ public:
   bool
   match(uint32_t pktType, const Name& pktName) const;
 
+  /**
+   * @brief get the name prefixes under which the rule may match
+   *
+   * Every packet name matched by the rule starts with at least one of the returned prefixes.
+   * An empty name is among them if the rule may match any name.
+   */
+  std::vector<Name>
+  getMatchPrefixes() const;
+
   /**
    * @brief check if packet satisfies rule's condition
    *
@@ -212,6 +212,12 @@ Validator::resetVerifiedCertificates()
   CertificateStorage::resetVerifiedCerts();
 }
 
+void
+Validator::setPersistentCertificateStore(shared_ptr<CertificateStoreSqlite3> store)
+{
+  CertificateStorage::setPersistentStore(std::move(store));
+}
+
 } // namespace v2
 } // namespace security
 } // namespace ndn
@@ -156,6 +156,20 @@ public: // anchor management
   void
   resetVerifiedCertificates();
 
+  /**
+   * @brief Keep cached certificates in @p store, and load the certificates already in it
+   *
+   * This allows a restarted validator to use the intermediate certificates fetched by its
+   * previous instance, without retrieving them again.  All certificates in the store are
+   * loaded as unverified, because the store may have been written under other trust anchors
+   * or policy, or by another process: they are verified again, against the current trust
+   * anchors and policy, as part of the certification chains that use them.
+   *
+   * @param store the persistent store, nullptr to stop using the current one.
+   */
+  void
+  setPersistentCertificateStore(shared_ptr<CertificateStoreSqlite3> store);
+
 private: // Common validator operations
   /**
    * @brief Recursive validation of the certificate in the certification chain
@@ -23,14 +23,12 @@
 
 #include "ndn-cxx/data.hpp"
 #include "ndn-cxx/interest.hpp"
-#include "ndn-cxx/encoding/buffer-stream.hpp"
 #include "ndn-cxx/security/impl/openssl.hpp"
+#include "ndn-cxx/security/impl/openssl-helper.hpp"
 #include "ndn-cxx/security/pib/key.hpp"
 #include "ndn-cxx/security/transform/bool-sink.hpp"
 #include "ndn-cxx/security/transform/buffer-source.hpp"
-#include "ndn-cxx/security/transform/digest-filter.hpp"
 #include "ndn-cxx/security/transform/public-key.hpp"
-#include "ndn-cxx/security/transform/stream-sink.hpp"
 #include "ndn-cxx/security/transform/verifier-filter.hpp"
 #include "ndn-cxx/security/v2/certificate.hpp"
 
@@ -194,18 +192,8 @@ bool
 verifyDigest(const uint8_t* blob, size_t blobLen, const uint8_t* digest, size_t digestLen,
              DigestAlgorithm algorithm)
 {
-  using namespace transform;
-
-  OBufferStream os;
-  try {
-    bufferSource(blob, blobLen) >> digestFilter(algorithm) >> streamSink(os);
-  }
-  catch (const transform::Error&) {
-    return false;
-  }
-  ConstBufferPtr result = os.buf();
-
-  if (result->size() != digestLen)
+  ConstBufferPtr result = detail::computeDigest(algorithm, blob, blobLen);
+  if (result == nullptr || result->size() != digestLen)
     return false;
 
   // constant-time buffer comparison to mitigate timing attacks
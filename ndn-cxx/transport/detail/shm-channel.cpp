@@ -0,0 +1,454 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/transport/detail/shm-channel.hpp"
+#include "ndn-cxx/encoding/buffer-pool.hpp"
+#include "ndn-cxx/util/logger.hpp"
+
+#include <boost/asio/io_service.hpp>
+
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+NDN_LOG_INIT(ndn.ShmChannel);
+
+namespace ndn {
+namespace detail {
+
+const size_t ShmChannel::DEFAULT_RING_CAPACITY = 256 * 1024;
+
+const uint32_t REGION_MAGIC = 0x4e444e53; // "NDNS"
+const uint32_t REGION_VERSION = 1;
+
+// polling budget, in number of checks of the receive ring
+const size_t MIN_SPIN_LIMIT = 16;
+const size_t MAX_SPIN_LIMIT = 16384;
+
+/** \brief header of the shared memory, followed by client-to-peer ring and peer-to-client ring
+ */
+struct alignas(64) RegionHeader
+{
+  uint32_t magic;
+  uint32_t version;
+  uint64_t ringCapacity;
+};
+
+static size_t
+getRegionSize(size_t ringCapacity)
+{
+  return sizeof(RegionHeader) + 2 * ShmRing::getRegionSize(ringCapacity);
+}
+
+static void*
+getRing(void* region, size_t ringCapacity, bool isClientToPeer)
+{
+  return static_cast<uint8_t*>(region) + sizeof(RegionHeader) +
+         (isClientToPeer ? 0 : ShmRing::getRegionSize(ringCapacity));
+}
+
+static void
+closeFds(const ShmChannel::Fds& fds)
+{
+  for (int fd : {fds.memfd, fds.clientDoorbell, fds.peerDoorbell}) {
+    if (fd >= 0) {
+      ::close(fd);
+    }
+  }
+}
+
+shared_ptr<ShmChannel>
+ShmChannel::create(boost::asio::io_service& ioService, size_t ringCapacity)
+{
+  if (ringCapacity < 2 * MAX_NDN_PACKET_SIZE || (ringCapacity & (ringCapacity - 1)) != 0) {
+    NDN_THROW(std::invalid_argument("Ring capacity must be a power of two that can hold "
+                                    "at least two packets"));
+  }
+
+  Fds fds{-1, -1, -1};
+  fds.memfd = ::memfd_create("ndn-shm-transport", MFD_CLOEXEC);
+  fds.clientDoorbell = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  fds.peerDoorbell = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (fds.memfd < 0 || fds.clientDoorbell < 0 || fds.peerDoorbell < 0) {
+    int savedErrno = errno;
+    closeFds(fds);
+    errno = savedErrno;
+    NDN_THROW_ERRNO(Error("Cannot create shared memory or doorbell"));
+  }
+
+  size_t regionSize = getRegionSize(ringCapacity);
+  if (::ftruncate(fds.memfd, static_cast<off_t>(regionSize)) < 0) {
+    int savedErrno = errno;
+    closeFds(fds);
+    errno = savedErrno;
+    NDN_THROW_ERRNO(Error("Cannot resize shared memory"));
+  }
+
+  void* region = ::mmap(nullptr, regionSize, PROT_READ | PROT_WRITE, MAP_SHARED, fds.memfd, 0);
+  if (region == MAP_FAILED) {
+    int savedErrno = errno;
+    closeFds(fds);
+    errno = savedErrno;
+    NDN_THROW_ERRNO(Error("Cannot map shared memory"));
+  }
+
+  auto header = new (region) RegionHeader;
+  header->magic = REGION_MAGIC;
+  header->version = REGION_VERSION;
+  header->ringCapacity = ringCapacity;
+
+  return shared_ptr<ShmChannel>(new ShmChannel(ioService, true, fds, region, regionSize,
+                                               ringCapacity));
+}
+
+shared_ptr<ShmChannel>
+ShmChannel::attach(boost::asio::io_service& ioService, const Fds& fds)
+{
+  struct stat st{};
+  if (::fstat(fds.memfd, &st) < 0 || static_cast<size_t>(st.st_size) < sizeof(RegionHeader)) {
+    closeFds(fds);
+    NDN_THROW(Error("Shared memory is too small"));
+  }
+
+  size_t regionSize = static_cast<size_t>(st.st_size);
+  void* region = ::mmap(nullptr, regionSize, PROT_READ | PROT_WRITE, MAP_SHARED, fds.memfd, 0);
+  if (region == MAP_FAILED) {
+    int savedErrno = errno;
+    closeFds(fds);
+    errno = savedErrno;
+    NDN_THROW_ERRNO(Error("Cannot map shared memory"));
+  }
+
+  const auto& header = *static_cast<const RegionHeader*>(region);
+  size_t ringCapacity = static_cast<size_t>(header.ringCapacity);
+  if (header.magic != REGION_MAGIC || header.version != REGION_VERSION ||
+      ringCapacity == 0 || (ringCapacity & (ringCapacity - 1)) != 0 ||
+      getRegionSize(ringCapacity) != regionSize) {
+    ::munmap(region, regionSize);
+    closeFds(fds);
+    NDN_THROW(Error("Shared memory does not contain a valid channel"));
+  }
+
+  return shared_ptr<ShmChannel>(new ShmChannel(ioService, false, fds, region, regionSize,
+                                               ringCapacity));
+}
+
+ShmChannel::ShmChannel(boost::asio::io_service& ioService, bool isClient, const Fds& fds,
+                       void* region, size_t regionSize, size_t ringCapacity)
+  : m_ioService(ioService)
+  , m_isClient(isClient)
+  , m_memfd(fds.memfd)
+  , m_otherDoorbell(isClient ? fds.peerDoorbell : fds.clientDoorbell)
+  , m_doorbell(ioService, isClient ? fds.clientDoorbell : fds.peerDoorbell)
+  , m_region(region)
+  , m_regionSize(regionSize)
+  , m_tx(getRing(region, ringCapacity, isClient), ringCapacity, isClient)
+  , m_rx(getRing(region, ringCapacity, !isClient), ringCapacity, isClient)
+  , m_spinLimit(MIN_SPIN_LIMIT)
+{
+}
+
+ShmChannel::~ShmChannel()
+{
+  boost::system::error_code error; // to silently ignore all errors
+  m_doorbell.close(error);
+  ::close(m_otherDoorbell);
+  ::close(m_memfd);
+  ::munmap(m_region, m_regionSize);
+}
+
+void
+ShmChannel::sendFds(int socket)
+{
+  BOOST_ASSERT(m_isClient);
+  int fds[] = {m_memfd, m_doorbell.native_handle(), m_otherDoorbell};
+
+  uint8_t data = 0;
+  iovec iov{};
+  iov.iov_base = &data;
+  iov.iov_len = sizeof(data);
+  union {
+    cmsghdr align;
+    uint8_t buffer[CMSG_SPACE(sizeof(fds))];
+  } control{};
+  msghdr msg{};
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buffer;
+  msg.msg_controllen = sizeof(control.buffer);
+
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+  std::memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+  if (::sendmsg(socket, &msg, MSG_NOSIGNAL) != sizeof(data)) {
+    NDN_THROW_ERRNO(Error("Cannot send shared memory descriptors"));
+  }
+}
+
+ShmChannel::Fds
+ShmChannel::receiveFds(int socket)
+{
+  int fds[3];
+  uint8_t data = 0;
+  iovec iov{};
+  iov.iov_base = &data;
+  iov.iov_len = sizeof(data);
+  union {
+    cmsghdr align;
+    uint8_t buffer[CMSG_SPACE(sizeof(fds))];
+  } control{};
+  msghdr msg{};
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buffer;
+  msg.msg_controllen = sizeof(control.buffer);
+
+  ssize_t nBytesRead = ::recvmsg(socket, &msg, MSG_CMSG_CLOEXEC);
+  if (nBytesRead < 0) {
+    NDN_THROW_ERRNO(Error("Cannot receive shared memory descriptors"));
+  }
+
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  if (nBytesRead != sizeof(data) || cmsg == nullptr ||
+      cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) {
+    NDN_THROW(Error("Message does not carry shared memory descriptors"));
+  }
+  if (cmsg->cmsg_len != CMSG_LEN(sizeof(fds)) || (msg.msg_flags & MSG_CTRUNC) != 0) {
+    size_t nFds = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+    std::memcpy(fds, CMSG_DATA(cmsg), std::min(nFds, size_t(3)) * sizeof(int));
+    for (size_t i = 0; i < std::min(nFds, size_t(3)); ++i) {
+      ::close(fds[i]);
+    }
+    NDN_THROW(Error("Message carries an unexpected number of descriptors"));
+  }
+
+  std::memcpy(fds, CMSG_DATA(cmsg), sizeof(fds));
+  return {fds[0], fds[1], fds[2]};
+}
+
+void
+ShmChannel::start(const ReceiveCallback& onReceive, const ErrorCallback& onError)
+{
+  BOOST_ASSERT(onReceive != nullptr && onError != nullptr);
+  m_onReceive = onReceive;
+  m_onError = onError;
+  m_isOpen = true;
+  asyncWaitDoorbell();
+}
+
+void
+ShmChannel::close()
+{
+  m_isOpen = false;
+  m_isReceiving = false;
+  m_txQueue.clear();
+
+  boost::system::error_code error; // to silently ignore all errors
+  m_doorbell.cancel(error);
+}
+
+void
+ShmChannel::setReceiving(bool wantReceive)
+{
+  if (!m_isOpen || m_isReceiving == wantReceive) {
+    return;
+  }
+
+  m_isReceiving = wantReceive;
+  if (wantReceive) {
+    // records may have arrived while not receiving, deliver them outside of the caller's stack
+    m_ioService.post([self = shared_from_this()] {
+      if (self->m_isOpen) {
+        self->process();
+      }
+    });
+  }
+  else {
+    m_rx.getControl().isConsumerWaiting.store(0);
+  }
+}
+
+void
+ShmChannel::send(const Block& header, const Block& payload)
+{
+  size_t size = header.size() + (payload.isValid() ? payload.size() : 0);
+  if (sizeof(ShmRing::RecordSize) + size > m_tx.getCapacity()) {
+    NDN_THROW(Error("Packet of " + to_string(size) + " octets exceeds ring capacity"));
+  }
+
+  m_txQueue.emplace_back(header, payload);
+  if (m_isOpen && m_txQueue.size() == 1) {
+    flushTx();
+  }
+  // otherwise, the queue is flushed when the peer frees up space
+}
+
+void
+ShmChannel::asyncWaitDoorbell()
+{
+  m_doorbell.async_read_some(boost::asio::buffer(&m_doorbellValue, sizeof(m_doorbellValue)),
+    [self = shared_from_this()] (const boost::system::error_code& error, size_t) {
+      self->handleDoorbell(error);
+    });
+}
+
+void
+ShmChannel::handleDoorbell(const boost::system::error_code& error)
+{
+  if (!m_isOpen || error == boost::asio::error::operation_aborted) {
+    return;
+  }
+  if (error) {
+    m_onError("error while waiting on doorbell: " + error.message());
+    return;
+  }
+
+  process();
+  if (m_isOpen) {
+    asyncWaitDoorbell();
+  }
+}
+
+void
+ShmChannel::process()
+{
+  flushTx();
+  if (!m_isReceiving) {
+    return;
+  }
+
+  auto& control = m_rx.getControl();
+  control.isConsumerWaiting.store(0);
+  if (drainRx()) {
+    // poll for more records before going back to sleep
+    bool hasMore = false;
+    for (size_t i = 0; i < m_spinLimit && m_isReceiving; ++i) {
+      if (!m_rx.isEmpty()) {
+        hasMore = true;
+        drainRx();
+      }
+    }
+    m_spinLimit = hasMore ? std::min(m_spinLimit * 2, MAX_SPIN_LIMIT) :
+                            std::max(m_spinLimit / 2, MIN_SPIN_LIMIT);
+  }
+  if (!m_isReceiving) {
+    return;
+  }
+
+  // also reached when nothing was drained (e.g., doorbell rung only for TX space),
+  // the producer would otherwise never ring again
+  control.isConsumerWaiting.store(1);
+  if (!m_rx.isEmpty()) {
+    // a record arrived before the flag was visible to the producer, which won't ring the doorbell
+    control.isConsumerWaiting.store(0);
+    m_ioService.post([self = shared_from_this()] {
+      if (self->m_isOpen) {
+        self->process();
+      }
+    });
+  }
+}
+
+bool
+ShmChannel::drainRx()
+{
+  bool hasReceived = false;
+  while (m_isReceiving) {
+    optional<size_t> size;
+    try {
+      size = m_rx.peekSize();
+    }
+    catch (const std::length_error& e) {
+      // the peer violated the ring protocol, nothing more can be trusted
+      close();
+      m_onError("corrupted receive ring: "s + e.what());
+      return hasReceived;
+    }
+    if (!size) {
+      break;
+    }
+
+    auto buffer = encoding::BufferPool::get().allocate(*size);
+    m_rx.pop(buffer->data(), *size);
+    if (m_rx.getControl().isProducerWaiting.exchange(0) != 0) {
+      ringOtherDoorbell();
+    }
+
+    Block element;
+    bool isOk = false;
+    std::tie(isOk, element) = Block::fromBuffer(buffer, 0);
+    if (!isOk || element.size() != *size) {
+      close();
+      m_onError("a valid TLV cannot be decoded from the receive ring");
+      return hasReceived;
+    }
+
+    hasReceived = true;
+    m_onReceive(element);
+  }
+  return hasReceived;
+}
+
+bool
+ShmChannel::tryPush(const Block& header, const Block& payload)
+{
+  bool isOk = payload.isValid() ?
+              m_tx.tryPush(header.wire(), header.size(), payload.wire(), payload.size()) :
+              m_tx.tryPush(header.wire(), header.size(), nullptr, 0);
+  if (isOk && m_tx.getControl().isConsumerWaiting.exchange(0) != 0) {
+    ringOtherDoorbell();
+  }
+  return isOk;
+}
+
+void
+ShmChannel::flushTx()
+{
+  while (!m_txQueue.empty()) {
+    if (!tryPush(m_txQueue.front().first, m_txQueue.front().second)) {
+      m_tx.getControl().isProducerWaiting.store(1);
+      // the consumer may have freed up space before the flag was visible
+      if (!tryPush(m_txQueue.front().first, m_txQueue.front().second)) {
+        NDN_LOG_TRACE("ring full, " << m_txQueue.size() << " packets queued");
+        return;
+      }
+    }
+    m_txQueue.pop_front();
+  }
+}
+
+void
+ShmChannel::ringOtherDoorbell() const
+{
+  uint64_t value = 1;
+  // EAGAIN means the counter is saturated and the other end will wake up anyway
+  if (::write(m_otherDoorbell, &value, sizeof(value)) < 0 && errno != EAGAIN) {
+    NDN_LOG_DEBUG("cannot ring doorbell: " << std::strerror(errno));
+  }
+}
+
+} // namespace detail
+} // namespace ndn
@@ -0,0 +1,195 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_TRANSPORT_DETAIL_SHM_CHANNEL_HPP
+#define NDN_TRANSPORT_DETAIL_SHM_CHANNEL_HPP
+
+#include "ndn-cxx/detail/asio-fwd.hpp"
+#include "ndn-cxx/encoding/block.hpp"
+#include "ndn-cxx/transport/detail/shm-ring.hpp"
+
+#ifndef NDN_CXX_HAVE_MEMFD
+#error "This file should not be included ..."
+#endif
+
+#include <boost/asio/posix/stream_descriptor.hpp>
+
+#include <deque>
+
+namespace ndn {
+namespace detail {
+
+/** \brief One end of a shared-memory packet channel between two processes on the same host.
+ *
+ *  The client end creates a memfd holding two ShmRing, one per direction, and two eventfd
+ *  used as doorbells, one per end. The descriptors are handed to the peer end over a Unix
+ *  stream socket with sendFds() and receiveFds().
+ *
+ *  Each end sleeps on its own doorbell and rings the other end's doorbell only when the other
+ *  end has announced, through the ring control area, that it is waiting for records or for
+ *  free space. After processing a wake-up, the receiver keeps polling the ring for a while before
+ *  going back to sleep; the polling budget grows when records keep arriving and shrinks when
+ *  they do not, so that bursty traffic avoids most wake-ups while an idle channel does not
+ *  consume CPU.
+ */
+class ShmChannel : public std::enable_shared_from_this<ShmChannel>, noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  /** \brief descriptors that make up a channel
+   */
+  struct Fds
+  {
+    int memfd;
+    int clientDoorbell;
+    int peerDoorbell;
+  };
+
+  using ReceiveCallback = function<void(const Block& wire)>;
+  using ErrorCallback = function<void(const std::string& reason)>;
+
+  static const size_t DEFAULT_RING_CAPACITY;
+
+  /** \brief create a channel as the client end, allocating the shared memory and doorbells
+   *  \param ringCapacity size of the data area of each ring, must be a power of two
+   *  \throw Error the shared memory or doorbells cannot be created
+   */
+  static shared_ptr<ShmChannel>
+  create(boost::asio::io_service& ioService, size_t ringCapacity = DEFAULT_RING_CAPACITY);
+
+  /** \brief attach to a channel created by the client end, taking ownership of \p fds
+   *  \throw Error the shared memory is invalid or cannot be mapped
+   */
+  static shared_ptr<ShmChannel>
+  attach(boost::asio::io_service& ioService, const Fds& fds);
+
+  ~ShmChannel();
+
+  /** \brief send the descriptors of this channel over a Unix stream socket
+   *  \pre this is the client end
+   *  \throw Error sendmsg failed
+   */
+  void
+  sendFds(int socket);
+
+  /** \brief receive the descriptors of a channel from a Unix stream socket
+   *  \throw Error recvmsg failed or the message does not carry the expected descriptors
+   */
+  static Fds
+  receiveFds(int socket);
+
+  /** \brief start waiting on the doorbell
+   *
+   *  Records are not delivered until setReceiving(true) is called.
+   *  \p onError is invoked when the channel can no longer be used; it may throw.
+   */
+  void
+  start(const ReceiveCallback& onReceive, const ErrorCallback& onError);
+
+  /** \brief stop all operations and release the doorbell
+   */
+  void
+  close();
+
+  /** \brief enable or disable delivery of received records
+   *
+   *  While disabled, records are left in the ring, where they exert backpressure on the peer.
+   */
+  void
+  setReceiving(bool wantReceive);
+
+  /** \brief send a TLV element composed of \p header followed by \p payload
+   *  \param payload may be an invalid Block if \p header is the whole element
+   *  \throw Error the element can never fit into the ring
+   *
+   *  If the ring is full, the element is queued and sent when the peer frees up space.
+   */
+  void
+  send(const Block& header, const Block& payload);
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  size_t
+  getSpinLimit() const
+  {
+    return m_spinLimit;
+  }
+
+private:
+  ShmChannel(boost::asio::io_service& ioService, bool isClient, const Fds& fds,
+             void* region, size_t regionSize, size_t ringCapacity);
+
+  void
+  asyncWaitDoorbell();
+
+  void
+  handleDoorbell(const boost::system::error_code& error);
+
+  /** \brief flush queued elements, then deliver received records and poll for more
+   */
+  void
+  process();
+
+  /** \brief deliver all records currently in the receive ring
+   *  \retval true at least one record was delivered
+   */
+  bool
+  drainRx();
+
+  bool
+  tryPush(const Block& header, const Block& payload);
+
+  void
+  flushTx();
+
+  void
+  ringOtherDoorbell() const;
+
+private:
+  boost::asio::io_service& m_ioService;
+  const bool m_isClient;
+  int m_memfd;
+  int m_otherDoorbell;
+  boost::asio::posix::stream_descriptor m_doorbell;
+  uint64_t m_doorbellValue = 0;
+
+  void* m_region;
+  size_t m_regionSize;
+  ShmRing m_tx;
+  ShmRing m_rx;
+
+  ReceiveCallback m_onReceive;
+  ErrorCallback m_onError;
+  bool m_isOpen = false;
+  bool m_isReceiving = false;
+  size_t m_spinLimit;
+
+  std::deque<std::pair<Block, Block>> m_txQueue;
+};
+
+} // namespace detail
+} // namespace ndn
+
+#endif // NDN_TRANSPORT_DETAIL_SHM_CHANNEL_HPP
@@ -0,0 +1,209 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_TRANSPORT_DETAIL_SHM_RING_HPP
+#define NDN_TRANSPORT_DETAIL_SHM_RING_HPP
+
+#include "ndn-cxx/detail/common.hpp"
+#include "ndn-cxx/encoding/tlv.hpp"
+
+#include <atomic>
+#include <cstring>
+
+namespace ndn {
+namespace detail {
+
+/** \brief Lock-free single-producer single-consumer ring of variable-size records.
+ *
+ *  The ring lives in memory shared by two processes: a control area with the producer and
+ *  consumer positions followed by the data area. Each record is a 4-octet length (in host byte
+ *  order, as both ends are on the same host) followed by the record octets; both may wrap around
+ *  the end of the data area.
+ *
+ *  The control area also carries two flags that let either side sleep instead of polling:
+ *  the consumer sets isConsumerWaiting before waiting for records, and the producer sets
+ *  isProducerWaiting before waiting for free space. The other side is expected to wake it up
+ *  (e.g., through an eventfd) when it observes the flag after publishing its position.
+ */
+class ShmRing
+{
+public:
+  struct Control
+  {
+    alignas(64) std::atomic<uint64_t> head; ///< total octets written, owned by producer
+    alignas(64) std::atomic<uint64_t> tail; ///< total octets consumed, owned by consumer
+    alignas(64) std::atomic<uint32_t> isConsumerWaiting;
+    std::atomic<uint32_t> isProducerWaiting;
+  };
+
+  static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "ShmRing requires lock-free 64-bit atomics");
+
+  using RecordSize = uint32_t;
+
+  /** \brief compute the size of shared memory occupied by a ring
+   */
+  static constexpr size_t
+  getRegionSize(size_t capacity) noexcept
+  {
+    return sizeof(Control) + capacity;
+  }
+
+  /** \brief attach to a ring at \p region
+   *  \param capacity size of the data area, must be a power of two
+   *  \param shouldInitialize whether to construct the control area; only the side that creates
+   *                          the shared memory should do this
+   */
+  ShmRing(void* region, size_t capacity, bool shouldInitialize) noexcept
+    : m_control(static_cast<Control*>(region))
+    , m_data(static_cast<uint8_t*>(region) + sizeof(Control))
+    , m_capacity(capacity)
+  {
+    BOOST_ASSERT(capacity > 0 && (capacity & (capacity - 1)) == 0);
+    if (shouldInitialize) {
+      new (m_control) Control;
+      m_control->head.store(0);
+      m_control->tail.store(0);
+      m_control->isConsumerWaiting.store(0);
+      m_control->isProducerWaiting.store(0);
+    }
+  }
+
+  size_t
+  getCapacity() const noexcept
+  {
+    return m_capacity;
+  }
+
+  Control&
+  getControl() const noexcept
+  {
+    return *m_control;
+  }
+
+public: // producer
+  /** \brief append one record that is the concatenation of two octet ranges
+   *  \retval false there is not enough free space; nothing is written
+   */
+  bool
+  tryPush(const uint8_t* buf1, size_t size1, const uint8_t* buf2, size_t size2) noexcept
+  {
+    size_t recordSize = sizeof(RecordSize) + size1 + size2;
+    uint64_t head = m_control->head.load(std::memory_order_relaxed);
+    uint64_t tail = m_control->tail.load(std::memory_order_acquire);
+    if (recordSize > m_capacity - static_cast<size_t>(head - tail)) {
+      return false;
+    }
+
+    RecordSize size = static_cast<RecordSize>(size1 + size2);
+    copyIn(head, reinterpret_cast<const uint8_t*>(&size), sizeof(size));
+    copyIn(head + sizeof(size), buf1, size1);
+    copyIn(head + sizeof(size) + size1, buf2, size2);
+    m_control->head.store(head + recordSize, std::memory_order_seq_cst);
+    return true;
+  }
+
+public: // consumer
+  bool
+  isEmpty() const noexcept
+  {
+    return m_control->head.load(std::memory_order_seq_cst) ==
+           m_control->tail.load(std::memory_order_relaxed);
+  }
+
+  /** \brief get the size of the next record
+   *  \return record size, or nullopt if the ring is empty
+   *  \throw std::length_error the ring positions or the record size are inconsistent
+   *
+   *  The control area and the record header are writable by the peer, so they are validated
+   *  before use: the ring cannot hold more than its capacity, and a record cannot be larger
+   *  than the ring content or MAX_NDN_PACKET_SIZE. A returned size is safe to pass to pop().
+   */
+  optional<size_t>
+  peekSize() const
+  {
+    uint64_t head = m_control->head.load(std::memory_order_acquire);
+    uint64_t tail = m_control->tail.load(std::memory_order_relaxed);
+    if (head == tail) {
+      return nullopt;
+    }
+
+    uint64_t used = head - tail;
+    if (used > m_capacity) {
+      NDN_THROW(std::length_error("ring content exceeds ring capacity"));
+    }
+
+    RecordSize size = 0;
+    if (used < sizeof(size)) {
+      NDN_THROW(std::length_error("truncated record header in ring"));
+    }
+    copyOut(tail, reinterpret_cast<uint8_t*>(&size), sizeof(size));
+    if (size > used - sizeof(size)) {
+      NDN_THROW(std::length_error("record size exceeds ring content"));
+    }
+    if (size > MAX_NDN_PACKET_SIZE) {
+      NDN_THROW(std::length_error("record size exceeds maximum packet size"));
+    }
+    return size;
+  }
+
+  /** \brief copy the next record into \p buf and release its space
+   *  \pre peekSize() returned a value equal to \p size
+   */
+  void
+  pop(uint8_t* buf, size_t size) noexcept
+  {
+    uint64_t tail = m_control->tail.load(std::memory_order_relaxed);
+    copyOut(tail + sizeof(RecordSize), buf, size);
+    m_control->tail.store(tail + sizeof(RecordSize) + size, std::memory_order_seq_cst);
+  }
+
+private:
+  void
+  copyIn(uint64_t pos, const uint8_t* buf, size_t size) noexcept
+  {
+    if (size == 0) {
+      return;
+    }
+    size_t offset = static_cast<size_t>(pos & (m_capacity - 1));
+    size_t first = std::min(size, m_capacity - offset);
+    std::memcpy(m_data + offset, buf, first);
+    std::memcpy(m_data, buf + first, size - first);
+  }
+
+  void
+  copyOut(uint64_t pos, uint8_t* buf, size_t size) const noexcept
+  {
+    size_t offset = static_cast<size_t>(pos & (m_capacity - 1));
+    size_t first = std::min(size, m_capacity - offset);
+    std::memcpy(buf, m_data + offset, first);
+    std::memcpy(buf + first, m_data, size - first);
+  }
+
+private:
+  Control* m_control;
+  uint8_t* m_data;
+  size_t m_capacity;
+};
+
+} // namespace detail
+} // namespace ndn
+
+#endif // NDN_TRANSPORT_DETAIL_SHM_RING_HPP
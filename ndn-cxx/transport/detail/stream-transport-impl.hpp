@@ -23,6 +23,11 @@
 #define NDN_TRANSPORT_DETAIL_STREAM_TRANSPORT_IMPL_HPP
 
 #include "ndn-cxx/transport/transport.hpp"
+#include "ndn-cxx/encoding/stream-decoder.hpp"
+
+#ifdef NDN_CXX_HAVE_IO_URING
+#include "ndn-cxx/transport/detail/uring-stream.hpp"
+#endif // NDN_CXX_HAVE_IO_URING
 
 #include <boost/asio/steady_timer.hpp>
 #include <boost/asio/write.hpp>
@@ -47,8 +52,8 @@ public:
 
   StreamTransportImpl(BaseTransport& transport, boost::asio::io_service& ioService)
     : m_transport(transport)
+    , m_ioService(ioService)
     , m_socket(ioService)
-    , m_inputBufferSize(0)
     , m_isConnecting(false)
     , m_connectTimer(ioService)
   {
@@ -81,6 +86,12 @@ public:
 
     boost::system::error_code error; // to silently ignore all errors
     m_connectTimer.cancel(error);
+#ifdef NDN_CXX_HAVE_IO_URING
+    if (m_uring != nullptr) {
+      m_uring->close();
+      m_uring.reset();
+    }
+#endif // NDN_CXX_HAVE_IO_URING
     m_socket.cancel(error);
     m_socket.close(error);
 
@@ -97,6 +108,12 @@ public:
 
     if (m_transport.m_isReceiving) {
       m_transport.m_isReceiving = false;
+#ifdef NDN_CXX_HAVE_IO_URING
+      if (m_uring != nullptr) {
+        m_uring->stopReceive();
+        return;
+      }
+#endif // NDN_CXX_HAVE_IO_URING
       m_socket.cancel();
     }
   }
@@ -109,7 +126,7 @@ public:
 
     if (!m_transport.m_isReceiving) {
       m_transport.m_isReceiving = true;
-      m_inputBufferSize = 0;
+      m_decoder.reset();
       asyncReceive();
     }
   }
@@ -131,6 +148,29 @@ public:
     send(std::move(sequence));
   }
 
+  void
+  sendBatch(const std::vector<Transport::Packet>& packets)
+  {
+    // a write gathers from at most this many blocks, so that it stays within the iovec
+    // limit of a single system call
+    const size_t maxBlocksPerWrite = 256;
+
+    BlockSequence sequence;
+    for (const auto& packet : packets) {
+      if (sequence.size() + 2 > maxBlocksPerWrite) {
+        send(std::move(sequence));
+        sequence.clear();
+      }
+      if (packet.header.isValid()) {
+        sequence.push_back(packet.header);
+      }
+      sequence.push_back(packet.wire);
+    }
+    if (!sequence.empty()) {
+      send(std::move(sequence));
+    }
+  }
+
 protected:
   void
   connectHandler(const boost::system::error_code& error)
@@ -140,6 +180,11 @@ protected:
 
     if (!error) {
       m_transport.m_isConnected = true;
+#ifdef NDN_CXX_HAVE_IO_URING
+      if (UringStream::isRequested()) {
+        startUring();
+      }
+#endif // NDN_CXX_HAVE_IO_URING
 
       if (!m_transmissionQueue.empty()) {
         resume();
@@ -163,10 +208,50 @@ protected:
     NDN_THROW(Transport::Error(error, "error while connecting to the forwarder"));
   }
 
+#ifdef NDN_CXX_HAVE_IO_URING
+  /** \brief switch the connected socket to the io_uring backend
+   *
+   *  The asio-based implementation remains in use if io_uring is unavailable.
+   */
+  void
+  startUring()
+  {
+    try {
+      m_uring = UringStream::create(m_ioService, m_socket.native_handle());
+    }
+    catch (const UringStream::Error&) {
+      return;
+    }
+
+    std::weak_ptr<Impl> weakSelf = this->shared_from_this();
+    m_uring->start(
+      [weakSelf] (const uint8_t* buf, size_t size) {
+        auto self = weakSelf.lock();
+        if (self != nullptr) {
+          self->processReceived(buf, size);
+        }
+      },
+      [weakSelf] (const boost::system::error_code& error, const std::string& msg) {
+        auto self = weakSelf.lock();
+        if (self != nullptr) {
+          self->m_transport.close();
+          NDN_THROW(Transport::Error(error, msg));
+        }
+      });
+  }
+#endif // NDN_CXX_HAVE_IO_URING
+
   void
   send(BlockSequence&& sequence)
   {
-    m_transmissionQueue.emplace_back(sequence);
+    m_transmissionQueue.emplace_back(std::move(sequence));
+
+#ifdef NDN_CXX_HAVE_IO_URING
+    if (m_uring != nullptr) {
+      asyncWrite();
+      return;
+    }
+#endif // NDN_CXX_HAVE_IO_URING
 
     if (m_transport.m_isConnected && m_transmissionQueue.size() == 1) {
       asyncWrite();
@@ -180,6 +265,16 @@ protected:
   asyncWrite()
   {
     BOOST_ASSERT(!m_transmissionQueue.empty());
+#ifdef NDN_CXX_HAVE_IO_URING
+    if (m_uring != nullptr) {
+      // the backend keeps its own queue, and orders sequences itself
+      for (auto& sequence : m_transmissionQueue) {
+        m_uring->send(std::move(sequence));
+      }
+      m_transmissionQueue.clear();
+      return;
+    }
+#endif // NDN_CXX_HAVE_IO_URING
     boost::asio::async_write(m_socket, m_transmissionQueue.front(),
       bind(&Impl::handleAsyncWrite, this->shared_from_this(), _1, m_transmissionQueue.begin()));
   }
@@ -211,8 +306,13 @@ protected:
   void
   asyncReceive()
   {
-    m_socket.async_receive(boost::asio::buffer(m_inputBuffer + m_inputBufferSize,
-                                               MAX_NDN_PACKET_SIZE - m_inputBufferSize), 0,
+#ifdef NDN_CXX_HAVE_IO_URING
+    if (m_uring != nullptr) {
+      m_uring->startReceive();
+      return;
+    }
+#endif // NDN_CXX_HAVE_IO_URING
+    m_socket.async_receive(boost::asio::buffer(m_inputBuffer, MAX_NDN_PACKET_SIZE), 0,
                            bind(&Impl::handleAsyncReceive, this->shared_from_this(), _1, _2));
   }
 
@@ -229,57 +329,43 @@ protected:
       NDN_THROW(Transport::Error(error, "error while receiving data from socket"));
     }
 
-    m_inputBufferSize += nBytesRecvd;
-    // do magic
-
-    std::size_t offset = 0;
-    bool hasProcessedSome = processAllReceived(m_inputBuffer, offset, m_inputBufferSize);
-    if (!hasProcessedSome && m_inputBufferSize == MAX_NDN_PACKET_SIZE && offset == 0) {
-      m_transport.close();
-      NDN_THROW(Transport::Error(boost::system::error_code(),
-                                 "input buffer full, but a valid TLV cannot be decoded"));
-    }
-
-    if (offset > 0) {
-      if (offset != m_inputBufferSize) {
-        std::copy(m_inputBuffer + offset, m_inputBuffer + m_inputBufferSize, m_inputBuffer);
-        m_inputBufferSize -= offset;
-      }
-      else {
-        m_inputBufferSize = 0;
-      }
-    }
-
+    processReceived(m_inputBuffer, nBytesRecvd);
     asyncReceive();
   }
 
-  bool
-  processAllReceived(uint8_t* buffer, size_t& offset, size_t nBytesAvailable)
+  void
+  processReceived(const uint8_t* buf, size_t size)
   {
-    while (offset < nBytesAvailable) {
-      bool isOk = false;
-      Block element;
-      std::tie(isOk, element) = Block::fromBuffer(buffer + offset, nBytesAvailable - offset);
-      if (!isOk)
-        return false;
-
-      m_transport.receive(element);
-      offset += element.size();
+    // partially received elements are kept by the decoder, so that the octets already received
+    // are neither moved nor parsed again when the rest of the element arrives
+    try {
+      m_decoder.decode(buf, size, [this] (const Block& element) {
+        m_transport.receive(element);
+      });
+    }
+    catch (const encoding::StreamDecoder::Error&) {
+      m_transport.close();
+      NDN_THROW_NESTED(Transport::Error(boost::system::error_code(),
+                                        "a valid TLV cannot be decoded from the input stream"));
     }
-    return true;
   }
 
 protected:
   BaseTransport& m_transport;
+  boost::asio::io_service& m_ioService;
 
   typename Protocol::socket m_socket;
   uint8_t m_inputBuffer[MAX_NDN_PACKET_SIZE];
-  size_t m_inputBufferSize;
+  encoding::StreamDecoder m_decoder;
 
   TransmissionQueue m_transmissionQueue;
   bool m_isConnecting;
 
   boost::asio::steady_timer m_connectTimer;
+
+#ifdef NDN_CXX_HAVE_IO_URING
+  shared_ptr<UringStream> m_uring;
+#endif // NDN_CXX_HAVE_IO_URING
 };
 
 } // namespace detail
@@ -0,0 +1,618 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/transport/detail/uring-stream.hpp"
+#include "ndn-cxx/util/logger.hpp"
+
+#include <boost/asio/io_service.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+NDN_LOG_INIT(ndn.UringStream);
+
+namespace ndn {
+namespace detail {
+
+const unsigned RING_ENTRIES = 128;
+const size_t MAX_GATHERED_SEQUENCES = 64;
+
+const uint16_t BUFFER_GROUP = 0;
+const uint16_t N_BUFFERS = 16;
+const size_t BUFFER_SIZE = 16384;
+
+// user_data of requests that are not sendmsg; sendmsg requests carry a SendOp pointer
+const uint64_t RECEIVE_TAG = 1;
+const uint64_t CANCEL_TAG = 2;
+const uint64_t PROVIDE_TAG = 3;
+
+/** \brief a raw io_uring instance, with its submission and completion queues mapped
+ *         and a group of receive buffers provided to the kernel
+ */
+class UringStream::Ring : noncopyable
+{
+public:
+  explicit
+  Ring(unsigned entries)
+  {
+    io_uring_params params{};
+    params.flags = IORING_SETUP_CLAMP;
+    m_fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+    if (m_fd < 0) {
+      NDN_THROW_ERRNO(Error("io_uring_setup"));
+    }
+    if ((params.features & IORING_FEAT_SINGLE_MMAP) == 0 ||
+        (params.features & IORING_FEAT_FAST_POLL) == 0) {
+      ::close(m_fd);
+      NDN_THROW(Error("io_uring lacks required features"));
+    }
+
+    m_ringSize = std::max(params.sq_off.array + params.sq_entries * sizeof(uint32_t),
+                          params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+    m_ring = ::mmap(nullptr, m_ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                    m_fd, IORING_OFF_SQ_RING);
+    m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    m_sqes = static_cast<io_uring_sqe*>(::mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE,
+                                               MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES));
+    if (m_ring == MAP_FAILED || m_sqes == MAP_FAILED) {
+      int savedErrno = errno;
+      release();
+      errno = savedErrno;
+      NDN_THROW_ERRNO(Error("Cannot map io_uring"));
+    }
+
+    auto base = static_cast<uint8_t*>(m_ring);
+    m_sqHead = reinterpret_cast<unsigned*>(base + params.sq_off.head);
+    m_sqTail = reinterpret_cast<unsigned*>(base + params.sq_off.tail);
+    m_sqMask = *reinterpret_cast<unsigned*>(base + params.sq_off.ring_mask);
+    m_sqEntries = params.sq_entries;
+    auto sqArray = reinterpret_cast<unsigned*>(base + params.sq_off.array);
+    for (unsigned i = 0; i < m_sqEntries; ++i) {
+      sqArray[i] = i;
+    }
+    m_cqHead = reinterpret_cast<unsigned*>(base + params.cq_off.head);
+    m_cqTail = reinterpret_cast<unsigned*>(base + params.cq_off.tail);
+    m_cqMask = *reinterpret_cast<unsigned*>(base + params.cq_off.ring_mask);
+    m_cqes = reinterpret_cast<io_uring_cqe*>(base + params.cq_off.cqes);
+    m_sqeTail = *m_sqTail;
+
+    m_buffers.resize(N_BUFFERS * BUFFER_SIZE);
+    provideBuffers(0, N_BUFFERS);
+  }
+
+  ~Ring()
+  {
+    release();
+  }
+
+  int
+  getFd() const
+  {
+    return m_fd;
+  }
+
+  /** \brief obtain a zeroed submission queue entry, submitting pending entries if the queue is full
+   */
+  io_uring_sqe&
+  getSqe()
+  {
+    if (m_sqeTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE) >= m_sqEntries) {
+      enter(0, 0);
+    }
+    io_uring_sqe& sqe = m_sqes[m_sqeTail & m_sqMask];
+    std::memset(&sqe, 0, sizeof(sqe));
+    ++m_sqeTail;
+    return sqe;
+  }
+
+  /** \brief submit pending entries, optionally waiting for \p minComplete completions
+   *  \return errno-style error code, 0 on success
+   */
+  int
+  enter(unsigned minComplete, unsigned flags)
+  {
+    __atomic_store_n(m_sqTail, m_sqeTail, __ATOMIC_RELEASE);
+    unsigned nToSubmit = m_sqeTail - m_sqeSubmitted;
+    int res = static_cast<int>(::syscall(__NR_io_uring_enter, m_fd, nToSubmit, minComplete,
+                                         flags | (minComplete > 0 ? IORING_ENTER_GETEVENTS : 0),
+                                         nullptr, 0));
+    if (res < 0) {
+      return errno;
+    }
+    m_sqeSubmitted += static_cast<unsigned>(res);
+    return 0;
+  }
+
+  bool
+  hasPendingSubmissions() const
+  {
+    return m_sqeTail != m_sqeSubmitted;
+  }
+
+  /** \brief pop one completion queue entry
+   *  \retval false the completion queue is empty
+   */
+  bool
+  popCqe(io_uring_cqe& cqe)
+  {
+    unsigned head = *m_cqHead;
+    if (head == __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE)) {
+      return false;
+    }
+    cqe = m_cqes[head & m_cqMask];
+    __atomic_store_n(m_cqHead, head + 1, __ATOMIC_RELEASE);
+    return true;
+  }
+
+  void
+  registerEventFd(int eventFd)
+  {
+    if (::syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_EVENTFD, &eventFd, 1) < 0) {
+      NDN_THROW_ERRNO(Error("Cannot register eventfd with io_uring"));
+    }
+  }
+
+  uint8_t*
+  getBuffer(uint16_t bufferId)
+  {
+    return m_buffers.data() + bufferId * BUFFER_SIZE;
+  }
+
+  /** \brief queue a request that returns consecutive buffers to the kernel
+   *
+   *  The request is submitted together with the next batch of requests. Since requests are
+   *  started in submission order, a recv submitted afterwards can select these buffers.
+   */
+  void
+  provideBuffers(uint16_t firstBufferId, uint16_t nBuffers)
+  {
+    io_uring_sqe& sqe = getSqe();
+    sqe.opcode = IORING_OP_PROVIDE_BUFFERS;
+    sqe.fd = nBuffers;
+    sqe.addr = reinterpret_cast<uint64_t>(getBuffer(firstBufferId));
+    sqe.len = BUFFER_SIZE;
+    sqe.off = firstBufferId;
+    sqe.buf_group = BUFFER_GROUP;
+    sqe.user_data = PROVIDE_TAG;
+  }
+
+private:
+  void
+  release()
+  {
+    if (m_fd >= 0) {
+      ::close(m_fd);
+      m_fd = -1;
+    }
+    if (m_sqes != nullptr && m_sqes != MAP_FAILED) {
+      ::munmap(m_sqes, m_sqesSize);
+    }
+    m_sqes = nullptr;
+    if (m_ring != nullptr && m_ring != MAP_FAILED) {
+      ::munmap(m_ring, m_ringSize);
+    }
+    m_ring = nullptr;
+  }
+
+private:
+  int m_fd = -1;
+  void* m_ring = nullptr;
+  size_t m_ringSize = 0;
+  io_uring_sqe* m_sqes = nullptr;
+  size_t m_sqesSize = 0;
+
+  unsigned* m_sqHead = nullptr;
+  unsigned* m_sqTail = nullptr;
+  unsigned m_sqMask = 0;
+  unsigned m_sqEntries = 0;
+  unsigned m_sqeTail = 0; ///< next entry to fill
+  unsigned m_sqeSubmitted = 0; ///< entries consumed by the kernel
+
+  unsigned* m_cqHead = nullptr;
+  unsigned* m_cqTail = nullptr;
+  unsigned m_cqMask = 0;
+  io_uring_cqe* m_cqes = nullptr;
+
+  std::vector<uint8_t> m_buffers;
+};
+
+struct UringStream::SendOp
+{
+  /** \brief skip \p size octets that have been written to the socket
+   */
+  void
+  advance(size_t size)
+  {
+    BOOST_ASSERT(size <= nRemaining);
+    nRemaining -= size;
+    while (size > 0) {
+      BOOST_ASSERT(msg.msg_iovlen > 0);
+      iovec& first = *msg.msg_iov;
+      if (size < first.iov_len) {
+        first.iov_base = static_cast<uint8_t*>(first.iov_base) + size;
+        first.iov_len -= size;
+        break;
+      }
+      size -= first.iov_len;
+      ++msg.msg_iov;
+      --msg.msg_iovlen;
+    }
+  }
+
+  std::vector<Block> blocks;
+  std::vector<iovec> iov;
+  msghdr msg;
+  size_t nRemaining;
+};
+
+bool
+UringStream::isRequested()
+{
+  const char* value = std::getenv("NDN_CLIENT_IO_URING");
+  return value != nullptr && std::strcmp(value, "1") == 0;
+}
+
+shared_ptr<UringStream>
+UringStream::create(boost::asio::io_service& ioService, int socket)
+{
+  try {
+    auto ring = make_unique<Ring>(RING_ENTRIES);
+    int eventFd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (eventFd < 0) {
+      NDN_THROW_ERRNO(Error("Cannot create eventfd"));
+    }
+    try {
+      ring->registerEventFd(eventFd);
+    }
+    catch (const Error&) {
+      ::close(eventFd);
+      throw;
+    }
+    return shared_ptr<UringStream>(new UringStream(ioService, socket, std::move(ring), eventFd));
+  }
+  catch (const Error& e) {
+    NDN_LOG_DEBUG("io_uring unavailable: " << e.what());
+    throw;
+  }
+}
+
+UringStream::UringStream(boost::asio::io_service& ioService, int socket,
+                         unique_ptr<Ring> ring, int eventFd)
+  : m_ioService(ioService)
+  , m_socket(socket)
+  , m_ring(std::move(ring))
+  , m_eventFd(ioService, eventFd)
+{
+}
+
+UringStream::~UringStream()
+{
+  close();
+}
+
+void
+UringStream::start(const ReceiveCallback& onReceive, const ErrorCallback& onError)
+{
+  BOOST_ASSERT(onReceive != nullptr && onError != nullptr);
+  m_onReceive = onReceive;
+  m_onError = onError;
+  m_isOpen = true;
+  asyncWaitCompletion();
+}
+
+void
+UringStream::startReceive()
+{
+  m_wantReceive = true;
+  if (m_isOpen && !m_isReceiveArmed) {
+    armReceive();
+  }
+}
+
+void
+UringStream::stopReceive()
+{
+  m_wantReceive = false;
+  if (m_isOpen && m_isReceiveArmed && !m_isCancelPending) {
+    io_uring_sqe& sqe = m_ring->getSqe();
+    sqe.opcode = IORING_OP_ASYNC_CANCEL;
+    sqe.addr = RECEIVE_TAG;
+    sqe.user_data = CANCEL_TAG;
+    m_isCancelPending = true;
+    scheduleSubmit();
+  }
+}
+
+void
+UringStream::send(BlockSequence&& sequence)
+{
+  m_sendQueue.push_back(std::move(sequence));
+  scheduleSubmit();
+}
+
+void
+UringStream::close()
+{
+  if (!m_isOpen) {
+    return;
+  }
+  m_isOpen = false;
+  m_wantReceive = false;
+  m_sendQueue.clear();
+
+  // cancel outstanding requests, then wait until the kernel no longer references their memory
+  size_t nOutstanding = (m_sendOp != nullptr ? 1 : 0) + (m_isReceiveArmed ? 1 : 0);
+  auto cancel = [this] (uint64_t userData) {
+    io_uring_sqe& sqe = m_ring->getSqe();
+    sqe.opcode = IORING_OP_ASYNC_CANCEL;
+    sqe.addr = userData;
+    sqe.user_data = CANCEL_TAG;
+  };
+  if (m_isReceiveArmed) {
+    cancel(RECEIVE_TAG);
+  }
+  if (m_sendOp != nullptr) {
+    cancel(reinterpret_cast<uint64_t>(m_sendOp.get()));
+  }
+
+  while (nOutstanding > 0) {
+    int error = m_ring->enter(1, 0);
+    if (error != 0 && error != EINTR && error != EAGAIN && error != EBUSY) {
+      NDN_LOG_ERROR("io_uring_enter failed while closing: " << std::strerror(error));
+      break;
+    }
+
+    io_uring_cqe cqe;
+    while (m_ring->popCqe(cqe)) {
+      if (cqe.user_data == RECEIVE_TAG) {
+        if ((cqe.flags & IORING_CQE_F_MORE) == 0) {
+          m_isReceiveArmed = false;
+          --nOutstanding;
+        }
+      }
+      else if (cqe.user_data != CANCEL_TAG && cqe.user_data != PROVIDE_TAG) {
+        --nOutstanding;
+      }
+    }
+  }
+  m_sendOp.reset();
+
+  boost::system::error_code error; // to silently ignore all errors
+  m_eventFd.cancel(error);
+}
+
+void
+UringStream::asyncWaitCompletion()
+{
+  m_eventFd.async_read_some(boost::asio::buffer(&m_eventFdValue, sizeof(m_eventFdValue)),
+    [self = shared_from_this()] (const boost::system::error_code& error, size_t) {
+      if (!self->m_isOpen || error == boost::asio::error::operation_aborted) {
+        return;
+      }
+      if (error) {
+        self->m_onError(error, "error while waiting for io_uring completions");
+        return;
+      }
+
+      self->processCompletions();
+      if (self->m_isOpen) {
+        self->asyncWaitCompletion();
+      }
+    });
+}
+
+void
+UringStream::processCompletions()
+{
+  io_uring_cqe cqe;
+  while (m_isOpen && m_ring->popCqe(cqe)) {
+    if (cqe.user_data == RECEIVE_TAG) {
+      handleReceive(cqe.res, cqe.flags);
+    }
+    else if (cqe.user_data == CANCEL_TAG) {
+      m_isCancelPending = false;
+    }
+    else if (cqe.user_data == PROVIDE_TAG) {
+      if (cqe.res < 0) {
+        NDN_LOG_ERROR("cannot provide receive buffers: " << std::strerror(-cqe.res));
+      }
+    }
+    else {
+      handleSend(reinterpret_cast<SendOp*>(cqe.user_data), cqe.res);
+    }
+  }
+
+  if (m_isOpen && !m_isReceiveArmed && m_wantReceive) {
+    armReceive();
+  }
+}
+
+void
+UringStream::handleReceive(int32_t result, uint32_t flags)
+{
+  if ((flags & IORING_CQE_F_MORE) == 0) {
+    m_isReceiveArmed = false;
+  }
+
+  if (result > 0) {
+    BOOST_ASSERT((flags & IORING_CQE_F_BUFFER) != 0);
+    auto bufferId = static_cast<uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT);
+    // the callback copies what it needs, so the buffer can be returned right away
+    m_onReceive(m_ring->getBuffer(bufferId), static_cast<size_t>(result));
+    if (m_isOpen) {
+      m_ring->provideBuffers(bufferId, 1);
+      scheduleSubmit();
+    }
+    return;
+  }
+
+  switch (-result) {
+    case 0:
+      m_onError(boost::asio::error::eof, "error while receiving data from socket");
+      return;
+    case ENOBUFS: // all buffers are awaiting return to the kernel
+    case ECANCELED:
+      // re-armed in processCompletions() if still wanted
+      return;
+    case EINVAL:
+      if (m_isMultishot) {
+        NDN_LOG_DEBUG("multishot recv not supported, falling back to single-shot recv");
+        m_isMultishot = false;
+        return;
+      }
+      NDN_CXX_FALLTHROUGH;
+    default:
+      m_onError(boost::system::error_code(-result, boost::system::system_category()),
+                "error while receiving data from socket");
+      return;
+  }
+}
+
+void
+UringStream::handleSend(SendOp* op, int32_t result)
+{
+  BOOST_ASSERT(op == m_sendOp.get());
+  if (result <= 0) {
+    // a zero-octet write of a non-empty message means the socket cannot make progress
+    int error = result < 0 ? -result : EPIPE;
+    m_onError(boost::system::error_code(error, boost::system::system_category()),
+              "error while sending data to socket");
+    return;
+  }
+
+  op->advance(static_cast<size_t>(result));
+  if (op->nRemaining > 0) {
+    // short write: MSG_WAITALL is only honored by kernel 5.18 and later
+    ++m_nShortWrites;
+    prepareSend(*op);
+  }
+  else {
+    m_sendOp.reset();
+  }
+
+  if (m_sendOp != nullptr || !m_sendQueue.empty()) {
+    scheduleSubmit();
+  }
+}
+
+void
+UringStream::armReceive()
+{
+  io_uring_sqe& sqe = m_ring->getSqe();
+  sqe.opcode = IORING_OP_RECV;
+  sqe.fd = m_socket;
+  sqe.flags = IOSQE_BUFFER_SELECT;
+  sqe.buf_group = BUFFER_GROUP;
+  sqe.ioprio = m_isMultishot ? IORING_RECV_MULTISHOT : 0;
+  sqe.user_data = RECEIVE_TAG;
+  m_isReceiveArmed = true;
+  scheduleSubmit();
+}
+
+void
+UringStream::scheduleSubmit()
+{
+  if (m_isSubmitScheduled) {
+    return;
+  }
+  m_isSubmitScheduled = true;
+  // defer submission, so that all sequences sent from the current handler form one chain
+  m_ioService.post([self = shared_from_this()] {
+    self->m_isSubmitScheduled = false;
+    if (self->m_isOpen) {
+      self->submit();
+    }
+  });
+}
+
+void
+UringStream::prepareSend(SendOp& op)
+{
+  io_uring_sqe& sqe = m_ring->getSqe();
+  sqe.opcode = IORING_OP_SENDMSG;
+  sqe.fd = m_socket;
+  sqe.addr = reinterpret_cast<uint64_t>(&op.msg);
+  sqe.msg_flags = m_sendFlags;
+  sqe.user_data = reinterpret_cast<uint64_t>(&op);
+}
+
+void
+UringStream::submit()
+{
+  // a single sendmsg is in flight at a time, so that octets cannot be reordered
+  if (m_sendOp == nullptr && !m_sendQueue.empty()) {
+    m_sendOp = make_unique<SendOp>();
+    SendOp& op = *m_sendOp;
+    op.nRemaining = 0;
+    for (size_t i = 0; i < MAX_GATHERED_SEQUENCES && !m_sendQueue.empty(); ++i) {
+      BlockSequence& sequence = m_sendQueue.front();
+      if (i > 0 && op.blocks.size() + sequence.size() > IOV_MAX) {
+        break;
+      }
+      for (Block& block : sequence) {
+        op.nRemaining += block.size();
+        op.blocks.push_back(std::move(block));
+      }
+      m_sendQueue.pop_front();
+    }
+
+    op.iov.reserve(op.blocks.size());
+    for (const Block& block : op.blocks) {
+      op.iov.push_back({const_cast<uint8_t*>(block.wire()), block.size()});
+    }
+    op.msg = {};
+    op.msg.msg_iov = op.iov.data();
+    op.msg.msg_iovlen = op.iov.size();
+    if (op.nRemaining > 0) {
+      prepareSend(op);
+    }
+    else {
+      m_sendOp.reset();
+      if (!m_sendQueue.empty()) {
+        scheduleSubmit();
+      }
+    }
+  }
+
+  if (!m_ring->hasPendingSubmissions()) {
+    return;
+  }
+
+  int error = m_ring->enter(0, 0);
+  if (error == EINTR || error == EAGAIN || error == EBUSY) {
+    scheduleSubmit();
+  }
+  else if (error != 0) {
+    m_onError(boost::system::error_code(error, boost::system::system_category()),
+              "error while submitting io_uring requests");
+  }
+}
+
+} // namespace detail
+} // namespace ndn
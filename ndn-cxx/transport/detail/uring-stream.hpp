@@ -0,0 +1,184 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_TRANSPORT_DETAIL_URING_STREAM_HPP
+#define NDN_TRANSPORT_DETAIL_URING_STREAM_HPP
+
+#include "ndn-cxx/detail/asio-fwd.hpp"
+#include "ndn-cxx/encoding/block.hpp"
+
+#ifndef NDN_CXX_HAVE_IO_URING
+#error "This file should not be included ..."
+#endif
+
+#include <boost/asio/posix/stream_descriptor.hpp>
+
+#include <deque>
+#include <list>
+
+#include <sys/socket.h>
+
+namespace ndn {
+namespace detail {
+
+/** \brief Performs I/O on a connected stream socket through io_uring.
+ *
+ *  Incoming octets are received with a single multishot recv request into a group of buffers
+ *  provided to the kernel in advance (IORING_OP_PROVIDE_BUFFERS), so that an armed receive
+ *  delivers any number of chunks without being resubmitted. Outgoing block sequences that
+ *  accumulate during one io_service handler are gathered, without copying, into a single sendmsg
+ *  request. Only one sendmsg is in flight at a time; after a short write, the remaining octets
+ *  are resubmitted.
+ *
+ *  Completions are signaled through an eventfd registered with the ring, which the io_service
+ *  watches, so that this backend runs on the same thread as the rest of the transport.
+ */
+class UringStream : public std::enable_shared_from_this<UringStream>, noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  using BlockSequence = std::list<Block>;
+  using ReceiveCallback = function<void(const uint8_t* buf, size_t size)>;
+  using ErrorCallback = function<void(const boost::system::error_code& error, const std::string& msg)>;
+
+  /** \brief determine whether the application has opted in to the io_uring backend
+   *
+   *  The backend is requested by setting the environment variable NDN_CLIENT_IO_URING to 1.
+   */
+  static bool
+  isRequested();
+
+  /** \brief create an io_uring instance for \p socket
+   *  \param socket connected stream socket, which remains owned by the caller
+   *  \throw Error io_uring or a required feature is unavailable
+   */
+  static shared_ptr<UringStream>
+  create(boost::asio::io_service& ioService, int socket);
+
+  ~UringStream();
+
+  /** \brief start processing completions
+   *
+   *  \p onError is invoked when the stream can no longer be used; it may throw.
+   */
+  void
+  start(const ReceiveCallback& onReceive, const ErrorCallback& onError);
+
+  void
+  startReceive();
+
+  /** \brief stop receiving
+   *
+   *  Octets that were already received by the kernel may still be delivered.
+   */
+  void
+  stopReceive();
+
+  /** \brief send a sequence of blocks back to back
+   *
+   *  Sequences are written to the socket in the order in which they are passed.
+   */
+  void
+  send(BlockSequence&& sequence);
+
+  /** \brief cancel all requests and wait for them to complete
+   *  \post no request references the socket or any block passed to send()
+   */
+  void
+  close();
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  bool
+  isReceiveArmed() const
+  {
+    return m_isReceiveArmed;
+  }
+
+  bool
+  isSending() const
+  {
+    return m_sendOp != nullptr;
+  }
+
+private:
+  class Ring;
+  struct SendOp;
+
+  UringStream(boost::asio::io_service& ioService, int socket, unique_ptr<Ring> ring, int eventFd);
+
+  void
+  asyncWaitCompletion();
+
+  void
+  processCompletions();
+
+  void
+  handleReceive(int32_t result, uint32_t flags);
+
+  void
+  handleSend(SendOp* op, int32_t result);
+
+  void
+  prepareSend(SendOp& op);
+
+  void
+  armReceive();
+
+  void
+  scheduleSubmit();
+
+  void
+  submit();
+
+private:
+  boost::asio::io_service& m_ioService;
+  int m_socket;
+  unique_ptr<Ring> m_ring;
+  boost::asio::posix::stream_descriptor m_eventFd;
+  uint64_t m_eventFdValue = 0;
+
+  ReceiveCallback m_onReceive;
+  ErrorCallback m_onError;
+  bool m_isOpen = false;
+
+  bool m_wantReceive = false;
+  bool m_isReceiveArmed = false;
+  bool m_isCancelPending = false;
+  bool m_isMultishot = true;
+
+  std::deque<BlockSequence> m_sendQueue;
+  unique_ptr<SendOp> m_sendOp; ///< the sendmsg request being executed
+  bool m_isSubmitScheduled = false;
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  int m_sendFlags = MSG_WAITALL | MSG_NOSIGNAL;
+  size_t m_nShortWrites = 0;
+};
+
+} // namespace detail
+} // namespace ndn
+
+#endif // NDN_TRANSPORT_DETAIL_URING_STREAM_HPP
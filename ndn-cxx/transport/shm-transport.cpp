@@ -0,0 +1,314 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/transport/shm-transport.hpp"
+#include "ndn-cxx/net/face-uri.hpp"
+#include "ndn-cxx/util/logger.hpp"
+
+#ifdef NDN_CXX_HAVE_MEMFD
+#include "ndn-cxx/transport/detail/shm-channel.hpp"
+
+#include <boost/asio/local/stream_protocol.hpp>
+#endif // NDN_CXX_HAVE_MEMFD
+
+NDN_LOG_INIT(ndn.ShmTransport);
+// DEBUG level: connect, close, pause, resume.
+
+namespace ndn {
+
+#ifdef NDN_CXX_HAVE_MEMFD
+
+class ShmTransport::Impl : public std::enable_shared_from_this<ShmTransport::Impl>
+{
+public:
+  Impl(ShmTransport& transport, boost::asio::io_service& ioService)
+    : m_transport(transport)
+    , m_ioService(ioService)
+    , m_socket(ioService)
+  {
+  }
+
+  void
+  connect(const std::string& controlSocket)
+  {
+    if (m_transport.m_isConnected) {
+      return;
+    }
+
+    // keep this object alive if the transport is closed below
+    auto self = this->shared_from_this();
+
+    boost::system::error_code error;
+    m_socket.connect(boost::asio::local::stream_protocol::endpoint(controlSocket), error);
+    if (error) {
+      m_transport.close();
+      NDN_THROW(Transport::Error(error, "error while connecting to the forwarder"));
+    }
+
+    try {
+      m_channel = detail::ShmChannel::create(m_ioService);
+      m_channel->sendFds(m_socket.native_handle());
+    }
+    catch (const detail::ShmChannel::Error&) {
+      m_transport.close();
+      NDN_THROW_NESTED(Transport::Error(boost::system::error_code(),
+                                        "error while setting up shared memory with the forwarder"));
+    }
+
+    ShmTransport& transport = m_transport;
+    m_channel->start([&transport] (const Block& wire) { transport.receive(wire); },
+                     [&transport] (const std::string& reason) {
+                       transport.close();
+                       NDN_THROW(Transport::Error(boost::system::error_code(), reason));
+                     });
+    m_transport.m_isConnected = true;
+    asyncWatchSocket();
+  }
+
+  void
+  close()
+  {
+    if (m_channel != nullptr) {
+      m_channel->close();
+      m_channel.reset();
+    }
+
+    boost::system::error_code error; // to silently ignore all errors
+    m_socket.cancel(error);
+    m_socket.close(error);
+
+    m_transport.m_isConnected = false;
+    m_transport.m_isReceiving = false;
+  }
+
+  void
+  pause()
+  {
+    if (m_transport.m_isReceiving) {
+      m_transport.m_isReceiving = false;
+      m_channel->setReceiving(false);
+    }
+  }
+
+  void
+  resume()
+  {
+    if (!m_transport.m_isReceiving) {
+      m_transport.m_isReceiving = true;
+      m_channel->setReceiving(true);
+    }
+  }
+
+  void
+  send(const Block& header, const Block& payload)
+  {
+    BOOST_ASSERT(m_channel != nullptr);
+    try {
+      m_channel->send(header, payload);
+    }
+    catch (const detail::ShmChannel::Error&) {
+      NDN_THROW_NESTED(Transport::Error(boost::system::error_code(), "cannot send packet"));
+    }
+  }
+
+private:
+  /** \brief watch the control socket, which is closed when the forwarder goes away
+   */
+  void
+  asyncWatchSocket()
+  {
+    m_socket.async_read_some(boost::asio::buffer(m_socketBuffer),
+      [self = this->shared_from_this()] (const boost::system::error_code& error, size_t) {
+        self->handleSocketRead(error);
+      });
+  }
+
+  void
+  handleSocketRead(const boost::system::error_code& error)
+  {
+    if (error == boost::asio::error::operation_aborted) {
+      return;
+    }
+
+    if (!error) {
+      // the forwarder is not expected to send anything on the control socket, ignore it
+      asyncWatchSocket();
+      return;
+    }
+
+    m_transport.close();
+    NDN_THROW(Transport::Error(error, "connection to the forwarder was closed"));
+  }
+
+private:
+  ShmTransport& m_transport;
+  boost::asio::io_service& m_ioService;
+  boost::asio::local::stream_protocol::socket m_socket;
+  uint8_t m_socketBuffer[16];
+  shared_ptr<detail::ShmChannel> m_channel;
+};
+
+#else
+
+class ShmTransport::Impl
+{
+};
+
+#endif // NDN_CXX_HAVE_MEMFD
+
+ShmTransport::ShmTransport(const std::string& controlSocket)
+  : m_controlSocket(controlSocket)
+{
+}
+
+ShmTransport::~ShmTransport() = default;
+
+std::string
+ShmTransport::getSocketNameFromUri(const std::string& uriString)
+{
+  // Assume the default nfd-shm.sock location.
+  std::string path = "/var/run/nfd-shm.sock";
+
+  if (uriString.empty()) {
+    return path;
+  }
+
+  try {
+    const FaceUri uri(uriString);
+
+    if (uri.getScheme() != "shm") {
+      NDN_THROW(Error("Cannot create ShmTransport from \"" + uri.getScheme() + "\" URI"));
+    }
+
+    if (!uri.getPath().empty()) {
+      path = uri.getPath();
+    }
+  }
+  catch (const FaceUri::Error& error) {
+    NDN_THROW_NESTED(Error(error.what()));
+  }
+
+  return path;
+}
+
+shared_ptr<ShmTransport>
+ShmTransport::create(const std::string& uri)
+{
+#ifdef NDN_CXX_HAVE_MEMFD
+  return make_shared<ShmTransport>(getSocketNameFromUri(uri));
+#else
+  NDN_THROW(Error("ShmTransport is not supported on this platform"));
+#endif // NDN_CXX_HAVE_MEMFD
+}
+
+#ifdef NDN_CXX_HAVE_MEMFD
+
+void
+ShmTransport::connect(boost::asio::io_service& ioService,
+                      const ReceiveCallback& receiveCallback)
+{
+  NDN_LOG_DEBUG("connect path=" << m_controlSocket);
+
+  if (m_impl == nullptr) {
+    Transport::connect(ioService, receiveCallback);
+
+    m_impl = make_shared<Impl>(ref(*this), ref(ioService));
+  }
+
+  m_impl->connect(m_controlSocket);
+}
+
+void
+ShmTransport::send(const Block& wire)
+{
+  BOOST_ASSERT(m_impl != nullptr);
+  m_impl->send(wire, Block());
+}
+
+void
+ShmTransport::send(const Block& header, const Block& payload)
+{
+  BOOST_ASSERT(m_impl != nullptr);
+  m_impl->send(header, payload);
+}
+
+void
+ShmTransport::close()
+{
+  BOOST_ASSERT(m_impl != nullptr);
+  NDN_LOG_DEBUG("close");
+  m_impl->close();
+  m_impl.reset();
+}
+
+void
+ShmTransport::pause()
+{
+  if (m_impl != nullptr && m_isConnected) {
+    NDN_LOG_DEBUG("pause");
+    m_impl->pause();
+  }
+}
+
+void
+ShmTransport::resume()
+{
+  BOOST_ASSERT(m_impl != nullptr);
+  NDN_LOG_DEBUG("resume");
+  m_impl->resume();
+}
+
+#else
+
+void
+ShmTransport::connect(boost::asio::io_service&, const ReceiveCallback&)
+{
+  NDN_THROW(Error("ShmTransport is not supported on this platform"));
+}
+
+void
+ShmTransport::send(const Block&)
+{
+}
+
+void
+ShmTransport::send(const Block&, const Block&)
+{
+}
+
+void
+ShmTransport::close()
+{
+}
+
+void
+ShmTransport::pause()
+{
+}
+
+void
+ShmTransport::resume()
+{
+}
+
+#endif // NDN_CXX_HAVE_MEMFD
+
+} // namespace ndn
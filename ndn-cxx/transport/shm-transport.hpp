@@ -0,0 +1,89 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_TRANSPORT_SHM_TRANSPORT_HPP
+#define NDN_TRANSPORT_SHM_TRANSPORT_HPP
+
+#include "ndn-cxx/transport/transport.hpp"
+
+namespace ndn {
+
+/** \brief a transport using shared memory rings toward a forwarder on the same host
+ *
+ *  Packets are exchanged through a pair of lock-free single-producer single-consumer rings in
+ *  a memfd, with eventfd doorbells to wake up a sleeping side, so that a packet costs neither a
+ *  socket copy nor, under load, a wake-up. The memfd and eventfds are handed to the forwarder
+ *  over a Unix stream socket, which stays open afterwards to detect when either side goes away.
+ *
+ *  This transport is available only on platforms that support memfd_create and eventfd.
+ */
+class ShmTransport : public Transport
+{
+public:
+  explicit
+  ShmTransport(const std::string& controlSocket);
+
+  ~ShmTransport() override;
+
+  /** \copydoc Transport::connect
+   *
+   *  The shared memory is set up synchronously; the connection is established on return.
+   */
+  void
+  connect(boost::asio::io_service& ioService,
+          const ReceiveCallback& receiveCallback) override;
+
+  void
+  close() override;
+
+  void
+  pause() override;
+
+  void
+  resume() override;
+
+  void
+  send(const Block& wire) override;
+
+  void
+  send(const Block& header, const Block& payload) override;
+
+  /** \brief Create transport with parameters defined in URI
+   *  \throw Transport::Error incorrect URI or unsupported protocol is specified,
+   *                          or this platform does not support ShmTransport
+   */
+  static shared_ptr<ShmTransport>
+  create(const std::string& uri);
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  static std::string
+  getSocketNameFromUri(const std::string& uri);
+
+private:
+  std::string m_controlSocket;
+
+  class Impl;
+  shared_ptr<Impl> m_impl;
+};
+
+} // namespace ndn
+
+#endif // NDN_TRANSPORT_SHM_TRANSPORT_HPP
@@ -107,6 +107,13 @@ TcpTransport::send(const Block& header, const Block& payload)
   m_impl->send(header, payload);
 }
 
+void
+TcpTransport::sendBatch(const std::vector<Packet>& packets)
+{
+  BOOST_ASSERT(m_impl != nullptr);
+  m_impl->sendBatch(packets);
+}
+
 void
 TcpTransport::close()
 {
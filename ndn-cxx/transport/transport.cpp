@@ -45,4 +45,17 @@ Transport::connect(boost::asio::io_service& ioService,
   m_receiveCallback = receiveCallback;
 }
 
+void
+Transport::sendBatch(const std::vector<Packet>& packets)
+{
+  for (const auto& packet : packets) {
+    if (packet.header.isValid()) {
+      send(packet.header, packet.wire);
+    }
+    else {
+      send(packet.wire);
+    }
+  }
+}
+
 } // namespace ndn
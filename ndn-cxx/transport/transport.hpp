@@ -43,6 +43,14 @@ public:
     Error(const boost::system::error_code& code, const std::string& msg);
   };
 
+  /** \brief a network packet, optionally preceded by an NDNLP header that encloses it
+   */
+  struct Packet
+  {
+    Block header; ///< NDNLP header, or an invalid Block if the packet is not wrapped
+    Block wire;
+  };
+
   typedef function<void(const Block& wire)> ReceiveCallback;
   typedef function<void()> ErrorCallback;
 
@@ -77,6 +85,14 @@ public:
   virtual void
   send(const Block& header, const Block& payload) = 0;
 
+  /** \brief send several packets through the transport, in order
+   *
+   *  The default implementation sends each packet separately. Stream-oriented transports
+   *  override it to write the whole batch with one gather write.
+   */
+  virtual void
+  sendBatch(const std::vector<Packet>& packets);
+
   /** \brief pause the transport
    *  \post receiveCallback will not be invoked
    *  \note This operation has no effect if transport has been paused,
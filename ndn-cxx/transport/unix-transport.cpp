@@ -101,6 +101,13 @@ UnixTransport::send(const Block& header, const Block& payload)
   m_impl->send(header, payload);
 }
 
+void
+UnixTransport::sendBatch(const std::vector<Packet>& packets)
+{
+  BOOST_ASSERT(m_impl != nullptr);
+  m_impl->sendBatch(packets);
+}
+
 void
 UnixTransport::close()
 {
@@ -65,6 +65,9 @@ public:
   void
   send(const Block& header, const Block& payload) override;
 
+  void
+  sendBatch(const std::vector<Packet>& packets) override;
+
   /** \brief Create transport with parameters defined in URI
    *  \throw Transport::Error incorrect URI or unsupported protocol is specified
    */
@@ -0,0 +1,305 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_COROUTINE_HPP
+#define NDN_UTIL_COROUTINE_HPP
+
+#include "ndn-cxx/face.hpp"
+#include "ndn-cxx/util/exception.hpp"
+#include "ndn-cxx/util/segment-fetcher.hpp"
+
+// The awaitables below are only available to applications compiled as C++20. Such applications
+// must still use the same ndn::optional implementation as the library itself, see backports.hpp.
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L && __has_include(<coroutine>)
+#define NDN_CXX_HAVE_COROUTINES 1
+#endif
+
+#ifdef NDN_CXX_HAVE_COROUTINES
+
+#include <coroutine>
+#include <deque>
+
+namespace ndn {
+namespace util {
+
+/** \brief outcome of an Interest awaited with express()
+ */
+struct ExpressResult
+{
+  enum Status {
+    DATA,
+    NACK,
+    TIMEOUT,
+    CANCELED, ///< dropped by Face::removeAllPendingInterests() or Face::shutdown()
+  };
+
+  Status status = TIMEOUT;
+  optional<Data> data;
+  optional<lp::Nack> nack;
+};
+
+/** \brief awaitable that expresses an Interest and resumes the awaiting coroutine with its outcome
+ *
+ *  The awaiter itself is registered as the InterestContinuation of the PIT record, so that neither
+ *  the coroutine handle nor the outcome handlers require a heap allocation.
+ *  The coroutine is resumed on the Face's I/O thread.
+ *
+ *  Face::removeAllPendingInterests() and Face::shutdown() resume the coroutine with
+ *  ExpressResult::CANCELED, so that its frame can complete and be freed.
+ *
+ *  \warning If the awaiting coroutine is destroyed while suspended, the pending Interest must have
+ *           been canceled before the Face processes it; otherwise, the behavior is undefined.
+ *           This also applies to destroying the Face itself, which does not resume the coroutine.
+ */
+class ExpressAwaiter : public InterestContinuation, noncopyable
+{
+public:
+  /** \param interest the Interest, which must remain valid until the awaiter is suspended
+   */
+  ExpressAwaiter(Face& face, const Interest& interest)
+    : m_face(face)
+    , m_interest(interest)
+  {
+  }
+
+  bool
+  await_ready() const noexcept
+  {
+    return false;
+  }
+
+  void
+  await_suspend(std::coroutine_handle<> handle)
+  {
+    m_handle = handle;
+    m_face.expressInterest(m_interest, *this);
+  }
+
+  ExpressResult
+  await_resume()
+  {
+    return std::move(m_result);
+  }
+
+private:
+  void
+  onData(const Interest&, const Data& data) final
+  {
+    m_result.status = ExpressResult::DATA;
+    m_result.data = data;
+    m_handle.resume();
+  }
+
+  void
+  onNack(const Interest&, const lp::Nack& nack) final
+  {
+    m_result.status = ExpressResult::NACK;
+    m_result.nack = nack;
+    m_handle.resume();
+  }
+
+  void
+  onTimeout(const Interest&) final
+  {
+    m_result.status = ExpressResult::TIMEOUT;
+    m_handle.resume();
+  }
+
+  void
+  onCancel(const Interest&) final
+  {
+    m_result.status = ExpressResult::CANCELED;
+    m_handle.resume();
+  }
+
+private:
+  Face& m_face;
+  const Interest& m_interest;
+  std::coroutine_handle<> m_handle;
+  ExpressResult m_result;
+};
+
+/** \brief express an Interest from a coroutine
+ *
+ *  Example:
+ *  \code
+ *  ExpressResult res = co_await express(face, interest);
+ *  if (res.status == ExpressResult::DATA) {
+ *    ...
+ *  }
+ *  \endcode
+ */
+inline ExpressAwaiter
+express(Face& face, const Interest& interest)
+{
+  return ExpressAwaiter(face, interest);
+}
+
+/** \brief coroutine-friendly view of the segments retrieved by a SegmentFetcher
+ *
+ *  Validated segments are buffered in the order they are received, and handed out by next().
+ *  Destroying the stream stops the fetcher.
+ *
+ *  Example:
+ *  \code
+ *  SegmentStream stream(SegmentFetcher::start(face, Interest("/data/prefix"), validator));
+ *  while (optional<Data> segment = co_await stream.next()) {
+ *    ...
+ *  }
+ *  \endcode
+ */
+class SegmentStream : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    Error(uint32_t code, const std::string& what)
+      : std::runtime_error(what)
+      , m_code(code)
+    {
+    }
+
+    /** \return one of SegmentFetcher::ErrorCode
+     */
+    uint32_t
+    getCode() const
+    {
+      return m_code;
+    }
+
+  private:
+    uint32_t m_code;
+  };
+
+  class NextAwaiter
+  {
+  public:
+    explicit
+    NextAwaiter(SegmentStream& stream)
+      : m_stream(stream)
+    {
+    }
+
+    bool
+    await_ready() const noexcept
+    {
+      return m_stream.isReady();
+    }
+
+    void
+    await_suspend(std::coroutine_handle<> handle)
+    {
+      BOOST_ASSERT(!m_stream.m_waiter);
+      m_stream.m_waiter = handle;
+    }
+
+    /** \return the next segment, or nullopt after the last segment
+     *  \throw Error the fetcher has failed
+     */
+    optional<Data>
+    await_resume()
+    {
+      return m_stream.pop();
+    }
+
+  private:
+    SegmentStream& m_stream;
+  };
+
+  explicit
+  SegmentStream(shared_ptr<SegmentFetcher> fetcher)
+    : m_fetcher(std::move(fetcher))
+  {
+    m_onSegment = m_fetcher->afterSegmentValidated.connect([this] (const Data& data) {
+      m_segments.push_back(data);
+      this->wakeUp();
+    });
+    m_onComplete = m_fetcher->onComplete.connect([this] (const ConstBufferPtr&) {
+      m_isComplete = true;
+      this->wakeUp();
+    });
+    m_onError = m_fetcher->onError.connect([this] (uint32_t code, const std::string& msg) {
+      m_error = Error(code, msg);
+      this->wakeUp();
+    });
+  }
+
+  ~SegmentStream()
+  {
+    m_fetcher->stop();
+  }
+
+  /** \brief await the next segment
+   */
+  NextAwaiter
+  next()
+  {
+    return NextAwaiter(*this);
+  }
+
+private:
+  bool
+  isReady() const
+  {
+    return !m_segments.empty() || m_isComplete || m_error;
+  }
+
+  void
+  wakeUp()
+  {
+    auto waiter = std::exchange(m_waiter, nullptr);
+    if (waiter) {
+      waiter.resume();
+    }
+  }
+
+  optional<Data>
+  pop()
+  {
+    if (!m_segments.empty()) {
+      optional<Data> data(std::move(m_segments.front()));
+      m_segments.pop_front();
+      return data;
+    }
+    if (m_error) {
+      NDN_THROW(*m_error);
+    }
+    return nullopt;
+  }
+
+private:
+  shared_ptr<SegmentFetcher> m_fetcher;
+  signal::ScopedConnection m_onSegment;
+  signal::ScopedConnection m_onComplete;
+  signal::ScopedConnection m_onError;
+  std::deque<Data> m_segments;
+  bool m_isComplete = false;
+  optional<Error> m_error;
+  std::coroutine_handle<> m_waiter;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_CXX_HAVE_COROUTINES
+
+#endif // NDN_UTIL_COROUTINE_HPP
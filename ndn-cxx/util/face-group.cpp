@@ -0,0 +1,188 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/util/face-group.hpp"
+#include "ndn-cxx/mgmt/nfd/controller.hpp"
+#include "ndn-cxx/util/logger.hpp"
+
+NDN_LOG_INIT(ndn.FaceGroup);
+
+namespace ndn {
+namespace util {
+
+FaceGroup::Shard::Shard(size_t index, const Options& options)
+  : m_index(index)
+  , m_keyChain(options.makeKeyChain != nullptr ? options.makeKeyChain() : make_unique<KeyChain>())
+  , m_face(options.makeFace != nullptr ? options.makeFace(m_ioService, *m_keyChain) :
+                                         make_unique<Face>(nullptr, m_ioService, *m_keyChain))
+  , m_controller(make_unique<nfd::Controller>(*m_face, *m_keyChain))
+{
+}
+
+FaceGroup::Shard::~Shard() = default;
+
+FaceGroup::FaceGroup(const Options& options)
+{
+  size_t nShards = options.nShards;
+  if (nShards == 0) {
+    nShards = std::max(std::thread::hardware_concurrency(), 1U);
+  }
+
+  m_shards.reserve(nShards);
+  for (size_t i = 0; i < nShards; ++i) {
+    m_shards.push_back(make_unique<Shard>(i, options));
+  }
+}
+
+FaceGroup::~FaceGroup()
+{
+  stop();
+}
+
+size_t
+FaceGroup::getShardIndex(const Name& name) const
+{
+  return std::hash<Name>()(name) % m_shards.size();
+}
+
+void
+FaceGroup::start()
+{
+  if (m_isRunning) {
+    return;
+  }
+  m_isRunning = true;
+
+  for (auto& shard : m_shards) {
+    Shard* s = shard.get();
+    s->m_isStopping = false;
+    s->m_thread = std::thread([s] {
+      while (!s->m_isStopping) {
+        try {
+          s->m_face->processEvents(time::milliseconds::zero(), true);
+        }
+        catch (const std::exception& e) {
+          NDN_LOG_ERROR("shard " << s->m_index << ": " << e.what());
+        }
+      }
+    });
+  }
+}
+
+void
+FaceGroup::stop()
+{
+  if (!m_isRunning) {
+    return;
+  }
+  m_isRunning = false;
+
+  for (auto& shard : m_shards) {
+    shard->m_isStopping = true;
+    shard->m_face->shutdown();
+    shard->m_ioService.post([&io = shard->m_ioService] { io.stop(); });
+  }
+  for (auto& shard : m_shards) {
+    shard->m_thread.join();
+  }
+}
+
+void
+FaceGroup::setInterestFilter(const InterestFilter& filter, const InterestCallback& onInterest,
+                             const RegisterPrefixFailureCallback& onFailure,
+                             const security::SigningInfo& signingInfo)
+{
+  for (auto& shard : m_shards) {
+    Shard* s = shard.get();
+    auto dispatcher = makeDispatcher(s->m_index, onInterest);
+    s->m_ioService.post([=] {
+      s->m_face->setInterestFilter(filter, dispatcher, nullptr,
+        [onFailure] (const Name& prefix, const std::string& reason) {
+          if (onFailure != nullptr) {
+            onFailure(prefix, reason);
+          }
+        },
+        signingInfo);
+    });
+  }
+}
+
+void
+FaceGroup::announce(const PrefixAnnouncement& announcement, const InterestCallback& onInterest,
+                    const RegisterPrefixFailureCallback& onFailure,
+                    const security::SigningInfo& signingInfo)
+{
+  const Name& prefix = announcement.getAnnouncedName();
+  auto validity = announcement.getValidityPeriod();
+  if (validity && !validity->isValid()) {
+    if (onFailure != nullptr) {
+      onFailure(prefix, "Prefix announcement is outside its validity period");
+    }
+    return;
+  }
+
+  nfd::ControlParameters parameters;
+  parameters.setName(prefix).setFlags(nfd::ROUTE_FLAG_CHILD_INHERIT);
+  if (announcement.getExpiration() > 0_ms) {
+    parameters.setExpirationPeriod(announcement.getExpiration());
+  }
+  nfd::CommandOptions options;
+  options.setSigningInfo(signingInfo);
+
+  for (auto& shard : m_shards) {
+    Shard* s = shard.get();
+    auto dispatcher = makeDispatcher(s->m_index, onInterest);
+    s->m_ioService.post([=] {
+      s->m_face->setInterestFilter(InterestFilter(prefix), dispatcher);
+      s->m_controller->start<nfd::RibRegisterCommand>(parameters,
+        [s, prefix] (const nfd::ControlParameters&) {
+          NDN_LOG_INFO("shard " << s->m_index << " registered announced prefix " << prefix);
+        },
+        [onFailure, prefix] (const nfd::ControlResponse& resp) {
+          if (onFailure != nullptr) {
+            onFailure(prefix, resp.getText());
+          }
+        },
+        options);
+    });
+  }
+}
+
+ndn::InterestCallback
+FaceGroup::makeDispatcher(size_t receiver, const InterestCallback& onInterest)
+{
+  return [this, receiver, onInterest] (const InterestFilter&, const Interest& interest) {
+    size_t index = getShardIndex(interest.getName());
+    Shard& target = *m_shards[index];
+    if (index == receiver) {
+      onInterest(target, interest);
+      return;
+    }
+
+    NDN_LOG_TRACE("shard " << receiver << " hands " << interest.getName() << " to shard " << index);
+    target.m_ioService.post([&target, onInterest, interest] {
+      onInterest(target, interest);
+    });
+  };
+}
+
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,213 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_FACE_GROUP_HPP
+#define NDN_UTIL_FACE_GROUP_HPP
+
+#include "ndn-cxx/face.hpp"
+#include "ndn-cxx/prefix-announcement.hpp"
+
+#include <boost/asio/io_service.hpp>
+
+#include <atomic>
+#include <thread>
+
+namespace ndn {
+
+namespace nfd {
+class Controller;
+} // namespace nfd
+
+namespace util {
+
+/**
+ * @brief Spreads a producer over several Faces, each served by its own thread.
+ *
+ * Every shard owns an io_service, a KeyChain, and a Face with its own connection to the
+ * forwarder. A prefix served by the group is registered on every shard, so that the forwarder
+ * may deliver an Interest on any of the connections. The shard that receives an Interest hands
+ * it to the shard selected by hashing the Interest name, which invokes the application callback
+ * on its own thread. Data is then sent on the connection of the selected shard.
+ *
+ * Since every name is always processed by the same shard, state that is indexed by name, such as
+ * an InMemoryStorage holding the Data of a producer, can be kept per shard and accessed without
+ * locking. Each shard signs with its own KeyChain, because KeyChain is not thread-safe.
+ *
+ * @code
+ * FaceGroup group;
+ * group.setInterestFilter("/example", [] (FaceGroup::Shard& shard, const Interest& interest) {
+ *   auto data = make_shared<Data>(interest.getName());
+ *   shard.getKeyChain().sign(*data);
+ *   shard.getFace().put(*data);
+ * }, nullptr);
+ * group.start();
+ * @endcode
+ */
+class FaceGroup : noncopyable
+{
+public:
+  class Shard;
+
+  using InterestCallback = function<void(Shard& shard, const Interest& interest)>;
+
+  class Options
+  {
+  public:
+    Options()
+    {
+    }
+
+  public:
+    /// number of shards; zero means one shard per hardware thread
+    size_t nShards = 0;
+    /// creates the KeyChain of a shard; by default, a KeyChain with the default PIB and TPM
+    function<unique_ptr<KeyChain>()> makeKeyChain;
+    /// creates the Face of a shard; by default, a Face with the default transport
+    function<unique_ptr<Face>(boost::asio::io_service&, KeyChain&)> makeFace;
+  };
+
+  /**
+   * @brief A member of a FaceGroup.
+   *
+   * The Face, KeyChain, and io_service of a shard may only be used on the thread of the shard,
+   * i.e. from callbacks invoked by the group or from handlers posted to getIoService().
+   */
+  class Shard : noncopyable
+  {
+  public:
+    Shard(size_t index, const Options& options);
+
+    ~Shard();
+
+    size_t
+    getIndex() const
+    {
+      return m_index;
+    }
+
+    boost::asio::io_service&
+    getIoService()
+    {
+      return m_ioService;
+    }
+
+    KeyChain&
+    getKeyChain()
+    {
+      return *m_keyChain;
+    }
+
+    Face&
+    getFace()
+    {
+      return *m_face;
+    }
+
+  private:
+    const size_t m_index;
+    boost::asio::io_service m_ioService;
+    unique_ptr<KeyChain> m_keyChain;
+    unique_ptr<Face> m_face;
+    unique_ptr<nfd::Controller> m_controller;
+    std::thread m_thread;
+    std::atomic<bool> m_isStopping{false};
+
+    friend FaceGroup;
+  };
+
+  explicit
+  FaceGroup(const Options& options = Options());
+
+  /**
+   * @brief Stops the group, if it is running
+   */
+  ~FaceGroup();
+
+  size_t
+  size() const
+  {
+    return m_shards.size();
+  }
+
+  Shard&
+  operator[](size_t index)
+  {
+    return *m_shards.at(index);
+  }
+
+  /**
+   * @brief Returns the index of the shard that processes Interests for @p name
+   */
+  size_t
+  getShardIndex(const Name& name) const;
+
+  /**
+   * @brief Starts a thread for each shard
+   */
+  void
+  start();
+
+  /**
+   * @brief Shuts down the Face of each shard and waits for the threads to exit
+   */
+  void
+  stop();
+
+  /**
+   * @brief Sets an Interest filter and registers its prefix on every shard
+   * @param onFailure invoked with the reason once for every shard on which the registration failed
+   */
+  void
+  setInterestFilter(const InterestFilter& filter, const InterestCallback& onInterest,
+                    const RegisterPrefixFailureCallback& onFailure,
+                    const security::SigningInfo& signingInfo = security::SigningInfo());
+
+  /**
+   * @brief Serves the announced name of a prefix announcement on every shard
+   *
+   * The announced name is registered with the expiration period of @p announcement, if any, so
+   * that the routes of the group expire together with the announcement.
+   *
+   * @param onFailure invoked with the reason once for every shard on which the registration failed,
+   *                  or once if @p announcement is outside its validity period
+   */
+  void
+  announce(const PrefixAnnouncement& announcement, const InterestCallback& onInterest,
+           const RegisterPrefixFailureCallback& onFailure,
+           const security::SigningInfo& signingInfo = security::SigningInfo());
+
+private:
+  /**
+   * @brief Returns a callback that forwards Interests received by shard @p receiver to the
+   *        shard selected by getShardIndex()
+   */
+  ndn::InterestCallback
+  makeDispatcher(size_t receiver, const InterestCallback& onInterest);
+
+private:
+  std::vector<unique_ptr<Shard>> m_shards;
+  bool m_isRunning = false;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_FACE_GROUP_HPP
@@ -0,0 +1,1191 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/util/regex/regex-compiled-matcher.hpp"
+#include "ndn-cxx/util/string-helper.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cctype>
+#include <cstring>
+#include <regex>
+
+namespace ndn {
+
+namespace {
+
+const size_t REPEAT_INFINITE = std::numeric_limits<size_t>::max();
+const size_t MAX_REPEAT_COUNT = 10000;
+const size_t MAX_NFA_STATES = 20000;
+const size_t MAX_BYTE_DFA_STATES = 4096;
+const size_t MAX_COMPONENT_SETS = 64; // predicate outcomes of a DFA state fit in an uint64_t
+const size_t MAX_NAME_DFA_STATES = 1024;
+
+/** \brief thrown when (part of) an expression has no automaton equivalent
+ */
+class Unsupported : public std::exception
+{
+};
+
+using ByteSet = std::bitset<256>;
+
+/** \brief syntax tree of a regular expression over an abstract alphabet
+ *
+ *  Symbols are identified by labels: byte sets in component patterns, component sets in
+ *  the name-level expression.
+ */
+class Ast
+{
+public:
+  enum Type {
+    LEAF,
+    CONCAT,
+    ALTERNATION,
+    REPEAT
+  };
+
+  struct Node
+  {
+    Type type;
+    int label;
+    size_t min;
+    size_t max;
+    std::vector<size_t> children;
+    /// REPEAT with min > 0 that never matches the empty sequence, like RegexRepeatMatcher
+    bool isNonEmpty = false;
+  };
+
+  size_t
+  add(Type type, int label = -1, size_t min = 1, size_t max = 1)
+  {
+    nodes.push_back({type, label, min, max, {}});
+    return nodes.size() - 1;
+  }
+
+  void
+  addChild(size_t parent, size_t child)
+  {
+    nodes[parent].children.push_back(child);
+  }
+
+  /** \return whether the subtree at \p nodeId matches the empty sequence
+   */
+  bool
+  isNullable(size_t nodeId) const
+  {
+    const Node& node = nodes[nodeId];
+    switch (node.type) {
+      case LEAF:
+        return false;
+      case CONCAT:
+        return std::all_of(node.children.begin(), node.children.end(),
+                           [this] (size_t child) { return isNullable(child); });
+      case ALTERNATION:
+        return std::any_of(node.children.begin(), node.children.end(),
+                           [this] (size_t child) { return isNullable(child); });
+      case REPEAT:
+        return !node.isNonEmpty && (node.min == 0 || isNullable(node.children.at(0)));
+    }
+    return false;
+  }
+
+public:
+  std::vector<Node> nodes;
+};
+
+/** \brief Thompson NFA built from an Ast
+ *
+ *  A state with a label has a single transition on that label, to next[0].
+ *  A state without a label (label < 0) has epsilon transitions to each of next.
+ */
+class Nfa
+{
+public:
+  struct State
+  {
+    int label;
+    std::vector<int> next;
+  };
+
+  void
+  build(const Ast& ast, size_t root)
+  {
+    std::tie(start, accept) = buildNode(ast, root);
+  }
+
+  /** \return labeled states and the accepting state reachable from \p from by epsilon
+   *          transitions, sorted
+   */
+  std::vector<int>
+  closure(std::vector<int> from) const
+  {
+    std::vector<bool> isVisited(states.size());
+    std::vector<int> result;
+    while (!from.empty()) {
+      int s = from.back();
+      from.pop_back();
+      if (isVisited[s]) {
+        continue;
+      }
+      isVisited[s] = true;
+
+      const State& state = states[s];
+      if (state.label >= 0 || s == accept) {
+        result.push_back(s);
+      }
+      else {
+        from.insert(from.end(), state.next.begin(), state.next.end());
+      }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+private:
+  int
+  addState(int label = -1)
+  {
+    if (states.size() >= MAX_NFA_STATES) {
+      throw Unsupported();
+    }
+    states.push_back({label, {}});
+    return static_cast<int>(states.size() - 1);
+  }
+
+  void
+  link(int from, int to)
+  {
+    states[from].next.push_back(to);
+  }
+
+  /** \return start and end state of the fragment; the end state has no transitions
+   */
+  std::pair<int, int>
+  buildNode(const Ast& ast, size_t nodeId)
+  {
+    const Ast::Node& node = ast.nodes[nodeId];
+    int s = addState(node.type == Ast::LEAF ? node.label : -1);
+    int cur = s;
+
+    switch (node.type) {
+      case Ast::LEAF:
+        cur = addState();
+        link(s, cur);
+        break;
+
+      case Ast::CONCAT:
+        for (size_t child : node.children) {
+          auto f = buildNode(ast, child);
+          link(cur, f.first);
+          cur = f.second;
+        }
+        break;
+
+      case Ast::ALTERNATION:
+        cur = addState();
+        for (size_t child : node.children) {
+          auto f = buildNode(ast, child);
+          link(s, f.first);
+          link(f.second, cur);
+        }
+        break;
+
+      case Ast::REPEAT: {
+        size_t child = node.children.at(0);
+        bool mustExcludeEmpty = node.isNonEmpty && ast.isNullable(child);
+        for (size_t i = 0; i < node.min; ++i) {
+          auto f = buildNode(ast, child);
+          link(cur, f.first);
+          cur = f.second;
+        }
+        int e = addState();
+        if (node.max == REPEAT_INFINITE) {
+          auto f = buildNode(ast, child);
+          link(cur, f.first);
+          link(f.second, cur);
+        }
+        else {
+          for (size_t i = node.min; i < node.max; ++i) {
+            link(cur, e);
+            auto f = buildNode(ast, child);
+            link(cur, f.first);
+            cur = f.second;
+          }
+        }
+        link(cur, e);
+        cur = e;
+
+        if (mustExcludeEmpty) {
+          cur = excludeEmptyPath(s, cur);
+        }
+        break;
+      }
+    }
+
+    return {s, cur};
+  }
+
+  /** \brief remove the empty sequence from the language of the fragment [\p s, \p end]
+   *
+   *  The fragment occupies the states from \p s to the last state. It is duplicated: the original
+   *  states are visited before any label is consumed, and every labeled transition leads into the
+   *  copy, whose end state becomes the end of the fragment.
+   *
+   *  \return the new end state
+   */
+  int
+  excludeEmptyPath(int s, int end)
+  {
+    int nStates = static_cast<int>(states.size());
+    int offset = nStates - s;
+    if (states.size() + offset > MAX_NFA_STATES) {
+      throw Unsupported();
+    }
+
+    for (int i = s; i < nStates; ++i) {
+      State copy = states[i];
+      for (int& next : copy.next) {
+        next += offset;
+      }
+      states.push_back(std::move(copy));
+
+      if (states[i].label >= 0) {
+        states[i].next[0] += offset;
+      }
+    }
+    return end + offset;
+  }
+
+public:
+  std::vector<State> states;
+  int start = -1;
+  int accept = -1;
+};
+
+/** \brief parser for the subset of ECMAScript regular expressions that denotes regular languages
+ *
+ *  Throws Unsupported on backreferences, assertions other than leading '^' and trailing '$',
+ *  bracket expressions such as [[:alpha:]], non-ASCII characters, and any construct whose
+ *  interpretation by std::regex is not obvious. The expression has already been accepted by
+ *  std::regex, so syntax errors need not be diagnosed.
+ */
+class ComponentRegexParser
+{
+public:
+  ComponentRegexParser(const std::string& expr, Ast& ast, std::vector<ByteSet>& byteSets)
+    : m_expr(expr)
+    , m_ast(ast)
+    , m_byteSets(byteSets)
+  {
+  }
+
+  size_t
+  parse()
+  {
+    size_t root = parseDisjunction();
+    if (!atEnd()) {
+      throw Unsupported();
+    }
+    return root;
+  }
+
+private:
+  bool
+  atEnd() const
+  {
+    return m_pos >= m_expr.size();
+  }
+
+  char
+  peek() const
+  {
+    return m_expr[m_pos];
+  }
+
+  size_t
+  parseDisjunction()
+  {
+    size_t alternation = m_ast.add(Ast::ALTERNATION);
+    while (true) {
+      size_t alternative = parseAlternative();
+      m_ast.addChild(alternation, alternative);
+      if (atEnd() || peek() != '|') {
+        return alternation;
+      }
+      ++m_pos;
+    }
+  }
+
+  size_t
+  parseAlternative()
+  {
+    size_t concat = m_ast.add(Ast::CONCAT);
+    while (!atEnd() && peek() != '|' && peek() != ')') {
+      // std::regex_match matches the whole string, so that these assertions always hold
+      if ((peek() == '^' && m_pos == 0) ||
+          (peek() == '$' && m_pos == m_expr.size() - 1 && m_depth == 0)) {
+        ++m_pos;
+        if (!atEnd() && std::strchr("*+?{", peek()) != nullptr) {
+          throw Unsupported();
+        }
+        continue;
+      }
+
+      size_t term = parseAtom();
+      size_t min = 1, max = 1;
+      if (parseQuantifier(min, max)) {
+        size_t repeat = m_ast.add(Ast::REPEAT, -1, min, max);
+        m_ast.addChild(repeat, term);
+        term = repeat;
+      }
+      m_ast.addChild(concat, term);
+    }
+    return concat;
+  }
+
+  size_t
+  parseAtom()
+  {
+    char c = m_expr[m_pos++];
+    switch (c) {
+      case '.': {
+        ByteSet set;
+        set.set();
+        set.reset('\n');
+        set.reset('\r');
+        return addLeaf(set);
+      }
+      case '\\':
+        return addLeaf(parseAtomEscape());
+      case '[':
+        return addLeaf(parseClass());
+      case '(': {
+        if (!atEnd() && peek() == '?') {
+          // only non-capturing groups, not lookaheads
+          if (m_pos + 1 >= m_expr.size() || m_expr[m_pos + 1] != ':') {
+            throw Unsupported();
+          }
+          m_pos += 2;
+        }
+        ++m_depth;
+        size_t group = parseDisjunction();
+        --m_depth;
+        if (atEnd() || peek() != ')') {
+          throw Unsupported();
+        }
+        ++m_pos;
+        return group;
+      }
+      case '^':
+      case '$':
+      case '*':
+      case '+':
+      case '?':
+      case '{':
+      case '}':
+      case ']':
+        throw Unsupported();
+      default:
+        return addLeaf(makeByteSet(toByte(c)));
+    }
+  }
+
+  bool
+  parseQuantifier(size_t& min, size_t& max)
+  {
+    if (atEnd()) {
+      return false;
+    }
+
+    switch (peek()) {
+      case '*':
+        min = 0;
+        max = REPEAT_INFINITE;
+        break;
+      case '+':
+        min = 1;
+        max = REPEAT_INFINITE;
+        break;
+      case '?':
+        min = 0;
+        max = 1;
+        break;
+      case '{':
+        ++m_pos;
+        min = parseNumber();
+        max = min;
+        if (!atEnd() && peek() == ',') {
+          ++m_pos;
+          max = !atEnd() && peek() == '}' ? REPEAT_INFINITE : parseNumber();
+        }
+        if (atEnd() || peek() != '}' || min > max) {
+          throw Unsupported();
+        }
+        break;
+      default:
+        return false;
+    }
+    ++m_pos;
+
+    // a non-greedy quantifier accepts the same language
+    if (!atEnd() && peek() == '?') {
+      ++m_pos;
+    }
+    return true;
+  }
+
+  size_t
+  parseNumber()
+  {
+    size_t n = 0;
+    size_t nDigits = 0;
+    while (!atEnd() && std::isdigit(static_cast<unsigned char>(peek()))) {
+      n = n * 10 + (m_expr[m_pos++] - '0');
+      if (++nDigits > 5 || n > MAX_REPEAT_COUNT) {
+        throw Unsupported();
+      }
+    }
+    if (nDigits == 0) {
+      throw Unsupported();
+    }
+    return n;
+  }
+
+  ByteSet
+  parseAtomEscape()
+  {
+    if (atEnd()) {
+      throw Unsupported();
+    }
+    char c = m_expr[m_pos++];
+
+    ByteSet set;
+    if (parseCharacterClassEscape(c, set)) {
+      return set;
+    }
+    // \b and \B are assertions, \1 to \9 are backreferences
+    return makeByteSet(parseCharacterEscape(c));
+  }
+
+  ByteSet
+  parseClass()
+  {
+    bool isNegated = false;
+    if (!atEnd() && peek() == '^') {
+      isNegated = true;
+      ++m_pos;
+    }
+    if (!atEnd() && peek() == ']') {
+      throw Unsupported();
+    }
+
+    ByteSet set;
+    while (true) {
+      if (atEnd()) {
+        throw Unsupported();
+      }
+      if (peek() == ']') {
+        ++m_pos;
+        break;
+      }
+
+      int lo = parseClassAtom(set);
+      if (m_pos + 1 < m_expr.size() && peek() == '-' && m_expr[m_pos + 1] != ']') {
+        ++m_pos;
+        int hi = parseClassAtom(set);
+        if (lo < 0 || hi < lo) {
+          throw Unsupported();
+        }
+        for (int b = lo; b <= hi; ++b) {
+          set.set(b);
+        }
+      }
+      else if (lo >= 0) {
+        set.set(lo);
+      }
+    }
+
+    if (isNegated) {
+      set.flip();
+    }
+    return set;
+  }
+
+  /** \return the character, or -1 if a character class escape was added to \p set
+   */
+  int
+  parseClassAtom(ByteSet& set)
+  {
+    char c = m_expr[m_pos++];
+    if (c == '[') {
+      // [:class:], [=equiv=], and [.collating-element.]
+      throw Unsupported();
+    }
+    if (c != '\\') {
+      return toByte(c);
+    }
+
+    if (atEnd()) {
+      throw Unsupported();
+    }
+    c = m_expr[m_pos++];
+    if (parseCharacterClassEscape(c, set)) {
+      return -1;
+    }
+    if (c == 'b') {
+      return '\b';
+    }
+    return parseCharacterEscape(c);
+  }
+
+  static bool
+  parseCharacterClassEscape(char c, ByteSet& set)
+  {
+    ByteSet escaped;
+    auto b = static_cast<unsigned char>(c);
+    switch (std::tolower(b)) {
+      case 'd':
+        for (int d = '0'; d <= '9'; ++d) {
+          escaped.set(d);
+        }
+        break;
+      case 's':
+        for (char space : {' ', '\t', '\n', '\v', '\f', '\r'}) {
+          escaped.set(static_cast<uint8_t>(space));
+        }
+        break;
+      case 'w':
+        for (int w = 0; w < 128; ++w) {
+          if (std::isalnum(w) || w == '_') {
+            escaped.set(w);
+          }
+        }
+        break;
+      default:
+        return false;
+    }
+
+    if (std::isupper(b)) {
+      escaped.flip();
+    }
+    set |= escaped;
+    return true;
+  }
+
+  int
+  parseCharacterEscape(char c)
+  {
+    switch (c) {
+      case 'f':
+        return '\f';
+      case 'n':
+        return '\n';
+      case 'r':
+        return '\r';
+      case 't':
+        return '\t';
+      case 'v':
+        return '\v';
+      case '0':
+        if (!atEnd() && std::isdigit(static_cast<unsigned char>(peek()))) {
+          throw Unsupported();
+        }
+        return 0;
+      case 'x':
+        return parseHex(2);
+      case 'u':
+        return parseHex(4);
+      default:
+        if (std::isalnum(static_cast<unsigned char>(c))) {
+          throw Unsupported();
+        }
+        return toByte(c);
+    }
+  }
+
+  int
+  parseHex(size_t nDigits)
+  {
+    if (m_pos + nDigits > m_expr.size()) {
+      throw Unsupported();
+    }
+    int n = 0;
+    for (size_t i = 0; i < nDigits; ++i) {
+      int digit = fromHexChar(m_expr[m_pos++]);
+      if (digit < 0) {
+        throw Unsupported();
+      }
+      n = n * 16 + digit;
+    }
+    if (n >= 0x80) {
+      throw Unsupported();
+    }
+    return n;
+  }
+
+  static int
+  toByte(char c)
+  {
+    auto b = static_cast<uint8_t>(c);
+    if (b >= 0x80) {
+      // interpretation depends on the locale
+      throw Unsupported();
+    }
+    return b;
+  }
+
+  static ByteSet
+  makeByteSet(int b)
+  {
+    ByteSet set;
+    set.set(b);
+    return set;
+  }
+
+  size_t
+  addLeaf(const ByteSet& set)
+  {
+    m_byteSets.push_back(set);
+    return m_ast.add(Ast::LEAF, static_cast<int>(m_byteSets.size() - 1));
+  }
+
+private:
+  const std::string& m_expr;
+  Ast& m_ast;
+  std::vector<ByteSet>& m_byteSets;
+  size_t m_pos = 0;
+  size_t m_depth = 0;
+};
+
+/** \brief component regex compiled into a DFA over the URI representation of a component
+ */
+class ComponentPattern
+{
+public:
+  explicit
+  ComponentPattern(const std::string& expr)
+  {
+    if (expr.empty()) {
+      // like RegexComponentMatcher, an empty pattern matches any component
+      m_isAny = true;
+      return;
+    }
+
+    try {
+      compile(expr);
+    }
+    catch (const Unsupported&) {
+      m_regex = make_unique<std::regex>(expr);
+    }
+  }
+
+  bool
+  match(const name::Component& comp) const
+  {
+    if (m_isAny) {
+      return true;
+    }
+    if (m_regex != nullptr) {
+      return std::regex_match(comp.toUri(), *m_regex);
+    }
+
+    size_t state = START;
+    auto feed = [&] (char c) {
+      state = m_transitions[state * m_nClasses + m_classOf[static_cast<uint8_t>(c)]];
+      return state != DEAD;
+    };
+
+    if (comp.type() != tlv::GenericNameComponent) {
+      for (char c : comp.toUri()) {
+        if (!feed(c)) {
+          return false;
+        }
+      }
+      return m_isAccepting[state];
+    }
+
+    // same as Component::toUri, without building the string
+    bool isAllPeriods = std::all_of(comp.value_begin(), comp.value_end(),
+                                    [] (uint8_t x) { return x == '.'; });
+    if (isAllPeriods && !(feed('.') && feed('.') && feed('.'))) {
+      return false;
+    }
+    for (auto it = comp.value_begin(); it != comp.value_end(); ++it) {
+      uint8_t c = *it;
+      bool isUnreserved = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                          (c >= '0' && c <= '9') || c == '-' || c == '.' || c == '_' || c == '~';
+      if (isUnreserved ? !feed(c) : !(feed('%') && feed(toHexChar(c >> 4)) && feed(toHexChar(c)))) {
+        return false;
+      }
+    }
+    return m_isAccepting[state];
+  }
+
+private:
+  void
+  compile(const std::string& expr)
+  {
+    Ast ast;
+    std::vector<ByteSet> byteSets;
+    size_t root = ComponentRegexParser(expr, ast, byteSets).parse();
+    Nfa nfa;
+    nfa.build(ast, root);
+
+    // partition bytes into classes that no byte set distinguishes
+    m_classOf.fill(0);
+    m_nClasses = 1;
+    for (const auto& set : byteSets) {
+      std::vector<int> split(m_nClasses * 2, -1);
+      size_t nClasses = 0;
+      for (size_t b = 0; b < 256; ++b) {
+        int& id = split[m_classOf[b] * 2 + set[b]];
+        if (id < 0) {
+          id = static_cast<int>(nClasses++);
+        }
+        m_classOf[b] = static_cast<uint8_t>(id);
+      }
+      m_nClasses = nClasses;
+    }
+    std::vector<size_t> representative(m_nClasses);
+    for (size_t b = 0; b < 256; ++b) {
+      representative[m_classOf[b]] = b;
+    }
+
+    // subset construction
+    std::map<std::vector<int>, uint16_t> index;
+    std::vector<std::vector<int>> dfaStates;
+    auto addState = [&] (std::vector<int> nfaStates) -> uint16_t {
+      auto it = index.find(nfaStates);
+      if (it != index.end()) {
+        return it->second;
+      }
+      if (dfaStates.size() >= MAX_BYTE_DFA_STATES) {
+        throw Unsupported();
+      }
+      auto id = static_cast<uint16_t>(dfaStates.size());
+      index.emplace(nfaStates, id);
+      m_isAccepting.push_back(std::binary_search(nfaStates.begin(), nfaStates.end(), nfa.accept));
+      dfaStates.push_back(std::move(nfaStates));
+      return id;
+    };
+
+    addState({});
+    addState(nfa.closure({nfa.start}));
+    for (size_t i = 0; i < dfaStates.size(); ++i) {
+      const std::vector<int> current = dfaStates[i];
+      for (size_t c = 0; c < m_nClasses; ++c) {
+        std::vector<int> next;
+        for (int s : current) {
+          const Nfa::State& nfaState = nfa.states[s];
+          if (nfaState.label >= 0 && byteSets[nfaState.label][representative[c]]) {
+            next.push_back(nfaState.next[0]);
+          }
+        }
+        m_transitions.push_back(addState(nfa.closure(std::move(next))));
+      }
+    }
+  }
+
+private:
+  static constexpr size_t DEAD = 0;
+  static constexpr size_t START = 1;
+
+  bool m_isAny = false;
+  unique_ptr<std::regex> m_regex; ///< non-null if the pattern cannot be compiled into a DFA
+
+  std::array<uint8_t, 256> m_classOf;
+  size_t m_nClasses = 0;
+  std::vector<uint16_t> m_transitions; ///< next state, indexed by state * m_nClasses + class
+  std::vector<bool> m_isAccepting;
+};
+
+constexpr size_t ComponentPattern::DEAD;
+constexpr size_t ComponentPattern::START;
+
+/** \brief a single component regex <...>, or a component set [...] or [^...]
+ */
+struct ComponentSet
+{
+  bool isInclusion;
+  std::vector<size_t> patterns;
+};
+
+} // namespace
+
+/** \brief compiled form of an NDN regular expression, shared by copies of a matcher
+ */
+class RegexCompiledMatcher::Program
+{
+public:
+  /** \throw Unsupported the expression cannot be compiled
+   */
+  explicit
+  Program(const std::string& expr)
+  {
+    if (expr.empty()) {
+      throw Unsupported();
+    }
+
+    // same rewriting as RegexTopMatcher::compile(); when the expression does not start with '^',
+    // the secondary matcher accepts a superset of what the primary matcher accepts
+    std::string body = expr;
+    if (body.back() != '$')
+      body += "<.*>*";
+    else
+      body.pop_back();
+
+    if (body.empty() || body[0] != '^')
+      body = "<.*>*" + body;
+    else
+      body.erase(0, 1);
+
+    Ast ast;
+    size_t root = parsePatternList(body, ast);
+    if (sets.size() > MAX_COMPONENT_SETS) {
+      throw Unsupported();
+    }
+    nfa.build(ast, root);
+  }
+
+  bool
+  matchSet(size_t setId, const name::Component& comp, std::vector<int8_t>& patternResults) const
+  {
+    const ComponentSet& set = sets[setId];
+    bool isMatched = false;
+    for (size_t p : set.patterns) {
+      int8_t& result = patternResults[p];
+      if (result < 0) {
+        result = patterns[p].match(comp);
+      }
+      if (result > 0) {
+        isMatched = true;
+        break;
+      }
+    }
+    return set.isInclusion == isMatched;
+  }
+
+private:
+  /** \brief parse a pattern list, following RegexPatternListMatcher
+   */
+  size_t
+  parsePatternList(const std::string& expr, Ast& ast)
+  {
+    size_t list = ast.add(Ast::CONCAT);
+    size_t index = 0;
+    while (index < expr.size()) {
+      size_t start = index;
+      size_t indicator = 0;
+      size_t item = 0;
+      switch (expr[index]) {
+        case '(':
+          indicator = extractSubPattern(expr, '(', ')', index + 1);
+          item = parsePatternList(expr.substr(start + 1, indicator - start - 2), ast);
+          break;
+        case '<':
+          indicator = extractSubPattern(expr, '<', '>', index + 1);
+          item = ast.add(Ast::LEAF, addComponentSet(expr.substr(start, indicator - start)));
+          break;
+        case '[':
+          indicator = extractSubPattern(expr, '[', ']', index + 1);
+          item = ast.add(Ast::LEAF, addComponentSet(expr.substr(start, indicator - start)));
+          break;
+        default:
+          throw Unsupported();
+      }
+
+      index = extractRepetition(expr, indicator);
+      if (index > indicator) {
+        size_t min = 1, max = 1;
+        parseRepetition(expr.substr(indicator, index - indicator), min, max);
+        size_t repeat = ast.add(Ast::REPEAT, -1, min, max);
+        // RegexRepeatMatcher rejects an empty span when min > 0, even if the repeated
+        // sub-pattern could match it, e.g., (<a>?){2} does not match an empty sequence
+        ast.nodes[repeat].isNonEmpty = min > 0;
+        ast.addChild(repeat, item);
+        item = repeat;
+      }
+      ast.addChild(list, item);
+    }
+    return list;
+  }
+
+  static size_t
+  extractSubPattern(const std::string& expr, char left, char right, size_t index)
+  {
+    size_t lcount = 1;
+    size_t rcount = 0;
+    while (lcount > rcount) {
+      if (index >= expr.size())
+        throw Unsupported();
+      if (left == expr[index])
+        lcount++;
+      if (right == expr[index])
+        rcount++;
+      index++;
+    }
+    return index;
+  }
+
+  static size_t
+  extractRepetition(const std::string& expr, size_t index)
+  {
+    if (index == expr.size())
+      return index;
+
+    if (expr[index] == '+' || expr[index] == '?' || expr[index] == '*')
+      return index + 1;
+
+    if (expr[index] == '{') {
+      size_t end = expr.find('}', index);
+      if (end == std::string::npos)
+        throw Unsupported();
+      return end + 1;
+    }
+    return index;
+  }
+
+  /** \brief parse a repetition, following RegexRepeatMatcher::parseRepetition
+   */
+  static void
+  parseRepetition(const std::string& repetition, size_t& min, size_t& max)
+  {
+    if (repetition == "?") {
+      min = 0;
+      max = 1;
+      return;
+    }
+    if (repetition == "+" || repetition == "*") {
+      min = repetition == "+" ? 1 : 0;
+      max = REPEAT_INFINITE;
+      return;
+    }
+
+    static const std::regex braces("\\{([0-9]*)(,?)([0-9]*)\\}");
+    std::smatch match;
+    if (!std::regex_match(repetition, match, braces) ||
+        (match[1].length() == 0 && match[2].length() == 0) ||
+        match[1].length() > 5 || match[3].length() > 5) {
+      throw Unsupported();
+    }
+
+    min = match[1].length() == 0 ? 0 : std::stoul(match[1].str());
+    if (match[2].length() == 0)
+      max = min;
+    else
+      max = match[3].length() == 0 ? REPEAT_INFINITE : std::stoul(match[3].str());
+
+    if (min > max || min > MAX_REPEAT_COUNT || (max != REPEAT_INFINITE && max > MAX_REPEAT_COUNT))
+      throw Unsupported();
+  }
+
+  /** \param expr "<...>", "[...]", or "[^...]"
+   */
+  int
+  addComponentSet(const std::string& expr)
+  {
+    auto it = m_setIndex.find(expr);
+    if (it != m_setIndex.end()) {
+      return static_cast<int>(it->second);
+    }
+
+    ComponentSet set{true, {}};
+    if (expr[0] == '<') {
+      set.patterns.push_back(addPattern(expr.substr(1, expr.size() - 2)));
+    }
+    else {
+      size_t last = expr.size() - 1;
+      size_t index = 1;
+      if (expr.size() > 1 && expr[1] == '^') {
+        set.isInclusion = false;
+        index = 2;
+      }
+      while (index < last) {
+        if (expr[index] != '<')
+          throw Unsupported();
+        size_t begin = index + 1;
+        index = extractSubPattern(expr, '<', '>', begin);
+        set.patterns.push_back(addPattern(expr.substr(begin, index - begin - 1)));
+      }
+      if (index != last)
+        throw Unsupported();
+    }
+
+    sets.push_back(std::move(set));
+    m_setIndex.emplace(expr, sets.size() - 1);
+    return static_cast<int>(sets.size() - 1);
+  }
+
+  size_t
+  addPattern(const std::string& expr)
+  {
+    auto it = m_patternIndex.find(expr);
+    if (it != m_patternIndex.end()) {
+      return it->second;
+    }
+    patterns.emplace_back(expr);
+    m_patternIndex.emplace(expr, patterns.size() - 1);
+    return patterns.size() - 1;
+  }
+
+public:
+  std::vector<ComponentPattern> patterns;
+  std::vector<ComponentSet> sets;
+  Nfa nfa;
+
+private:
+  std::map<std::string, size_t> m_patternIndex;
+  std::map<std::string, size_t> m_setIndex;
+};
+
+RegexCompiledMatcher::RegexCompiledMatcher(const std::string& expr)
+  : m_expr(expr)
+{
+  // RegexTopMatcher validates the expression, and throws the same errors as ndn::Regex
+  auto reference = make_shared<RegexTopMatcher>(expr);
+
+  try {
+    m_program = make_shared<Program>(expr);
+  }
+  catch (const Unsupported&) {
+    m_fallback = std::move(reference);
+    return;
+  }
+
+  m_patternResults.resize(m_program->patterns.size());
+  addDfaState(m_program->nfa.closure({m_program->nfa.start}));
+}
+
+RegexCompiledMatcher::RegexCompiledMatcher(const RegexCompiledMatcher& other)
+  : m_expr(other.m_expr)
+  , m_program(other.m_program)
+  , m_dfaStates(other.m_dfaStates)
+  , m_dfaIndex(other.m_dfaIndex)
+  , m_patternResults(other.m_patternResults)
+{
+  if (other.m_fallback != nullptr) {
+    // RegexTopMatcher keeps the state of the last match, and cannot be shared either
+    m_fallback = make_shared<RegexTopMatcher>(m_expr);
+  }
+}
+
+bool
+RegexCompiledMatcher::match(Name::const_iterator first, Name::const_iterator last)
+{
+  if (m_program == nullptr) {
+    Name name;
+    for (auto it = first; it != last; ++it) {
+      name.append(*it);
+    }
+    return m_fallback->match(name);
+  }
+
+  size_t state = 0;
+  for (auto it = first; it != last; ++it) {
+    state = step(state, *it);
+    if (m_dfaStates[state].nfaStates.empty()) {
+      return false;
+    }
+  }
+  return m_dfaStates[state].isAccepting;
+}
+
+size_t
+RegexCompiledMatcher::addDfaState(std::vector<int> nfaStates)
+{
+  auto it = m_dfaIndex.find(nfaStates);
+  if (it != m_dfaIndex.end()) {
+    return it->second;
+  }
+
+  const Nfa& nfa = m_program->nfa;
+  DfaState state;
+  state.isAccepting = std::binary_search(nfaStates.begin(), nfaStates.end(), nfa.accept);
+  for (int s : nfaStates) {
+    int label = nfa.states[s].label;
+    if (label >= 0 && std::find(state.predicates.begin(), state.predicates.end(),
+                                static_cast<size_t>(label)) == state.predicates.end()) {
+      state.predicates.push_back(static_cast<size_t>(label));
+    }
+  }
+  state.nfaStates = std::move(nfaStates);
+
+  m_dfaIndex.emplace(state.nfaStates, m_dfaStates.size());
+  m_dfaStates.push_back(std::move(state));
+  return m_dfaStates.size() - 1;
+}
+
+size_t
+RegexCompiledMatcher::step(size_t stateId, const name::Component& comp)
+{
+  const Program& program = *m_program;
+
+  uint64_t outcome = 0;
+  std::fill(m_patternResults.begin(), m_patternResults.end(), -1);
+  const auto& predicates = m_dfaStates[stateId].predicates;
+  for (size_t i = 0; i < predicates.size(); ++i) {
+    if (program.matchSet(predicates[i], comp, m_patternResults)) {
+      outcome |= uint64_t(1) << i;
+    }
+  }
+
+  for (const auto& transition : m_dfaStates[stateId].transitions) {
+    if (transition.first == outcome) {
+      return transition.second;
+    }
+  }
+
+  std::vector<int> next;
+  for (int s : m_dfaStates[stateId].nfaStates) {
+    const Nfa::State& nfaState = program.nfa.states[s];
+    if (nfaState.label < 0) {
+      continue;
+    }
+    size_t i = std::find(predicates.begin(), predicates.end(), static_cast<size_t>(nfaState.label)) -
+               predicates.begin();
+    if (outcome & (uint64_t(1) << i)) {
+      next.push_back(nfaState.next[0]);
+    }
+  }
+  next = program.nfa.closure(std::move(next));
+
+  if (m_dfaStates.size() >= MAX_NAME_DFA_STATES && m_dfaIndex.count(next) == 0) {
+    // start over instead of growing the cache without bound
+    m_dfaStates.resize(1);
+    m_dfaStates.front().transitions.clear();
+    m_dfaIndex.clear();
+    m_dfaIndex.emplace(m_dfaStates.front().nfaStates, 0);
+    return addDfaState(std::move(next));
+  }
+
+  size_t nextId = addDfaState(std::move(next));
+  m_dfaStates[stateId].transitions.emplace_back(outcome, nextId);
+  return nextId;
+}
+
+std::ostream&
+operator<<(std::ostream& os, const RegexCompiledMatcher& rm)
+{
+  return os << rm.getExpr();
+}
+
+} // namespace ndn
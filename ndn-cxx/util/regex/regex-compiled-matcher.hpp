@@ -0,0 +1,136 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_REGEX_REGEX_COMPILED_MATCHER_HPP
+#define NDN_UTIL_REGEX_REGEX_COMPILED_MATCHER_HPP
+
+#include "ndn-cxx/util/regex/regex-top-matcher.hpp"
+
+#include <map>
+
+namespace ndn {
+
+/** \brief NDN regular expression compiled into a component-level automaton
+ *
+ *  RegexCompiledMatcher accepts the same syntax as RegexTopMatcher and matches exactly the same
+ *  names, including where RegexTopMatcher departs from the usual semantics: a repetition whose
+ *  minimum is positive never matches an empty sequence, e.g., "^(<a>?){2}$" does not match "/".
+ *
+ *  Instead of backtracking through a tree of matchers and running std::regex on the URI
+ *  of every name component, the expression is compiled into an automaton over name components,
+ *  whose transitions are guarded by component patterns. Each component pattern is compiled into
+ *  a byte-level DFA that runs directly over the URI representation of the component, which is
+ *  produced on the fly without building a string. The component-level automaton is determinized
+ *  lazily, as names are matched, so that each name component is visited exactly once.
+ *
+ *  Component patterns that use std::regex features without a DFA equivalent (backreferences,
+ *  assertions, POSIX character classes, or non-ASCII characters) are evaluated with std::regex.
+ *  Expressions that cannot be compiled at all, e.g., because their counted repetitions are too
+ *  large, are matched with RegexTopMatcher.
+ *
+ *  Captures are not tracked: use RegexTopMatcher (ndn::Regex) when expand() is needed.
+ *
+ *  \note match() updates a cache of automaton states, so that an instance must not be used
+ *        from multiple threads concurrently. Give each thread its own copy instead.
+ */
+class RegexCompiledMatcher
+{
+public:
+  using Error = RegexMatcher::Error;
+
+  /** \brief compile \p expr
+   *  \throw Error \p expr is not a valid NDN regular expression
+   */
+  explicit
+  RegexCompiledMatcher(const std::string& expr);
+
+  /** \brief copy the compiled expression and the automaton states built so far
+   *
+   *  The copy has its own automaton cache, so that it can be used on a different thread than
+   *  \p other. The compiled expression itself is immutable and is shared.
+   */
+  RegexCompiledMatcher(const RegexCompiledMatcher& other);
+
+  RegexCompiledMatcher&
+  operator=(const RegexCompiledMatcher&) = delete;
+
+  bool
+  match(const Name& name)
+  {
+    return match(name.begin(), name.end());
+  }
+
+  /** \brief match the sequence of name components [\p first, \p last)
+   */
+  bool
+  match(Name::const_iterator first, Name::const_iterator last);
+
+  const std::string&
+  getExpr() const
+  {
+    return m_expr;
+  }
+
+  /** \brief whether the expression was compiled into an automaton
+   *  \retval false the expression is matched with RegexTopMatcher
+   */
+  bool
+  isCompiled() const
+  {
+    return m_program != nullptr;
+  }
+
+private:
+  class Program;
+
+  /** \brief state of the determinized component-level automaton
+   */
+  struct DfaState
+  {
+    std::vector<int> nfaStates; ///< sorted; empty in the dead state
+    std::vector<size_t> predicates; ///< component sets evaluated to leave this state
+    bool isAccepting;
+    /// next state by outcome of predicates, bit i set if predicates[i] matched
+    std::vector<std::pair<uint64_t, size_t>> transitions;
+  };
+
+  size_t
+  addDfaState(std::vector<int> nfaStates);
+
+  size_t
+  step(size_t stateId, const name::Component& comp);
+
+private:
+  std::string m_expr;
+  shared_ptr<const Program> m_program; ///< nullptr if not compiled
+  shared_ptr<RegexTopMatcher> m_fallback; ///< non-null if not compiled
+
+  std::vector<DfaState> m_dfaStates; ///< m_dfaStates[0] is the start state
+  std::map<std::vector<int>, size_t> m_dfaIndex;
+  std::vector<int8_t> m_patternResults; ///< per-component memo of component pattern results
+};
+
+std::ostream&
+operator<<(std::ostream& os, const RegexCompiledMatcher& rm);
+
+} // namespace ndn
+
+#endif // NDN_UTIL_REGEX_REGEX_COMPILED_MATCHER_HPP
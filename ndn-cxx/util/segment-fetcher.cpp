@@ -165,15 +165,18 @@ SegmentFetcher::fetchSegmentsInWindow(const Interest& origInterest)
     availableWindowSize--;
   }
 
+  std::vector<Interest> interests;
+  interests.reserve(segmentsToRequest.size());
   for (const auto& segment : segmentsToRequest) {
-    Interest interest(origInterest); // to preserve Interest elements
+    interests.push_back(origInterest); // to preserve Interest elements
+    Interest& interest = interests.back();
     interest.setName(Name(m_versionedDataName).appendSegment(segment.first));
     interest.setCanBePrefix(false);
     interest.setMustBeFresh(false);
     interest.setInterestLifetime(m_options.interestLifetime);
     interest.refreshNonce();
-    sendInterest(segment.first, interest, segment.second);
   }
+  sendInterests(segmentsToRequest, std::move(interests));
 }
 
 void
@@ -191,6 +194,46 @@ SegmentFetcher::sendInterest(uint64_t segNum, const Interest& interest, bool isR
     },
     nullptr);
 
+  recordPendingSegment(segNum, interest, isRetransmission, pendingInterest);
+}
+
+void
+SegmentFetcher::sendInterests(const std::vector<std::pair<uint64_t, bool>>& segments,
+                              std::vector<Interest> interests)
+{
+  BOOST_ASSERT(segments.size() == interests.size());
+  if (interests.empty()) {
+    return;
+  }
+
+  weak_ptr<SegmentFetcher> weakSelf = m_this;
+
+  // the timeout events need the Interests after they have been moved into the face
+  std::vector<Interest> interestsCopy(interests);
+
+  m_nSegmentsInFlight += interests.size();
+  auto pendingInterests = m_face.expressInterests(std::move(interests),
+    [this, weakSelf] (const Interest& interest, const Data& data) {
+      afterSegmentReceivedCb(interest, data, weakSelf);
+    },
+    [this, weakSelf] (const Interest& interest, const lp::Nack& nack) {
+      afterNackReceivedCb(interest, nack, weakSelf);
+    },
+    nullptr);
+
+  for (size_t i = 0; i < segments.size(); ++i) {
+    recordPendingSegment(segments[i].first, interestsCopy[i], segments[i].second,
+                         pendingInterests[i]);
+  }
+}
+
+void
+SegmentFetcher::recordPendingSegment(uint64_t segNum, const Interest& interest,
+                                     bool isRetransmission,
+                                     const PendingInterestHandle& pendingInterest)
+{
+  weak_ptr<SegmentFetcher> weakSelf = m_this;
+
   auto timeout = m_options.useConstantInterestTimeout ? m_options.maxTimeout : getEstimatedRto();
   auto timeoutEvent = m_scheduler.schedule(timeout, [this, interest, weakSelf] {
     afterTimeoutCb(interest, weakSelf);
@@ -191,6 +191,18 @@ private:
   void
   sendInterest(uint64_t segNum, const Interest& interest, bool isRetransmission);
 
+  /** \brief express the Interests of a window as one batch
+   *  \param segments segment numbers, each with whether it is a retransmission
+   *  \param interests Interests for \p segments, in the same order
+   */
+  void
+  sendInterests(const std::vector<std::pair<uint64_t, bool>>& segments,
+                std::vector<Interest> interests);
+
+  void
+  recordPendingSegment(uint64_t segNum, const Interest& interest, bool isRetransmission,
+                       const PendingInterestHandle& pendingInterest);
+
   void
   afterSegmentReceivedCb(const Interest& origInterest, const Data& data,
                          const weak_ptr<SegmentFetcher>& weakSelf);
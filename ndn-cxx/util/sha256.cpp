@@ -22,6 +22,7 @@
 #include "ndn-cxx/util/sha256.hpp"
 #include "ndn-cxx/util/string-helper.hpp"
 #include "ndn-cxx/security/impl/openssl.hpp"
+#include "ndn-cxx/security/impl/openssl-helper.hpp"
 #include "ndn-cxx/security/transform/digest-filter.hpp"
 #include "ndn-cxx/security/transform/stream-sink.hpp"
 #include "ndn-cxx/security/transform/stream-source.hpp"
@@ -135,9 +136,12 @@ Sha256::toString()
 ConstBufferPtr
 Sha256::computeDigest(const uint8_t* buffer, size_t size)
 {
-  Sha256 sha256;
-  sha256.update(buffer, size);
-  return sha256.computeDigest();
+  // one-shot digest without building a transform chain
+  auto digest = security::detail::computeDigest(DigestAlgorithm::SHA256, buffer, size);
+  if (digest == nullptr)
+    NDN_THROW(Error("Failed to compute SHA-256 digest"));
+
+  return digest;
 }
 
 std::ostream&
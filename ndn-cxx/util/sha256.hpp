@@ -160,6 +160,8 @@ public:
    * @param buffer the input buffer
    * @param size the size of the input buffer
    * @return SHA-256 digest of the input buffer
+   * @note This method does not build a transform chain, and may be called concurrently from
+   *       several threads.
    */
   static ConstBufferPtr
   computeDigest(const uint8_t* buffer, size_t size);
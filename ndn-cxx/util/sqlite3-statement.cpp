@@ -107,6 +107,13 @@ Sqlite3Statement::step()
   return sqlite3_step(m_stmt);
 }
 
+void
+Sqlite3Statement::reset()
+{
+  sqlite3_reset(m_stmt);
+  sqlite3_clear_bindings(m_stmt);
+}
+
 Sqlite3Statement::operator sqlite3_stmt*()
 {
   return m_stmt;
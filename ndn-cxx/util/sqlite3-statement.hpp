@@ -142,6 +142,12 @@ public:
   int
   step();
 
+  /**
+   * @brief reset the statement so that it can be executed again, and clear all bindings
+   */
+  void
+  reset();
+
   /**
    * @brief implicitly converts to sqlite3_stmt* to be used in SQLite C API
    */
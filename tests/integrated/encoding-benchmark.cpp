@@ -130,6 +130,60 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(ReadVarNumber, Test, ReadVarNumberTests)
             << " " << d << std::endl;
 }
 
+// Benchmark of scanning element boundaries with ndn::tlv::scanElementHeaders, compared with
+// decoding each header with readType and readVarNumber.
+// Run this benchmark with:
+//    ./encoding-benchmark -t 'ScanElementHeaders'
+BOOST_AUTO_TEST_CASE(ScanElementHeaders)
+{
+  const int N_ITERATIONS = 1000000;
+  const size_t N_ELEMENTS = 64;
+
+  // alternate short elements and elements with 3-octet TLV-LENGTH, at varying alignments
+  std::vector<uint8_t> wire;
+  for (size_t i = 0; i < N_ELEMENTS; ++i) {
+    if (i % 2 == 0) {
+      wire.insert(wire.end(), {0x08, 0x03, 0x61, 0x62, 0x63});
+    }
+    else {
+      wire.insert(wire.end(), {0x15, 0xfd, 0x01, 0x00});
+      wire.resize(wire.size() + 256, 0xbb);
+    }
+  }
+  const uint8_t* const begin = wire.data();
+  const uint8_t* const end = begin + wire.size();
+
+  size_t nElements = 0;
+  auto d1 = timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      const uint8_t* pos = begin;
+      while (pos != end) {
+        readType(pos, end);
+        pos += readVarNumber(pos, end);
+        ++nElements;
+      }
+    }
+  });
+  BOOST_CHECK_EQUAL(nElements, N_ITERATIONS * N_ELEMENTS);
+  std::cout << "readType+readVarNumber " << d1 << std::endl;
+
+  nElements = 0;
+  auto d2 = timedExecute([&] {
+    ElementHeader headers[16];
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      size_t offset = 0;
+      while (offset < wire.size()) {
+        size_t n = scanElementHeaders(begin + offset, wire.size() - offset, headers, 16);
+        const ElementHeader& last = headers[n - 1];
+        offset += last.offset + last.size + last.length;
+        nElements += n;
+      }
+    }
+  });
+  BOOST_CHECK_EQUAL(nElements, N_ITERATIONS * N_ELEMENTS);
+  std::cout << "scanElementHeaders " << d2 << std::endl;
+}
+
 } // namespace tests
 } // namespace tlv
 } // namespace ndn
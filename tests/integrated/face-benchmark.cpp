@@ -0,0 +1,336 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MODULE ndn-cxx Face Benchmark
+#include "tests/boost-test.hpp"
+
+#include "ndn-cxx/face.hpp"
+#include "ndn-cxx/ims/in-memory-storage-persistent.hpp"
+#include "ndn-cxx/lp/packet.hpp"
+#include "ndn-cxx/lp/tags.hpp"
+#include "ndn-cxx/security/signing-helpers.hpp"
+#include "ndn-cxx/security/v2/key-chain.hpp"
+#include "ndn-cxx/transport/transport.hpp"
+#include "tests/integrated/timed-execute.hpp"
+
+#include <boost/asio/io_service.hpp>
+#include <atomic>
+#include <iostream>
+#include <new>
+
+namespace {
+
+std::atomic<size_t> g_nAllocations{0};
+
+} // namespace
+
+// out of line, otherwise inlined free() on operator new results trips -Wmismatched-new-delete
+__attribute__((noinline)) void*
+operator new(std::size_t size)
+{
+  ++g_nAllocations;
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+__attribute__((noinline)) void
+operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+__attribute__((noinline)) void
+operator delete(void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+namespace ndn {
+namespace tests {
+
+class NullTransport : public Transport
+{
+public:
+  void
+  connect(boost::asio::io_service& ioService, const ReceiveCallback& receiveCallback) final
+  {
+    Transport::connect(ioService, receiveCallback);
+    m_isConnected = true;
+  }
+
+  void
+  close() final
+  {
+    m_isConnected = false;
+  }
+
+  void
+  send(const Block&) final
+  {
+    ++nSent;
+  }
+
+  void
+  send(const Block&, const Block&) final
+  {
+    ++nSent;
+  }
+
+  void
+  pause() final
+  {
+  }
+
+  void
+  resume() final
+  {
+  }
+
+  using Transport::receive;
+
+public:
+  size_t nSent = 0;
+};
+
+class ExpressInterestFixture
+{
+public:
+  ExpressInterestFixture()
+    : keyChain("pib-memory:", "tpm-memory:")
+    , transport(make_shared<NullTransport>())
+    , face(transport, io, keyChain)
+  {
+    interests.reserve(N_INTERESTS);
+    for (size_t i = 0; i < N_INTERESTS; ++i) {
+      interests.emplace_back(Name("/benchmark").appendNumber(i));
+      interests.back().setCanBePrefix(false);
+      interests.back().setNonce(static_cast<uint32_t>(i));
+      interests.back().wireEncode();
+    }
+  }
+
+  template<typename F>
+  void
+  measure(const std::string& label, const F& expressOne)
+  {
+    size_t nAllocations = g_nAllocations;
+    auto d = timedExecute([&] {
+      for (const auto& interest : interests) {
+        expressOne(interest);
+      }
+      io.poll();
+    });
+    nAllocations = g_nAllocations - nAllocations;
+    BOOST_CHECK_EQUAL(face.getNPendingInterests(), N_INTERESTS);
+
+    std::cout << label << " " << N_INTERESTS << " Interests: " << d << ", "
+              << static_cast<double>(nAllocations) / N_INTERESTS << " allocations per Interest"
+              << std::endl;
+  }
+
+public:
+  static constexpr size_t N_INTERESTS = 100000;
+  boost::asio::io_service io;
+  KeyChain keyChain;
+  shared_ptr<NullTransport> transport;
+  Face face;
+  std::vector<Interest> interests;
+};
+
+constexpr size_t ExpressInterestFixture::N_INTERESTS;
+
+BOOST_FIXTURE_TEST_CASE(ExpressInterest, ExpressInterestFixture)
+{
+  // captures larger than the small-object buffer of std::function, as is typical of applications
+  size_t nData = 0, nNacks = 0, nTimeouts = 0;
+  std::string context("context");
+  DataCallback onData = [&nData, &nNacks, &nTimeouts, context] (const Interest&, const Data&) {
+    ++nData;
+  };
+  NackCallback onNack = [&nData, &nNacks, &nTimeouts, context] (const Interest&, const lp::Nack&) {
+    ++nNacks;
+  };
+  TimeoutCallback onTimeout = [&nData, &nNacks, &nTimeouts, context] (const Interest&) {
+    ++nTimeouts;
+  };
+
+  measure("express", [&] (const Interest& interest) {
+    face.expressInterest(interest, onData, onNack, onTimeout);
+  });
+}
+
+class NullContinuation : public InterestContinuation
+{
+public:
+  void
+  onData(const Interest&, const Data&) final
+  {
+  }
+
+  void
+  onNack(const Interest&, const lp::Nack&) final
+  {
+  }
+
+  void
+  onTimeout(const Interest&) final
+  {
+  }
+};
+
+BOOST_FIXTURE_TEST_CASE(ExpressInterestContinuation, ExpressInterestFixture)
+{
+  NullContinuation continuation;
+  measure("express with continuation", [&] (const Interest& interest) {
+    face.expressInterest(interest, continuation);
+  });
+}
+
+class AnswerInterestFixture : public ExpressInterestFixture
+{
+public:
+  AnswerInterestFixture()
+  {
+    for (const auto& interest : interests) {
+      auto data = make_shared<Data>(interest.getName());
+      keyChain.sign(*data, security::signingWithSha256());
+      data->wireEncode();
+      dataset.push_back(data);
+    }
+
+    // connect the transport
+    face.put(*dataset.front());
+    io.poll();
+  }
+
+  template<typename F>
+  void
+  measure(const std::string& label, const F& onInterest)
+  {
+    face.setInterestFilter("/benchmark", [&] (const InterestFilter&, const Interest& interest) {
+      onInterest(interest);
+    });
+    io.reset();
+    io.poll();
+
+    size_t nSent = transport->nSent;
+    auto d = timedExecute([&] {
+      for (const auto& interest : interests) {
+        transport->receive(interest.wireEncode());
+        io.reset();
+        io.poll();
+      }
+    });
+    BOOST_CHECK_EQUAL(transport->nSent - nSent, N_INTERESTS);
+
+    std::cout << label << " " << N_INTERESTS << " Interests: " << d << std::endl;
+  }
+
+public:
+  std::vector<shared_ptr<Data>> dataset;
+};
+
+BOOST_FIXTURE_TEST_CASE(AnswerFromInterestFilter, AnswerInterestFixture)
+{
+  measure("answer from InterestFilter", [this] (const Interest& interest) {
+    face.put(*dataset.at(interest.getName().at(-1).toNumber()));
+  });
+}
+
+BOOST_FIXTURE_TEST_CASE(AnswerFromContentStore, AnswerInterestFixture)
+{
+  auto cs = make_shared<InMemoryStoragePersistent>();
+  for (const auto& data : dataset) {
+    cs->insert(*data);
+  }
+  face.setContentStore(cs);
+
+  measure("answer from content store", [] (const Interest&) {
+    BOOST_FAIL("Unexpected Interest");
+  });
+}
+
+class ReceiveFixture : public AnswerInterestFixture
+{
+public:
+  /** \brief wrap \p packet in an NDNLPv2 packet with local fields, as a forwarder would send it
+   */
+  static Block
+  makeLpPacket(const Block& packet)
+  {
+    lp::Packet lpPacket(packet);
+    lpPacket.add<lp::IncomingFaceIdField>(256);
+    lpPacket.add<lp::CongestionMarkField>(1);
+    return lpPacket.wireEncode();
+  }
+
+  void
+  measure(const std::string& label, const std::vector<Block>& packets)
+  {
+    size_t nAllocations = g_nAllocations;
+    auto d = timedExecute([&] {
+      for (const auto& packet : packets) {
+        transport->receive(packet);
+      }
+      io.reset();
+      io.poll();
+    });
+    nAllocations = g_nAllocations - nAllocations;
+
+    std::cout << label << " " << packets.size() << " packets: " << d << ", "
+              << static_cast<double>(nAllocations) / packets.size() << " allocations per packet"
+              << std::endl;
+  }
+};
+
+BOOST_FIXTURE_TEST_CASE(ReceiveData, ReceiveFixture)
+{
+  std::vector<Block> packets;
+  for (const auto& data : dataset) {
+    packets.push_back(makeLpPacket(data->wireEncode()));
+  }
+  measure("receive unsolicited Data", packets);
+}
+
+BOOST_FIXTURE_TEST_CASE(ReceiveInterest, ReceiveFixture)
+{
+  size_t nInterests = 0;
+  face.setInterestFilter("/benchmark", [&] (const InterestFilter&, const Interest& interest) {
+    if (interest.getTag<lp::IncomingFaceIdTag>() != nullptr) {
+      ++nInterests;
+    }
+  });
+  io.reset();
+  io.poll();
+
+  std::vector<Block> packets;
+  for (const auto& interest : interests) {
+    packets.push_back(makeLpPacket(interest.wireEncode()));
+  }
+  measure("receive Interest", packets);
+  BOOST_CHECK_EQUAL(nInterests, N_INTERESTS);
+}
+
+} // namespace tests
+} // namespace ndn
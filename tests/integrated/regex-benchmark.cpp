@@ -0,0 +1,119 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MODULE ndn-cxx Regex Benchmark
+#include "tests/boost-test.hpp"
+
+#include "ndn-cxx/util/regex.hpp"
+#include "ndn-cxx/util/regex/regex-compiled-matcher.hpp"
+#include "tests/integrated/timed-execute.hpp"
+
+#include <boost/mpl/vector.hpp>
+
+#include <iostream>
+
+namespace ndn {
+namespace tests {
+
+// Expressions taken from trust schemas and validator configurations in the wild.
+const std::vector<std::string> TRUST_SCHEMA{
+  // hierarchical checker
+  "^(<>*)$",
+  "^(<>*)<KEY><>$",
+  // NFD management
+  "^<localhost><nfd><rib>[<register><unregister>]<>$",
+  "^<localhost><nfd><(faces|fib|strategy-choice)><>*$",
+  // NDN testbed
+  "^<ndn><KEY><>$",
+  "^<ndn><edu><ucla><KEY><ksk-[0-9]+><ID-CERT><>$",
+  "^<ndn>[^<KEY>]*<KEY><ksk-.*><ID-CERT>$",
+  "^<ndn><(.*)\\.(.*)><DNS>(<>*)<>",
+  // application data and its signing keys
+  "^<ndn><edu><ucla>([^<KEY>]*)<chat><>*<%FD.*><%00.*>$",
+  "^(<>*)<KEY><>{1,3}$",
+  "<KEY><>$",
+};
+
+const std::vector<Name> PACKET_NAMES{
+  "/ndn/edu/ucla/alice/chat/room1/%FD%00%00%01i%0F%3C%20/%00%03",
+  "/ndn/edu/ucla/alice/KEY/%BE%FB%B8%7Fe%C9%A9%E3",
+  "/ndn/edu/ucla/KEY/ksk-1449012345678/ID-CERT/%FD%00%00%01Q%3A%06%0E%25",
+  "/ndn/KEY/%1A%B3%D4%92Kb%1E%80",
+  "/localhost/nfd/rib/register/h%0C%07%08%08%02ab%01%02%03/%00%00%01i%0F%3C%20/%E3%86%AC%12",
+  "/localhost/nfd/faces/list",
+  "/ndn/ucla.edu/DNS/yingdi/mac/ksk-1",
+  "/ndn/org/caida/bob/video/conference/%FD%00%00%01i%0F%3C%20/%00%01/%00%00",
+  "/example/data/1",
+};
+
+struct UseRegex
+{
+  using Matcher = Regex;
+  static constexpr const char* NAME = "Regex";
+};
+
+struct UseCompiled
+{
+  using Matcher = RegexCompiledMatcher;
+  static constexpr const char* NAME = "RegexCompiledMatcher";
+};
+
+constexpr const char* UseRegex::NAME;
+constexpr const char* UseCompiled::NAME;
+
+using Matchers = boost::mpl::vector<UseRegex, UseCompiled>;
+
+// Benchmark of matching packet names against every expression of a trust schema, with the
+// backtracking Regex and with RegexCompiledMatcher. Both must report the same number of matches.
+// Run this benchmark with:
+//    ./regex-benchmark -t 'TrustSchema*'
+// For accurate results, it is required to compile ndn-cxx in release mode.
+BOOST_AUTO_TEST_CASE_TEMPLATE(TrustSchema, T, Matchers)
+{
+  const int N_ITERATIONS = 2000;
+
+  std::vector<typename T::Matcher> matchers;
+  auto dCompile = timedExecute([&] {
+    for (const auto& expr : TRUST_SCHEMA) {
+      matchers.emplace_back(expr);
+    }
+  });
+
+  size_t nMatches = 0;
+  auto dMatch = timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      for (auto& matcher : matchers) {
+        for (const auto& name : PACKET_NAMES) {
+          nMatches += matcher.match(name);
+        }
+      }
+    }
+  });
+
+  // every name matches "^(<>*)$", and the other expressions match a few names each
+  BOOST_CHECK_EQUAL(nMatches, N_ITERATIONS * 21);
+  size_t nEvaluations = N_ITERATIONS * TRUST_SCHEMA.size() * PACKET_NAMES.size();
+  std::cout << T::NAME << " compile " << dCompile << ", match " << dMatch << " ("
+            << dMatch.count() / nEvaluations << " ns per match)" << std::endl;
+}
+
+} // namespace tests
+} // namespace ndn
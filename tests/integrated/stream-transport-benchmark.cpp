@@ -0,0 +1,144 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MODULE ndn-cxx Stream Transport Benchmark
+#include "tests/boost-test.hpp"
+
+#include "ndn-cxx/encoding/block-helpers.hpp"
+#include "ndn-cxx/transport/unix-transport.hpp"
+#include "tests/integrated/timed-execute.hpp"
+
+#include <boost/asio/io_service.hpp>
+#include <boost/filesystem.hpp>
+#include <iostream>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace ndn {
+namespace tests {
+
+/** \brief stand-in for a local forwarder, which echoes every octet back on its own thread
+ */
+class EchoForwarder : noncopyable
+{
+public:
+  explicit
+  EchoForwarder(const std::string& path)
+  {
+    ::unlink(path.data());
+    m_listener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.data(), sizeof(addr.sun_path) - 1);
+    BOOST_REQUIRE_EQUAL(::bind(m_listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    BOOST_REQUIRE_EQUAL(::listen(m_listener, 1), 0);
+
+    m_thread = std::thread([this] {
+      int conn = ::accept(m_listener, nullptr, nullptr);
+      uint8_t buf[65536];
+      ssize_t n;
+      while (conn >= 0 && (n = ::read(conn, buf, sizeof(buf))) > 0) {
+        for (ssize_t sent = 0; sent < n; ) {
+          ssize_t m = ::write(conn, buf + sent, n - sent);
+          if (m <= 0) {
+            n = 0;
+            break;
+          }
+          sent += m;
+        }
+      }
+      if (conn >= 0) {
+        ::close(conn);
+      }
+    });
+  }
+
+  ~EchoForwarder()
+  {
+    m_thread.join();
+    ::close(m_listener);
+  }
+
+private:
+  int m_listener;
+  std::thread m_thread;
+};
+
+/** \brief send \p nPackets packets of \p packetSize octets through UnixTransport, keeping
+ *         \p window packets in flight, and wait until all have been echoed back
+ */
+static time::nanoseconds
+measureEcho(size_t nPackets, size_t packetSize, size_t window)
+{
+  std::string path = (boost::filesystem::temp_directory_path() / "ndn-cxx-stream-benchmark.sock").string();
+  EchoForwarder forwarder(path);
+
+  boost::asio::io_service io;
+  UnixTransport transport(path);
+  Block packet = makeStringBlock(tlv::Content, std::string(packetSize - 4, 'x'));
+  size_t nSent = 0;
+  size_t nReceived = 0;
+
+  transport.connect(io, [&] (const Block&) {
+    ++nReceived;
+    if (nSent < nPackets) {
+      transport.send(packet);
+      ++nSent;
+    }
+    else if (nReceived == nPackets) {
+      io.stop();
+    }
+  });
+  transport.resume();
+
+  auto d = timedExecute([&] {
+    for (; nSent < window; ++nSent) {
+      transport.send(packet);
+    }
+    io.run();
+  });
+  transport.close();
+  BOOST_CHECK_EQUAL(nReceived, nPackets);
+  return d;
+}
+
+BOOST_AUTO_TEST_CASE(Echo)
+{
+  const size_t nPackets = 200000;
+  const size_t window = 64;
+
+  for (size_t packetSize : {100, 1000, 8000}) {
+    ::unsetenv("NDN_CLIENT_IO_URING");
+    auto reactor = measureEcho(nPackets, packetSize, window);
+    ::setenv("NDN_CLIENT_IO_URING", "1", 1);
+    auto uring = measureEcho(nPackets, packetSize, window);
+    ::unsetenv("NDN_CLIENT_IO_URING");
+
+    std::cout << "echo " << nPackets << " packets of " << packetSize << " octets, window "
+              << window << ": reactor " << reactor << ", io_uring " << uring << std::endl;
+  }
+}
+
+} // namespace tests
+} // namespace ndn
@@ -22,6 +22,7 @@
 #include "ndn-cxx/detail/tag-host.hpp"
 #include "ndn-cxx/data.hpp"
 #include "ndn-cxx/interest.hpp"
+#include "ndn-cxx/lp/tags.hpp"
 
 #include "tests/boost-test.hpp"
 
@@ -81,6 +82,34 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(Basic, T, Fixtures, T)
   BOOST_CHECK(this->template getTag<TestTag2>() == nullptr);
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(LpTags, T, Fixtures, T)
+{
+  // NDNLPv2 tags are kept in fixed slots, other tags elsewhere
+  this->setTag(make_shared<lp::IncomingFaceIdTag>(1));
+  this->setTag(make_shared<lp::CongestionMarkTag>(2));
+  this->setTag(make_shared<TestTag>());
+
+  BOOST_REQUIRE(this->template getTag<lp::IncomingFaceIdTag>() != nullptr);
+  BOOST_CHECK_EQUAL(*this->template getTag<lp::IncomingFaceIdTag>(), 1);
+  BOOST_REQUIRE(this->template getTag<lp::CongestionMarkTag>() != nullptr);
+  BOOST_CHECK_EQUAL(*this->template getTag<lp::CongestionMarkTag>(), 2);
+  BOOST_CHECK(this->template getTag<lp::NextHopFaceIdTag>() == nullptr);
+  BOOST_CHECK(this->template getTag<TestTag>() != nullptr);
+
+  this->setTag(make_shared<lp::IncomingFaceIdTag>(3));
+  BOOST_CHECK_EQUAL(*this->template getTag<lp::IncomingFaceIdTag>(), 3);
+
+  T copy(*this);
+  this->template removeTag<lp::CongestionMarkTag>();
+  this->template removeTag<TestTag>();
+
+  BOOST_CHECK(this->template getTag<lp::CongestionMarkTag>() == nullptr);
+  BOOST_CHECK(this->template getTag<TestTag>() == nullptr);
+  BOOST_CHECK(copy.template getTag<lp::CongestionMarkTag>() != nullptr);
+  BOOST_CHECK(copy.template getTag<TestTag>() != nullptr);
+  BOOST_CHECK(copy.template getTag<lp::IncomingFaceIdTag>() == this->template getTag<lp::IncomingFaceIdTag>());
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestTagHost
 BOOST_AUTO_TEST_SUITE_END() // Detail
 
@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/encoding/buffer-pool.hpp"
+
+#include "tests/boost-test.hpp"
+
+#include <thread>
+
+namespace ndn {
+namespace encoding {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Encoding)
+
+class BufferPoolFixture
+{
+protected:
+  BufferPoolFixture()
+    : pool(BufferPool::get())
+  {
+    pool.clear();
+  }
+
+  ~BufferPoolFixture()
+  {
+    pool.clear();
+  }
+
+protected:
+  BufferPool& pool;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestBufferPool, BufferPoolFixture)
+
+BOOST_AUTO_TEST_CASE(Allocate)
+{
+  auto buf = pool.allocate(100);
+  BOOST_CHECK_EQUAL(buf->size(), 100);
+  BOOST_CHECK_EQUAL(buf->capacity(), 128);
+  BOOST_CHECK(std::all_of(buf->begin(), buf->end(), [] (uint8_t b) { return b == 0; }));
+
+  const uint8_t bytes[] = {0x01, 0x02, 0x03};
+  auto copy = pool.allocate(bytes, sizeof(bytes));
+  BOOST_CHECK_EQUAL_COLLECTIONS(copy->begin(), copy->end(), bytes, bytes + sizeof(bytes));
+  BOOST_CHECK_EQUAL(copy->capacity(), 64);
+
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Recycle)
+{
+  auto buf = pool.allocate(1000);
+  std::fill(buf->begin(), buf->end(), 0xFF);
+  const uint8_t* storage = buf->data();
+  buf.reset();
+  BOOST_CHECK_EQUAL(pool.size(), 1);
+  BOOST_CHECK_EQUAL(pool.m_idleControlBlocks.size(), 1);
+
+  // same size class reuses the storage and the control block, and the contents are cleared
+  auto buf2 = pool.allocate(600);
+  BOOST_CHECK_EQUAL(buf2->data(), storage);
+  BOOST_CHECK_EQUAL(buf2->size(), 600);
+  BOOST_CHECK(std::all_of(buf2->begin(), buf2->end(), [] (uint8_t b) { return b == 0; }));
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+  BOOST_CHECK_EQUAL(pool.m_idleControlBlocks.size(), 0);
+
+  // a different size class does not
+  buf2.reset();
+  auto buf3 = pool.allocate(10);
+  BOOST_CHECK_NE(buf3->data(), storage);
+  BOOST_CHECK_EQUAL(pool.size(), 1);
+
+  pool.clear();
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+  BOOST_CHECK_EQUAL(pool.m_idleControlBlocks.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(NotPooled)
+{
+  // larger than the largest size class
+  auto big = pool.allocate(MAX_NDN_PACKET_SIZE + 1);
+  BOOST_CHECK_EQUAL(big->size(), MAX_NDN_PACKET_SIZE + 1);
+  big.reset();
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+
+  // grown by the user past the largest size class
+  auto grown = pool.allocate(64);
+  grown->resize(MAX_NDN_PACKET_SIZE + 1);
+  grown.reset();
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(MaxIdle)
+{
+  std::vector<shared_ptr<Buffer>> buffers;
+  for (size_t i = 0; i < BufferPool::MAX_IDLE_PER_CLASS + 5; ++i) {
+    buffers.push_back(pool.allocate(200));
+  }
+  buffers.clear();
+  BOOST_CHECK_EQUAL(pool.size(), BufferPool::MAX_IDLE_PER_CLASS);
+}
+
+BOOST_AUTO_TEST_CASE(CrossThread)
+{
+  shared_ptr<Buffer> buf;
+  std::thread([&buf] { buf = BufferPool::get().allocate(100); }).join();
+  BOOST_REQUIRE(buf != nullptr);
+  BOOST_CHECK_EQUAL(buf->size(), 100);
+
+  // released into the pool of the thread that drops the last reference
+  buf.reset();
+  BOOST_CHECK_EQUAL(pool.size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestBufferPool
+BOOST_AUTO_TEST_SUITE_END() // Encoding
+
+} // namespace tests
+} // namespace encoding
+} // namespace ndn
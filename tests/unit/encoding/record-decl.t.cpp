@@ -0,0 +1,209 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/encoding/record-decl.hpp"
+#include "ndn-cxx/name.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace ndn {
+namespace encoding {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Encoding)
+BOOST_AUTO_TEST_SUITE(TestRecordDecl)
+
+enum class Color {
+  RED = 1,
+  BLUE = 2,
+};
+
+struct Item
+{
+  Name name;
+  std::string label;
+  optional<time::milliseconds> period;
+  Color color = Color::RED;
+  std::vector<uint64_t> values;
+};
+
+using ItemSchema = RecordDecl<200,
+  NDN_CXX_RECORD_FIELD(tlv::Name, NestedTag, &Item::name),
+  NDN_CXX_RECORD_FIELD(201, StringTag, &Item::label),
+  NDN_CXX_RECORD_FIELD(202, NonNegativeIntegerTag, &Item::period),
+  NDN_CXX_RECORD_FIELD(203, NonNegativeIntegerTag, &Item::color),
+  NDN_CXX_RECORD_FIELD(204, NonNegativeIntegerTag, &Item::values)>;
+
+struct Counter
+{
+  uint64_t value = 0;
+  std::string label;
+};
+
+using CounterSchema = RecordDecl<210,
+  NDN_CXX_RECORD_FIELD(0x1234, NonNegativeIntegerTag, &Counter::value),
+  NDN_CXX_RECORD_FIELD(211, StringTag, &Counter::label)>;
+
+BOOST_AUTO_TEST_CASE(Encode)
+{
+  Item item;
+  item.name = "/A";
+  item.label = "L";
+  item.period = 300_ms;
+  item.color = Color::BLUE;
+  item.values = {1, 2};
+
+  static const uint8_t expected[] = {
+    0xc8, 0x15,
+          0x07, 0x03, 0x08, 0x01, 0x41,
+          0xc9, 0x01, 0x4c,
+          0xca, 0x02, 0x01, 0x2c,
+          0xcb, 0x01, 0x02,
+          0xcc, 0x01, 0x01,
+          0xcc, 0x01, 0x02,
+  };
+  Block wire = ItemSchema::encode(item);
+  BOOST_CHECK_EQUAL_COLLECTIONS(wire.begin(), wire.end(), expected, expected + sizeof(expected));
+
+  EncodingEstimator estimator;
+  BOOST_CHECK_EQUAL(ItemSchema::encode(estimator, item), sizeof(expected));
+
+  item.period = nullopt;
+  item.values.clear();
+  wire = ItemSchema::encode(item);
+  BOOST_CHECK_EQUAL(wire.value_size(), 11);
+}
+
+BOOST_AUTO_TEST_CASE(EncodeNonNegativeInteger)
+{
+  // the fixed-width fast path must agree with prependNonNegativeIntegerBlock
+  const uint32_t types[] = {1, 252, 253, 0xFFFF, 0x10000, 0xFFFFFFFF};
+  const uint64_t values[] = {0, 0xFF, 0x100, 0xFFFF, 0x10000, 0xFFFFFFFF, 0x100000000,
+                             std::numeric_limits<uint64_t>::max()};
+  for (uint32_t type : types) {
+    for (uint64_t value : values) {
+      BOOST_TEST_CONTEXT("type=" << type << " value=" << value) {
+        EncodingBuffer expected;
+        prependNonNegativeIntegerBlock(expected, type, value);
+
+        EncodingEstimator estimator;
+        BOOST_CHECK_EQUAL(FieldCodec<NonNegativeIntegerTag>::prepend(estimator, type, value),
+                          expected.size());
+
+        EncodingBuffer actual;
+        BOOST_CHECK_EQUAL(FieldCodec<NonNegativeIntegerTag>::prepend(actual, type, value),
+                          expected.size());
+        BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Decode)
+{
+  static const uint8_t input[] = {
+    0xc8, 0x11,
+          0x07, 0x03, 0x08, 0x01, 0x41,
+          0xc9, 0x01, 0x4c,
+          0xcb, 0x01, 0x02,
+          0xcc, 0x01, 0x07,
+          0xcc, 0x01, 0x08,
+  };
+  Item item;
+  item.period = 1_s;
+  ItemSchema::decode<tlv::Error>(Block(input, sizeof(input)), item);
+  BOOST_CHECK_EQUAL(item.name, "/A");
+  BOOST_CHECK_EQUAL(item.label, "L");
+  BOOST_CHECK(!item.period);
+  BOOST_CHECK(item.color == Color::BLUE);
+  BOOST_CHECK_EQUAL(item.values.size(), 2);
+  BOOST_CHECK_EQUAL(item.values.at(0), 7);
+  BOOST_CHECK_EQUAL(item.values.at(1), 8);
+
+  // unrecognized elements after a non-repeated last field are ignored
+  static const uint8_t counterInput[] = {
+    0xd2, 0x0c,
+          0xfd, 0x12, 0x34, 0x01, 0x05,
+          0xd3, 0x01, 0x43,
+          0xfd, 0x01, 0x00, 0x00, // unrecognized trailing element
+  };
+  Counter counter;
+  CounterSchema::decode<tlv::Error>(Block(counterInput, sizeof(counterInput)), counter);
+  BOOST_CHECK_EQUAL(counter.value, 5);
+  BOOST_CHECK_EQUAL(counter.label, "C");
+}
+
+BOOST_AUTO_TEST_CASE(DecodeError)
+{
+  Item item;
+
+  static const uint8_t wrongType[] = {0xc9, 0x00};
+  BOOST_CHECK_THROW(ItemSchema::decode<tlv::Error>(Block(wrongType, sizeof(wrongType)), item),
+                    tlv::Error);
+
+  static const uint8_t missingLabel[] = {
+    0xc8, 0x08,
+          0x07, 0x03, 0x08, 0x01, 0x41,
+          0xcb, 0x01, 0x02,
+  };
+  BOOST_CHECK_THROW(ItemSchema::decode<tlv::Error>(Block(missingLabel, sizeof(missingLabel)), item),
+                    tlv::Error);
+
+  // an unexpected element between occurrences of the repeated last field
+  static const uint8_t unexpectedElement[] = {
+    0xc8, 0x12,
+          0x07, 0x03, 0x08, 0x01, 0x41,
+          0xc9, 0x01, 0x4c,
+          0xcc, 0x01, 0x07,
+          0xfd, 0x01, 0x00, 0x00,
+          0xcc, 0x01, 0x08,
+  };
+  BOOST_CHECK_THROW(ItemSchema::decode<tlv::Error>(Block(unexpectedElement, sizeof(unexpectedElement)),
+                                                   item),
+                    tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(DecodeFailureLeavesRecordUnchanged)
+{
+  Item item;
+  item.name = "/Z";
+  item.label = "Z";
+  item.values = {9};
+
+  static const uint8_t malformedColor[] = {
+    0xc8, 0x0d,
+          0x07, 0x03, 0x08, 0x01, 0x41,
+          0xc9, 0x01, 0x4c,
+          0xcb, 0x03, 0x01, 0x02, 0x03, // invalid nonNegativeInteger length
+  };
+  BOOST_CHECK_THROW(ItemSchema::decode<tlv::Error>(Block(malformedColor, sizeof(malformedColor)), item),
+                    tlv::Error);
+  BOOST_CHECK_EQUAL(item.name, "/Z");
+  BOOST_CHECK_EQUAL(item.label, "Z");
+  BOOST_CHECK_EQUAL(item.values.size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestRecordDecl
+BOOST_AUTO_TEST_SUITE_END() // Encoding
+
+} // namespace tests
+} // namespace encoding
+} // namespace ndn
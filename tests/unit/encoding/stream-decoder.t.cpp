@@ -0,0 +1,157 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/encoding/stream-decoder.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace ndn {
+namespace encoding {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Encoding)
+
+class StreamDecoderFixture
+{
+protected:
+  void
+  decode(const uint8_t* buf, size_t size)
+  {
+    decoder.decode(buf, size, [this] (const Block& element) { elements.push_back(element); });
+  }
+
+protected:
+  StreamDecoder decoder;
+  std::vector<Block> elements;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestStreamDecoder, StreamDecoderFixture)
+
+BOOST_AUTO_TEST_CASE(WholeElements)
+{
+  const uint8_t stream[] = {
+    0x01, 0x02, 0xaa, 0xbb,
+    0x02, 0x00,
+    0x03, 0x01, 0xcc,
+  };
+  decode(stream, sizeof(stream));
+
+  BOOST_REQUIRE_EQUAL(elements.size(), 3);
+  BOOST_CHECK_EQUAL(elements[0].type(), 0x01);
+  BOOST_CHECK_EQUAL(elements[0].value_size(), 2);
+  BOOST_CHECK_EQUAL_COLLECTIONS(elements[0].begin(), elements[0].end(), stream, stream + 4);
+  BOOST_CHECK_EQUAL(elements[1].type(), 0x02);
+  BOOST_CHECK_EQUAL(elements[1].value_size(), 0);
+  BOOST_CHECK_EQUAL(elements[1].size(), 2);
+  BOOST_CHECK_EQUAL(elements[2].type(), 0x03);
+  BOOST_CHECK_EQUAL(*elements[2].value(), 0xcc);
+  BOOST_CHECK_EQUAL(decoder.getReceivedSize(), 0);
+  BOOST_CHECK(!decoder.getExpectedSize());
+}
+
+BOOST_AUTO_TEST_CASE(OctetByOctet)
+{
+  std::vector<uint8_t> stream{0xfd, 0x01, 0x00, 0xfd, 0x01, 0x2c}; // TLV-TYPE 256, TLV-LENGTH 300
+  for (int i = 0; i < 300; ++i) {
+    stream.push_back(static_cast<uint8_t>(i));
+  }
+  stream.insert(stream.end(), {0x05, 0x01, 0xff});
+
+  for (size_t i = 0; i < stream.size(); ++i) {
+    decode(&stream[i], 1);
+    if (i < 5) {
+      BOOST_CHECK(!decoder.getExpectedSize());
+      BOOST_CHECK_EQUAL(decoder.getReceivedSize(), i + 1);
+    }
+    else if (i < 305) {
+      BOOST_CHECK_EQUAL(decoder.getExpectedSize().value(), 306);
+      BOOST_CHECK_EQUAL(elements.size(), 0);
+    }
+  }
+
+  BOOST_REQUIRE_EQUAL(elements.size(), 2);
+  BOOST_CHECK_EQUAL(elements[0].type(), 256);
+  BOOST_CHECK_EQUAL(elements[0].value_size(), 300);
+  BOOST_CHECK_EQUAL_COLLECTIONS(elements[0].begin(), elements[0].end(),
+                                stream.begin(), stream.begin() + 306);
+  BOOST_CHECK_EQUAL(elements[1].type(), 0x05);
+}
+
+BOOST_AUTO_TEST_CASE(SplitChunks)
+{
+  const uint8_t stream[] = {
+    0x06, 0x05, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x07, 0x03, 0x0a, 0x0b, 0x0c,
+  };
+  decode(stream, 3);
+  BOOST_CHECK_EQUAL(elements.size(), 0);
+  BOOST_CHECK_EQUAL(decoder.getExpectedSize().value(), 7);
+  BOOST_CHECK_EQUAL(decoder.getReceivedSize(), 3);
+
+  // completes the first element and starts the second
+  decode(stream + 3, 6);
+  BOOST_REQUIRE_EQUAL(elements.size(), 1);
+  BOOST_CHECK_EQUAL_COLLECTIONS(elements[0].begin(), elements[0].end(), stream, stream + 7);
+  BOOST_CHECK_EQUAL(decoder.getExpectedSize().value(), 5);
+
+  decode(stream + 9, 3);
+  BOOST_REQUIRE_EQUAL(elements.size(), 2);
+  BOOST_CHECK_EQUAL_COLLECTIONS(elements[1].begin(), elements[1].end(), stream + 7, stream + 12);
+}
+
+BOOST_AUTO_TEST_CASE(Reset)
+{
+  const uint8_t partial[] = {0x06, 0x05, 0x01};
+  decode(partial, sizeof(partial));
+  decoder.reset();
+  BOOST_CHECK_EQUAL(decoder.getReceivedSize(), 0);
+
+  const uint8_t stream[] = {0x08, 0x01, 0x01};
+  decode(stream, sizeof(stream));
+  BOOST_REQUIRE_EQUAL(elements.size(), 1);
+  BOOST_CHECK_EQUAL(elements[0].type(), 0x08);
+}
+
+BOOST_AUTO_TEST_CASE(Errors)
+{
+  const uint8_t zeroType[] = {0x00, 0x01, 0x01};
+  BOOST_CHECK_THROW(decode(zeroType, sizeof(zeroType)), StreamDecoder::Error);
+
+  const uint8_t hugeType[] = {0xff, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00};
+  BOOST_CHECK_THROW(decode(hugeType, sizeof(hugeType)), StreamDecoder::Error);
+
+  StreamDecoder smallDecoder(8);
+  const uint8_t tooLong[] = {0x06, 0x07};
+  BOOST_CHECK_THROW(smallDecoder.decode(tooLong, sizeof(tooLong), [] (const Block&) {}),
+                    StreamDecoder::Error);
+
+  // decoder is usable after an error
+  const uint8_t stream[] = {0x08, 0x00};
+  decode(stream, sizeof(stream));
+  BOOST_CHECK_EQUAL(elements.size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestStreamDecoder
+BOOST_AUTO_TEST_SUITE_END() // Encoding
+
+} // namespace tests
+} // namespace encoding
+} // namespace ndn
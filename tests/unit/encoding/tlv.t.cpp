@@ -434,6 +434,51 @@ BOOST_AUTO_TEST_CASE(Read)
 
 BOOST_AUTO_TEST_SUITE_END() // Type
 
+BOOST_AUTO_TEST_CASE(ScanElementHeaders)
+{
+  std::vector<uint8_t> wire{
+    0x01, 0x00,                         // type=1, length=0
+    0xfd, 0x01, 0x00, 0x02, 0xaa, 0xbb, // type=256, length=2
+    0x07, 0xfd, 0x00, 0x14,             // type=7, length=20
+  };
+  wire.resize(wire.size() + 20, 0xcc);
+  wire.insert(wire.end(), {0x08, 0x05, 0x01}); // truncated
+
+  ElementHeader headers[4];
+  BOOST_REQUIRE_EQUAL(scanElementHeaders(wire.data(), wire.size(), headers, 4), 3);
+  BOOST_CHECK_EQUAL(headers[0].type, 1);
+  BOOST_CHECK_EQUAL(headers[0].size, 2);
+  BOOST_CHECK_EQUAL(headers[0].length, 0);
+  BOOST_CHECK_EQUAL(headers[0].offset, 0);
+  BOOST_CHECK_EQUAL(headers[1].type, 256);
+  BOOST_CHECK_EQUAL(headers[1].size, 4);
+  BOOST_CHECK_EQUAL(headers[1].length, 2);
+  BOOST_CHECK_EQUAL(headers[1].offset, 2);
+  BOOST_CHECK_EQUAL(headers[2].type, 7);
+  BOOST_CHECK_EQUAL(headers[2].size, 4);
+  BOOST_CHECK_EQUAL(headers[2].length, 20);
+  BOOST_CHECK_EQUAL(headers[2].offset, 8);
+
+  // limited by capacity
+  BOOST_CHECK_EQUAL(scanElementHeaders(wire.data(), wire.size(), headers, 2), 2);
+  // short buffer, decoded without the unchecked path
+  BOOST_CHECK_EQUAL(scanElementHeaders(wire.data(), 8, headers, 4), 2);
+  BOOST_CHECK_EQUAL(scanElementHeaders(wire.data(), 7, headers, 4), 1);
+  BOOST_CHECK_EQUAL(scanElementHeaders(wire.data(), 0, headers, 4), 0);
+
+  // illegal TLV-TYPE
+  static const uint8_t zeroType[] = {0x01, 0x00, 0x00, 0x00};
+  BOOST_CHECK_EQUAL(scanElementHeaders(zeroType, sizeof(zeroType), headers, 4), 1);
+  std::vector<uint8_t> hugeType{0xff, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00};
+  hugeType.resize(32);
+  BOOST_CHECK_EQUAL(scanElementHeaders(hugeType.data(), hugeType.size(), headers, 4), 0);
+
+  // TLV-LENGTH exceeds buffer
+  std::vector<uint8_t> longLength{0x01, 0xfe, 0x00, 0x01, 0x00, 0x00};
+  longLength.resize(32);
+  BOOST_CHECK_EQUAL(scanElementHeaders(longLength.data(), longLength.size(), headers, 4), 0);
+}
+
 BOOST_AUTO_TEST_SUITE(NonNegativeInteger)
 
 // This check ensures readNonNegativeInteger only requires InputIterator concept and nothing more.
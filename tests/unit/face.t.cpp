@@ -20,6 +20,7 @@
  */
 
 #include "ndn-cxx/face.hpp"
+#include "ndn-cxx/ims/in-memory-storage-persistent.hpp"
 #include "ndn-cxx/lp/tags.hpp"
 #include "ndn-cxx/transport/tcp-transport.hpp"
 #include "ndn-cxx/transport/unix-transport.hpp"
@@ -30,8 +31,12 @@
 #include "tests/make-interest-data.hpp"
 #include "tests/unit/identity-management-time-fixture.hpp"
 
+#include <boost/lexical_cast.hpp>
 #include <boost/logic/tribool.hpp>
 
+#include <atomic>
+#include <thread>
+
 namespace ndn {
 namespace tests {
 
@@ -341,6 +346,123 @@ BOOST_AUTO_TEST_CASE(DataCallbackPutData) // Bug 4596
   BOOST_CHECK_EQUAL(face.sentData.back().getName(), "/chronosync/sampleDigest/1");
 }
 
+BOOST_AUTO_TEST_CASE(ExpressInterests)
+{
+  std::vector<Interest> interests;
+  for (int i = 0; i < 5; ++i) {
+    interests.push_back(*makeInterest(Name("/A").appendNumber(i), false, 50_ms));
+  }
+  interests[2].setTag(make_shared<lp::NextHopFaceIdTag>(1000));
+
+  std::vector<Name> satisfied;
+  size_t nTimeouts = 0;
+  auto handles = face.expressInterests(interests,
+                                       [&] (const Interest& i, const Data&) {
+                                         satisfied.push_back(i.getName());
+                                       },
+                                       bind([] { BOOST_FAIL("Unexpected Nack"); }),
+                                       bind([&nTimeouts] { ++nTimeouts; }));
+  BOOST_REQUIRE_EQUAL(handles.size(), 5);
+
+  advanceClocks(1_ms);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 5);
+  for (int i = 0; i < 5; ++i) {
+    BOOST_CHECK_EQUAL(face.sentInterests[i].getName(), interests[i].getName());
+  }
+  BOOST_CHECK(face.sentInterests[2].getTag<lp::NextHopFaceIdTag>() != nullptr);
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 5);
+
+  handles[4].cancel();
+  face.receive(*makeData("/A/%01"));
+  face.receive(*makeData("/A/%03"));
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(satisfied.size(), 2);
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 2);
+
+  advanceClocks(10_ms, 5);
+  BOOST_CHECK_EQUAL(nTimeouts, 2);
+
+  BOOST_CHECK(face.expressInterests({}, nullptr, nullptr, nullptr).empty());
+}
+
+class RecordingContinuation : public InterestContinuation
+{
+public:
+  void
+  onData(const Interest& interest, const Data& data) final
+  {
+    outcomes.push_back("data " + interest.getName().toUri() + " " + data.getName().toUri());
+  }
+
+  void
+  onNack(const Interest& interest, const lp::Nack& nack) final
+  {
+    outcomes.push_back("nack " + interest.getName().toUri() + " " +
+                       boost::lexical_cast<std::string>(nack.getReason()));
+  }
+
+  void
+  onTimeout(const Interest& interest) final
+  {
+    outcomes.push_back("timeout " + interest.getName().toUri());
+  }
+
+  void
+  onCancel(const Interest& interest) final
+  {
+    outcomes.push_back("cancel " + interest.getName().toUri());
+  }
+
+public:
+  std::vector<std::string> outcomes;
+};
+
+BOOST_AUTO_TEST_CASE(ExpressInterestContinuation)
+{
+  RecordingContinuation cont;
+  face.expressInterest(*makeInterest("/A", true, 50_ms), cont);
+  face.expressInterest(*makeInterest("/B", false, 50_ms), cont);
+  face.expressInterest(*makeInterest("/C", false, 50_ms), cont);
+  auto hdl = face.expressInterest(*makeInterest("/D", false, 50_ms), cont);
+
+  advanceClocks(1_ms);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 4);
+  hdl.cancel();
+
+  face.receive(*makeData("/A/1"));
+  face.receive(makeNack(face.sentInterests.at(1), lp::NackReason::NO_ROUTE));
+  advanceClocks(10_ms, 10);
+
+  std::vector<std::string> expected{"data /A /A/1", "nack /B NoRoute", "timeout /C"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(cont.outcomes.begin(), cont.outcomes.end(),
+                                expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(CancelContinuation)
+{
+  RecordingContinuation cont;
+  face.expressInterest(*makeInterest("/A", false, 50_ms), cont);
+  face.expressInterest(*makeInterest("/A", false, 50_ms), cont); // aggregated with the first one
+  face.expressInterest(*makeInterest("/B", false, 50_ms), [] (const Interest&, const Data&) {},
+                       nullptr, [] (const Interest&) { BOOST_ERROR("unexpected timeout"); });
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 3);
+
+  face.removeAllPendingInterests();
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 0);
+
+  face.expressInterest(*makeInterest("/C", false, 50_ms), cont);
+  advanceClocks(1_ms);
+  face.shutdown();
+  advanceClocks(10_ms, 10);
+
+  std::vector<std::string> expected{"cancel /A", "cancel /A", "cancel /C"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(cont.outcomes.begin(), cont.outcomes.end(),
+                                expected.begin(), expected.end());
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Consumer
 
 BOOST_AUTO_TEST_SUITE(Producer)
@@ -367,6 +489,29 @@ BOOST_AUTO_TEST_CASE(PutData)
   BOOST_CHECK(face.sentData[1].getTag<lp::CongestionMarkTag>() != nullptr);
 }
 
+BOOST_AUTO_TEST_CASE(PutBatch)
+{
+  std::vector<Data> data;
+  for (int i = 0; i < 3; ++i) {
+    data.push_back(*makeData(Name("/B").appendNumber(i)));
+  }
+  data[1].setTag(make_shared<lp::CongestionMarkTag>(1));
+
+  bool hasData = false;
+  face.expressInterest(*makeInterest("/B/%00"),
+                       bind([&] { hasData = true; }), nullptr, nullptr);
+  advanceClocks(1_ms);
+
+  face.putBatch(data);
+  advanceClocks(1_ms);
+  BOOST_CHECK(hasData);
+  // the Data satisfying the Interest expressed by the application is not sent to the forwarder
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 2);
+  BOOST_CHECK_EQUAL(face.sentData[0].getName(), "/B/%01");
+  BOOST_CHECK(face.sentData[0].getTag<lp::CongestionMarkTag>() != nullptr);
+  BOOST_CHECK_EQUAL(face.sentData[1].getName(), "/B/%02");
+}
+
 BOOST_AUTO_TEST_CASE(PutDataLoopback)
 {
   bool hasInterest1 = false, hasData = false;
@@ -395,6 +540,77 @@ BOOST_AUTO_TEST_CASE(PutDataLoopback)
   BOOST_CHECK_EQUAL(face.sentData.size(), 0); // do not spill Data to forwarder
 }
 
+BOOST_AUTO_TEST_CASE(ContentStore)
+{
+  auto cs = make_shared<InMemoryStoragePersistent>(face.getIoService());
+  cs->insert(*makeData("/A/0"));
+  face.setContentStore(cs);
+
+  size_t nInterests = 0;
+  face.setInterestFilter("/A", bind([&nInterests] { ++nInterests; }));
+  advanceClocks(10_ms);
+
+  // answered from the content store
+  face.receive(*makeInterest("/A/0", false));
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(nInterests, 0);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+  BOOST_CHECK_EQUAL(face.sentData.back().getName(), "/A/0");
+
+  // a miss is dispatched to the InterestFilter, and the Data put in response is cached
+  face.receive(*makeInterest("/A/1", false));
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(nInterests, 1);
+  face.put(*makeData("/A/1"));
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(face.sentData.size(), 2);
+  BOOST_CHECK_EQUAL(cs->size(), 2);
+
+  face.receive(*makeInterest("/A", true));
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(nInterests, 1);
+  BOOST_CHECK_EQUAL(face.sentData.size(), 3);
+
+  // Data with NO_CACHE policy is not cached
+  auto data = makeData("/A/2");
+  lp::CachePolicy cachePolicy;
+  cachePolicy.setPolicy(lp::CachePolicyType::NO_CACHE);
+  data->setTag(make_shared<lp::CachePolicyTag>(cachePolicy));
+  face.put(*data);
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(cs->size(), 2);
+
+  // MustBeFresh is answered from the content store only within the FreshnessPeriod
+  auto freshData = makeData("/A/3");
+  freshData->setFreshnessPeriod(100_ms);
+  signData(freshData);
+  face.put(*freshData);
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(cs->size(), 3);
+
+  face.receive(makeInterest("/A/3", false)->setMustBeFresh(true));
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(nInterests, 1);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 6);
+  BOOST_CHECK_EQUAL(face.sentData.back().getName(), "/A/3");
+
+  advanceClocks(10_ms, 10);
+  face.receive(makeInterest("/A/3", false)->setMustBeFresh(true));
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(nInterests, 2);
+  BOOST_CHECK_EQUAL(face.sentData.size(), 6);
+
+  face.receive(*makeInterest("/A/3", false));
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(nInterests, 2);
+  BOOST_CHECK_EQUAL(face.sentData.size(), 7);
+
+  face.setContentStore(nullptr);
+  face.receive(*makeInterest("/A/0", false));
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(nInterests, 3);
+}
+
 BOOST_AUTO_TEST_CASE(PutMultipleData)
 {
   bool hasInterest1 = false;
@@ -813,8 +1029,260 @@ BOOST_AUTO_TEST_CASE(DestroyWithoutProcessEvents) // Bug 3248
   BOOST_CHECK(true);
 }
 
+BOOST_AUTO_TEST_CASE(ReceiveRetainedData)
+{
+  std::vector<shared_ptr<const Data>> retained;
+  for (const char* name : {"/A/1", "/A/2", "/A/3"}) {
+    face.expressInterest(*makeInterest(name, false, 50_ms),
+                         [&] (const Interest&, const Data& d) { retained.push_back(d.shared_from_this()); },
+                         nullptr, nullptr);
+  }
+  advanceClocks(1_ms);
+
+  // received Data objects are recycled unless a callback keeps a reference to them
+  for (const char* name : {"/A/1", "/A/2", "/A/3"}) {
+    auto data = makeData(name);
+    data->setTag(make_shared<lp::IncomingFaceIdTag>(1));
+    face.receive(*data);
+  }
+  advanceClocks(1_ms);
+
+  BOOST_REQUIRE_EQUAL(retained.size(), 3);
+  BOOST_CHECK_EQUAL(retained[0]->getName(), "/A/1");
+  BOOST_CHECK_EQUAL(retained[1]->getName(), "/A/2");
+  BOOST_CHECK_EQUAL(retained[2]->getName(), "/A/3");
+  for (const auto& data : retained) {
+    BOOST_REQUIRE(data->getTag<lp::IncomingFaceIdTag>() != nullptr);
+    BOOST_CHECK_EQUAL(*data->getTag<lp::IncomingFaceIdTag>(), 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ReceiveRecycledInterest)
+{
+  std::vector<uint64_t> faceIds;
+  std::vector<bool> hasCongestionMark;
+  face.setInterestFilter("/A", [&] (const InterestFilter&, const Interest& i) {
+    auto tag = i.getTag<lp::IncomingFaceIdTag>();
+    faceIds.push_back(tag == nullptr ? 0 : tag->get());
+    hasCongestionMark.push_back(i.getTag<lp::CongestionMarkTag>() != nullptr);
+    face.put(*makeData(i.getName()));
+  });
+  advanceClocks(1_ms);
+
+  auto interest = makeInterest("/A/1");
+  interest->setTag(make_shared<lp::IncomingFaceIdTag>(7));
+  interest->setTag(make_shared<lp::CongestionMarkTag>(1));
+  face.receive(*interest);
+  face.receive(*makeInterest("/A/2")); // tags of the previous Interest must not leak
+  interest = makeInterest("/A/3");
+  interest->setTag(make_shared<lp::IncomingFaceIdTag>(8));
+  face.receive(*interest);
+  advanceClocks(1_ms);
+
+  BOOST_CHECK_EQUAL(face.sentData.size(), 3);
+  BOOST_CHECK((faceIds == std::vector<uint64_t>{7, 0, 8}));
+  BOOST_CHECK((hasCongestionMark == std::vector<bool>{true, false, false}));
+}
+
 BOOST_AUTO_TEST_SUITE_END() // IoRoutines
 
+BOOST_AUTO_TEST_SUITE(Aggregation)
+
+BOOST_AUTO_TEST_CASE(SatisfyAggregated)
+{
+  face.enableInterestAggregation();
+
+  std::vector<std::string> outcomes;
+  auto express = [&] (const std::string& label, const Interest& interest) {
+    return face.expressInterest(interest,
+                                [&outcomes, label] (const Interest&, const Data&) {
+                                  outcomes.push_back(label + " data");
+                                },
+                                bind([] { BOOST_FAIL("Unexpected Nack"); }),
+                                [&outcomes, label] (const Interest&) {
+                                  outcomes.push_back(label + " timeout");
+                                });
+  };
+
+  express("a", *makeInterest("/A", true, 1_s));
+  express("b", *makeInterest("/A", true, 500_ms)); // aggregated with a
+  express("c", *makeInterest("/A", false, 500_ms)); // differs in CanBePrefix
+  express("d", *makeInterest("/A", true, 2_s)); // expires after a
+  auto e = *makeInterest("/A", true, 500_ms);
+  e.setTag(make_shared<lp::NextHopFaceIdTag>(1000)); // differs in NextHopFaceId
+  express("e", e);
+  express("f", *makeInterest("/B", true, 500_ms));
+
+  advanceClocks(1_ms);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 5);
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 6);
+
+  face.receive(*makeData("/A/1"));
+  advanceClocks(1_ms);
+  std::vector<std::string> expected{"a data", "b data", "d data", "e data"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(outcomes.begin(), outcomes.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 2);
+
+  // after a is satisfied, an identical Interest is forwarded again
+  express("g", *makeInterest("/A", true, 500_ms));
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 6);
+}
+
+BOOST_AUTO_TEST_CASE(NackAggregated)
+{
+  face.enableInterestAggregation();
+
+  int nNacks = 0;
+  for (int i = 0; i < 3; ++i) {
+    face.expressInterest(*makeInterest("/A", false, 1_s - i * 100_ms),
+                         bind([] { BOOST_FAIL("Unexpected Data"); }),
+                         [&] (const Interest&, const lp::Nack& nack) {
+                           BOOST_CHECK_EQUAL(nack.getReason(), lp::NackReason::NO_ROUTE);
+                           ++nNacks;
+                         },
+                         bind([] { BOOST_FAIL("Unexpected timeout"); }));
+  }
+  advanceClocks(1_ms);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 1);
+
+  face.receive(makeNack(face.sentInterests.at(0), lp::NackReason::NO_ROUTE));
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(nNacks, 3);
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(CancelLeader)
+{
+  face.enableInterestAggregation();
+
+  std::vector<std::string> outcomes;
+  auto express = [&] (const std::string& label, time::milliseconds lifetime) {
+    return face.expressInterest(*makeInterest("/A", false, lifetime),
+                                [&outcomes, label] (const Interest&, const Data&) {
+                                  outcomes.push_back(label + " data");
+                                },
+                                nullptr,
+                                [&outcomes, label] (const Interest&) {
+                                  outcomes.push_back(label + " timeout");
+                                });
+  };
+
+  auto a = express("a", 1_s);
+  express("b", 200_ms);
+  express("c", 800_ms);
+  advanceClocks(1_ms);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 1);
+
+  // c expires last, so it replaces a
+  a.cancel();
+  advanceClocks(1_ms);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 2);
+  BOOST_CHECK_EQUAL(face.sentInterests.back().getInterestLifetime(), 800_ms);
+
+  advanceClocks(100_ms, 3);
+  face.receive(*makeData("/A"));
+  advanceClocks(1_ms);
+  std::vector<std::string> expected{"b timeout", "c data"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(outcomes.begin(), outcomes.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Aggregation
+
+BOOST_AUTO_TEST_SUITE(MultiThreading)
+
+BOOST_AUTO_TEST_CASE(ExpressInterestFromThreads)
+{
+  face.enableMultiThreading();
+
+  const int nThreads = 4;
+  const int nInterestsPerThread = 100;
+  std::atomic<int> nStarted{0};
+  std::atomic<int> nFinished{0};
+  std::atomic<bool> hasProcessed{false};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < nThreads; ++t) {
+    threads.emplace_back([&, t] {
+      ++nStarted;
+      for (int i = 0; i < nInterestsPerThread; ++i) {
+        if (i == nInterestsPerThread / 2) {
+          // the second half is submitted while the I/O thread is processing the first half
+          while (!hasProcessed) {
+            std::this_thread::yield();
+          }
+        }
+        face.expressInterest(*makeInterest(Name("/A").appendNumber(t).appendNumber(i), false, 1_s),
+                             nullptr, nullptr, nullptr);
+      }
+      ++nFinished;
+    });
+  }
+
+  // run the event loop while the producers are live
+  while (nStarted < nThreads) {
+    std::this_thread::yield();
+  }
+  while (nFinished < nThreads ||
+         face.sentInterests.size() < static_cast<size_t>(nThreads * nInterestsPerThread)) {
+    face.processEvents(-1_ms);
+    if (!face.sentInterests.empty()) {
+      hasProcessed = true;
+    }
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), nThreads * nInterestsPerThread);
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), nThreads * nInterestsPerThread);
+}
+
+BOOST_AUTO_TEST_CASE(CallbackExecutor)
+{
+  std::vector<function<void()>> tasks;
+  face.enableMultiThreading([&tasks] (const function<void()>& task) { tasks.push_back(task); });
+
+  face.setInterestFilter("/A", [this] (const InterestFilter&, const Interest& interest) {
+    face.put(*makeData(interest.getName()));
+  });
+  advanceClocks(1_ms);
+
+  face.receive(*makeInterest("/A/1"));
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(face.sentData.size(), 0);
+  BOOST_REQUIRE_EQUAL(tasks.size(), 1);
+
+  // the callback runs on a worker thread and submits its Data while the event loop runs
+  std::thread worker(tasks.front());
+  while (face.sentData.empty()) {
+    face.processEvents(-1_ms);
+  }
+  worker.join();
+
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+  BOOST_CHECK_EQUAL(face.sentData.back().getName(), "/A/1");
+}
+
+BOOST_AUTO_TEST_CASE(ExceptionInBatch)
+{
+  face.enableMultiThreading();
+
+  auto oversized = makeInterest("/A/1");
+  oversized->setApplicationParameters(make_shared<Buffer>(MAX_NDN_PACKET_SIZE));
+  face.expressInterest(*oversized, nullptr, nullptr, nullptr);
+  face.expressInterest(*makeInterest("/A/2"), nullptr, nullptr, nullptr);
+
+  BOOST_CHECK_THROW(advanceClocks(1_ms), Face::OversizedPacketError);
+
+  // the rest of the batch is not lost
+  advanceClocks(1_ms);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(face.sentInterests.back().getName(), "/A/2");
+}
+
+BOOST_AUTO_TEST_SUITE_END() // MultiThreading
+
 BOOST_AUTO_TEST_SUITE(Transport)
 
 using ndn::Transport;
@@ -29,6 +29,8 @@
 #include "tests/boost-test.hpp"
 #include "tests/make-interest-data.hpp"
 
+#include <thread>
+
 namespace ndn {
 namespace tests {
 
@@ -53,6 +55,36 @@ BOOST_AUTO_TEST_CASE(Matching)
   BOOST_CHECK_EQUAL(InterestFilter("/a", "<b><>+").doesMatch("/a/b/c"), true);
 }
 
+BOOST_AUTO_TEST_CASE(CopyRegex)
+{
+  InterestFilter original("/a", "<b><>*<c>");
+  InterestFilter copy(original);
+  InterestFilter assigned("/x");
+  assigned = original;
+  BOOST_CHECK_EQUAL(assigned.getPrefix(), "/a");
+  BOOST_CHECK_EQUAL(assigned.hasRegexFilter(), true);
+
+  // each copy has its own automaton cache, so that copies can be used on different threads
+  auto matchMany = [] (const InterestFilter& filter, int& nMatched) {
+    for (int i = 0; i < 1000; ++i) {
+      Name name("/a/b");
+      name.appendNumber(i);
+      if (filter.doesMatch(name.append(i % 2 == 0 ? "c" : "d"))) {
+        ++nMatched;
+      }
+    }
+  };
+  int nMatched[3] = {};
+  std::thread t1(matchMany, std::cref(original), std::ref(nMatched[0]));
+  std::thread t2(matchMany, std::cref(copy), std::ref(nMatched[1]));
+  matchMany(assigned, nMatched[2]);
+  t1.join();
+  t2.join();
+  BOOST_CHECK_EQUAL(nMatched[0], 500);
+  BOOST_CHECK_EQUAL(nMatched[1], 500);
+  BOOST_CHECK_EQUAL(nMatched[2], 500);
+}
+
 BOOST_AUTO_TEST_CASE(RegexConvertToName)
 {
   util::DummyClientFace face;
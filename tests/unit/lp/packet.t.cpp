@@ -103,6 +103,33 @@ BOOST_AUTO_TEST_CASE(EncodeFragment)
                                 wire.begin(), wire.end());
 }
 
+BOOST_AUTO_TEST_CASE(EncodeHeader)
+{
+  static const uint8_t expectedBlock[] = {
+    0x64, 0x0e, // LpPacket
+          0x51, 0x08, // Sequence
+                0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xe8,
+          0x50, 0x02, // Fragment
+  };
+
+  Packet packet;
+  packet.add<SequenceField>(1000);
+  Block header = packet.wireEncodeHeader(2);
+  BOOST_CHECK_EQUAL(header.type(), tlv::LpPacket);
+  BOOST_CHECK_EQUAL_COLLECTIONS(expectedBlock, expectedBlock + sizeof(expectedBlock),
+                                header.begin(), header.end());
+
+  // header followed by the fragment is identical to the full encoding
+  Buffer buf(2);
+  buf[0] = 0x03;
+  buf[1] = 0xe8;
+  Buffer joined(header.begin(), header.end());
+  joined.insert(joined.end(), buf.begin(), buf.end());
+  packet.add<FragmentField>(std::make_pair(buf.begin(), buf.end()));
+  Block wire = packet.wireEncode();
+  BOOST_CHECK_EQUAL_COLLECTIONS(joined.begin(), joined.end(), wire.begin(), wire.end());
+}
+
 BOOST_AUTO_TEST_CASE(EncodeSubTlv)
 {
   static const uint8_t expectedBlock[] = {
@@ -342,6 +342,33 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(Overwrite, T, PibImpls, T)
   BOOST_CHECK(keyBits3 == this->id1Key2);
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(Version, T, PibImpls, T)
+{
+  uint64_t version = this->pib.getVersion();
+  BOOST_CHECK_NE(version, 0);
+
+  this->pib.addCertificate(this->id1Key1Cert1);
+  BOOST_CHECK_NE(this->pib.getVersion(), version);
+  version = this->pib.getVersion();
+
+  // lookups do not change the version
+  this->pib.getDefaultIdentity();
+  this->pib.getDefaultKeyOfIdentity(this->id1);
+  this->pib.getDefaultCertificateOfKey(this->id1Key1Name);
+  BOOST_CHECK_EQUAL(this->pib.getVersion(), version);
+
+  this->pib.addCertificate(this->id1Key2Cert1);
+  BOOST_CHECK_NE(this->pib.getVersion(), version);
+  version = this->pib.getVersion();
+
+  this->pib.setDefaultKeyOfIdentity(this->id1, this->id1Key2Name);
+  BOOST_CHECK_NE(this->pib.getVersion(), version);
+  version = this->pib.getVersion();
+
+  this->pib.removeIdentity(this->id1);
+  BOOST_CHECK_NE(this->pib.getVersion(), version);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestPibImpl
 BOOST_AUTO_TEST_SUITE_END() // Pib
 BOOST_AUTO_TEST_SUITE_END() // Security
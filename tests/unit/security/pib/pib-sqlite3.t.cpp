@@ -22,6 +22,9 @@
 #include "ndn-cxx/security/pib/pib-sqlite3.hpp"
 
 #include "tests/boost-test.hpp"
+#include "tests/unit/security/pib/pib-data-fixture.hpp"
+
+#include <boost/filesystem.hpp>
 
 namespace ndn {
 namespace security {
@@ -30,10 +33,77 @@ namespace tests {
 
 BOOST_AUTO_TEST_SUITE(Security)
 BOOST_AUTO_TEST_SUITE(Pib)
-BOOST_AUTO_TEST_SUITE(TestPibSqlite3)
+
+class PibSqlite3Fixture : public ndn::security::tests::PibDataFixture
+{
+public:
+  PibSqlite3Fixture()
+    : tmpPath(boost::filesystem::path(UNIT_TEST_CONFIG_PATH) / "DbTest")
+  {
+  }
+
+  ~PibSqlite3Fixture()
+  {
+    boost::filesystem::remove_all(tmpPath);
+  }
+
+public:
+  boost::filesystem::path tmpPath;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestPibSqlite3, PibSqlite3Fixture)
 
 // Functionality is tested as part of pib-impl.t.cpp
 
+BOOST_AUTO_TEST_CASE(Mirror)
+{
+  PibSqlite3 pib(tmpPath.string());
+  pib.addCertificate(id1Key1Cert1);
+  pib.addCertificate(id1Key2Cert1);
+  size_t nLoads = pib.m_nMirrorLoads;
+
+  // lookups and modifications through the same object do not reload the mirror
+  for (int i = 0; i < 3; ++i) {
+    BOOST_CHECK_EQUAL(pib.getDefaultIdentity(), id1);
+    BOOST_CHECK_EQUAL(pib.getDefaultKeyOfIdentity(id1), id1Key1Name);
+    BOOST_CHECK_EQUAL(pib.getDefaultCertificateOfKey(id1Key1Name), id1Key1Cert1);
+    BOOST_CHECK(pib.getKeyBits(id1Key2Name) == id1Key2);
+  }
+  pib.setDefaultKeyOfIdentity(id1, id1Key2Name);
+  BOOST_CHECK_EQUAL(pib.getDefaultKeyOfIdentity(id1), id1Key2Name);
+  pib.removeKey(id1Key1Name);
+  BOOST_CHECK_EQUAL(pib.hasCertificate(id1Key1Cert1.getName()), false);
+  BOOST_CHECK_EQUAL(pib.m_nMirrorLoads, nLoads);
+
+  // the mirror reflects the database
+  PibSqlite3 pib2(tmpPath.string());
+  BOOST_CHECK_EQUAL(pib2.getDefaultKeyOfIdentity(id1), id1Key2Name);
+  BOOST_CHECK(pib2.getKeysOfIdentity(id1) == std::set<Name>{id1Key2Name});
+  BOOST_CHECK(pib2.getCertificatesOfKey(id1Key2Name) == std::set<Name>{id1Key2Cert1.getName()});
+  BOOST_CHECK_EQUAL(pib2.hasCertificate(id1Key1Cert1.getName()), false);
+}
+
+BOOST_AUTO_TEST_CASE(ExternalModification)
+{
+  PibSqlite3 pib1(tmpPath.string());
+  PibSqlite3 pib2(tmpPath.string());
+
+  pib1.addIdentity(id1);
+  BOOST_CHECK_EQUAL(pib2.getDefaultIdentity(), id1);
+
+  pib2.addCertificate(id2Key1Cert1);
+  pib2.setDefaultIdentity(id2);
+  size_t nLoads = pib1.m_nMirrorLoads;
+  BOOST_CHECK_EQUAL(pib1.getDefaultIdentity(), id2);
+  BOOST_CHECK_EQUAL(pib1.getDefaultCertificateOfKey(id2Key1Name), id2Key1Cert1);
+  BOOST_CHECK_EQUAL(pib1.m_nMirrorLoads, nLoads + 1);
+
+  pib1.removeIdentity(id2);
+  BOOST_CHECK_EQUAL(pib2.hasIdentity(id2), false);
+  BOOST_CHECK_EQUAL(pib2.hasKey(id2Key1Name), false);
+  BOOST_CHECK_THROW(pib2.getDefaultIdentity(), pib::Pib::Error);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestPibSqlite3
 BOOST_AUTO_TEST_SUITE_END() // Pib
 BOOST_AUTO_TEST_SUITE_END() // Security
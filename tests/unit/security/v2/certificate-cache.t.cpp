@@ -83,6 +83,80 @@ BOOST_AUTO_TEST_CASE(FindByInterest)
   BOOST_CHECK(certCache.find(Interest(cert.getIdentity())) == nullptr);
 }
 
+BOOST_AUTO_TEST_CASE(FindShared)
+{
+  certCache.insert(cert);
+  auto found = certCache.findShared(cert.getKeyName());
+  BOOST_REQUIRE(found != nullptr);
+  BOOST_CHECK_EQUAL(found->getName(), cert.getName());
+  BOOST_CHECK(certCache.findShared(Interest(cert.getIdentity())) == found);
+
+  certCache.clear();
+  BOOST_CHECK(certCache.find(cert.getKeyName()) == nullptr);
+  BOOST_CHECK_EQUAL(found->getName(), cert.getName()); // still owned by the caller
+}
+
+BOOST_AUTO_TEST_CASE(KeyComponentInIdentity)
+{
+  // certificates of this identity can be under the same prefix as keys of another identity
+  Identity identity2 = addIdentity(Name(cert.getKeyName()).append("KEY").append("sub"));
+  Certificate cert2 = identity2.getDefaultKey().getDefaultCertificate();
+
+  certCache.insert(cert2);
+  BOOST_CHECK_EQUAL(certCache.getNStoredCertificates(), 1);
+  BOOST_REQUIRE(certCache.find(cert.getKeyName()) != nullptr);
+  BOOST_CHECK_EQUAL(certCache.find(cert.getKeyName())->getName(), cert2.getName());
+
+  certCache.insert(cert);
+  BOOST_CHECK_EQUAL(certCache.getNStoredCertificates(), 2);
+  BOOST_CHECK_EQUAL(certCache.find(cert.getName())->getName(), cert.getName());
+  BOOST_CHECK_EQUAL(certCache.find(cert2.getKeyName())->getName(), cert2.getName());
+  BOOST_CHECK_EQUAL(certCache.find(Interest(cert2.getName()))->getName(), cert2.getName());
+  BOOST_CHECK(certCache.find(Interest(Name(cert.getKeyName()).append("nonexistent"))) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(ManyKeys)
+{
+  std::vector<Certificate> certs;
+  for (int i = 0; i < 40; ++i) {
+    Identity id = addIdentity(Name("/TestCertificateCache/Many").appendNumber(i));
+    certs.push_back(id.getDefaultKey().getDefaultCertificate());
+    certCache.insert(certs.back());
+  }
+  BOOST_CHECK_EQUAL(certCache.getNStoredCertificates(), certs.size());
+
+  for (const auto& c : certs) {
+    BOOST_REQUIRE(certCache.find(c.getKeyName()) != nullptr);
+    BOOST_CHECK_EQUAL(certCache.find(c.getKeyName())->getName(), c.getName());
+    BOOST_CHECK(certCache.find(Interest(c.getName())) != nullptr);
+  }
+  // a prefix of many keys finds the first certificate in canonical order
+  BOOST_REQUIRE(certCache.find("/TestCertificateCache/Many") != nullptr);
+  BOOST_CHECK_EQUAL(certCache.find("/TestCertificateCache/Many")->getName(), certs.front().getName());
+}
+
+BOOST_AUTO_TEST_CASE(BackgroundRefresh)
+{
+  CertificateCache cache(io, 10_s, 1_s);
+  cache.insert(cert);
+  BOOST_CHECK_EQUAL(cache.getNStoredCertificates(), 1);
+
+  advanceClocks(1_s, 9);
+  BOOST_CHECK_EQUAL(cache.getNStoredCertificates(), 1);
+  BOOST_CHECK(cache.find(cert.getName()) != nullptr);
+
+  advanceClocks(1_s, 3);
+  BOOST_CHECK_EQUAL(cache.getNStoredCertificates(), 0);
+
+  // without background refresh, expired certificates are only hidden
+  certCache.insert(cert);
+  advanceClocks(11_s, 1);
+  BOOST_CHECK(certCache.find(cert.getName()) == nullptr);
+  BOOST_CHECK_EQUAL(certCache.getNStoredCertificates(), 1);
+  certCache.refresh();
+  BOOST_CHECK_EQUAL(certCache.getNStoredCertificates(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestCertificateCache
 BOOST_AUTO_TEST_SUITE_END() // V2
 BOOST_AUTO_TEST_SUITE_END() // Security
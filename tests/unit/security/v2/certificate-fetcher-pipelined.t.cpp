@@ -0,0 +1,202 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/security/v2/certificate-fetcher-pipelined.hpp"
+#include "ndn-cxx/security/v2/validation-policy-simple-hierarchy.hpp"
+#include "ndn-cxx/lp/nack.hpp"
+
+#include "tests/boost-test.hpp"
+#include "tests/unit/security/v2/validator-fixture.hpp"
+
+namespace ndn {
+namespace security {
+namespace v2 {
+namespace tests {
+
+using namespace ndn::tests;
+
+BOOST_AUTO_TEST_SUITE(Security)
+BOOST_AUTO_TEST_SUITE(V2)
+
+class CertificateFetcherPipelinedFixture : public HierarchicalValidatorFixture<ValidationPolicySimpleHierarchy,
+                                                                                CertificateFetcherPipelined>
+{
+public:
+  CertificateFetcherPipelinedFixture()
+    : fetcher(static_cast<CertificateFetcherPipelined&>(validator.getFetcher()))
+    , data("/Security/V2/ValidatorFixture/Sub1/Sub3/Data")
+    , data2("/Security/V2/ValidatorFixture/Sub1/Sub3/Data2")
+  {
+    subSubIdentity = addSubCertificate("/Security/V2/ValidatorFixture/Sub1/Sub3", subIdentity);
+    cache.insert(subSubIdentity.getDefaultKey().getDefaultCertificate());
+
+    m_keyChain.sign(data, signingByIdentity(subSubIdentity));
+    m_keyChain.sign(data2, signingByIdentity(subSubIdentity));
+  }
+
+  std::vector<Name>
+  getSentNames() const
+  {
+    std::vector<Name> names;
+    for (const auto& interest : face.sentInterests) {
+      names.push_back(interest.getName());
+    }
+    return names;
+  }
+
+public:
+  CertificateFetcherPipelined& fetcher;
+  Identity subSubIdentity;
+  Data data;
+  Data data2;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestCertificateFetcherPipelined, CertificateFetcherPipelinedFixture)
+
+BOOST_AUTO_TEST_CASE(GuessAncestorKeys)
+{
+  using V = std::vector<Name>;
+  V expected{"/a/b/c/KEY", "/a/b/KEY", "/a/KEY"};
+
+  auto keys = CertificateFetcherPipelined::guessAncestorKeys("/a/b/c/d/KEY/k");
+  BOOST_CHECK_EQUAL_COLLECTIONS(keys.begin(), keys.end(), expected.begin(), expected.end());
+  keys = CertificateFetcherPipelined::guessAncestorKeys("/a/b/c/d/KEY/k/issuer/%FD%01");
+  BOOST_CHECK_EQUAL_COLLECTIONS(keys.begin(), keys.end(), expected.begin(), expected.end());
+
+  expected = {"/a/KEY"};
+  keys = CertificateFetcherPipelined::guessAncestorKeys("/a/b/KEY/k", 5);
+  BOOST_CHECK_EQUAL_COLLECTIONS(keys.begin(), keys.end(), expected.begin(), expected.end());
+  keys = CertificateFetcherPipelined::guessAncestorKeys("/a/b/c/KEY/k", 1);
+  expected = {"/a/b/KEY"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(keys.begin(), keys.end(), expected.begin(), expected.end());
+
+  BOOST_CHECK(CertificateFetcherPipelined::guessAncestorKeys("/a/KEY/k").empty());
+  BOOST_CHECK(CertificateFetcherPipelined::guessAncestorKeys("/a/b/c").empty());
+}
+
+BOOST_AUTO_TEST_CASE(Pipelined)
+{
+  size_t nSentBeforeFirstResponse = 0;
+  auto respond = processInterest;
+  processInterest = [&, respond] (const Interest& interest) {
+    if (nSentBeforeFirstResponse == 0) {
+      nSentBeforeFirstResponse = face.sentInterests.size();
+    }
+    respond(interest);
+  };
+
+  VALIDATE_SUCCESS(data, "Should get accepted, as interests bring certs");
+
+  // the parent certificate is requested before the first certificate is received;
+  // the trust anchor is not requested
+  BOOST_CHECK_EQUAL(nSentBeforeFirstResponse, 2);
+  std::vector<Name> expected{subSubIdentity.getDefaultKey().getName(),
+                             Name(subIdentity.getName()).append("KEY")};
+  auto sent = getSentNames();
+  BOOST_CHECK_EQUAL_COLLECTIONS(sent.begin(), sent.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(Coalesce)
+{
+  size_t nSuccesses = 0;
+  for (const auto& packet : {data, data2}) {
+    validator.validate(packet, [&] (const Data&) { ++nSuccesses; },
+                       [] (const Data&, const ValidationError& error) { BOOST_ERROR(error); });
+  }
+  mockNetworkOperations();
+  BOOST_CHECK_EQUAL(nSuccesses, 2);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(WrongHint)
+{
+  fetcher.setPrefetchHint([this] (const Name&) {
+    return std::vector<Name>{Name(otherIdentity.getName()).append("KEY")};
+  });
+
+  VALIDATE_SUCCESS(data, "Should get accepted despite the wrong prefetch hint");
+  std::vector<Name> expected{subSubIdentity.getDefaultKey().getName(),
+                             Name(otherIdentity.getName()).append("KEY"),
+                             subIdentity.getDefaultKey().getName()};
+  auto sent = getSentNames();
+  BOOST_CHECK_EQUAL_COLLECTIONS(sent.begin(), sent.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(NoHint)
+{
+  fetcher.setPrefetchHint(nullptr);
+
+  VALIDATE_SUCCESS(data, "Should get accepted without prefetching");
+  std::vector<Name> expected{subSubIdentity.getDefaultKey().getName(),
+                             subIdentity.getDefaultKey().getName()};
+  auto sent = getSentNames();
+  BOOST_CHECK_EQUAL_COLLECTIONS(sent.begin(), sent.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(Timeout)
+{
+  processInterest = nullptr;
+
+  size_t nFailures = 0;
+  for (const auto& packet : {data, data2}) {
+    validator.validate(packet, [] (const Data&) { BOOST_ERROR("Should fail"); },
+                       [&] (const Data&, const ValidationError& error) {
+                         BOOST_CHECK_EQUAL(error.getCode(), ValidationError::Code::CANNOT_RETRIEVE_CERT);
+                         ++nFailures;
+                       });
+  }
+  mockNetworkOperations();
+  BOOST_CHECK_EQUAL(nFailures, 2);
+  // one Interest plus 3 retries shared by both validations, and one speculative Interest
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 5);
+}
+
+BOOST_AUTO_TEST_CASE(SpeculationNacked)
+{
+  Name parentPrefix = Name(subIdentity.getName()).append("KEY");
+  processInterest = [this, parentPrefix] (const Interest& interest) {
+    if (interest.getName() == parentPrefix) {
+      lp::Nack nack(interest);
+      nack.setHeader(lp::NackHeader().setReason(lp::NackReason::NO_ROUTE));
+      face.receive(nack);
+      return;
+    }
+    auto cert = cache.find(interest);
+    if (cert != nullptr) {
+      face.receive(*cert);
+    }
+  };
+
+  VALIDATE_SUCCESS(data, "Should get accepted after the failed speculation");
+  std::vector<Name> expected{subSubIdentity.getDefaultKey().getName(), parentPrefix,
+                             subIdentity.getDefaultKey().getName()};
+  auto sent = getSentNames();
+  BOOST_CHECK_EQUAL_COLLECTIONS(sent.begin(), sent.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCertificateFetcherPipelined
+BOOST_AUTO_TEST_SUITE_END() // V2
+BOOST_AUTO_TEST_SUITE_END() // Security
+
+} // namespace tests
+} // namespace v2
+} // namespace security
+} // namespace ndn
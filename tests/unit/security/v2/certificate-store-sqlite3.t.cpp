@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/security/v2/certificate-store-sqlite3.hpp"
+
+#include "tests/boost-test.hpp"
+#include "tests/unit/identity-management-time-fixture.hpp"
+
+#include <boost/filesystem.hpp>
+
+namespace ndn {
+namespace security {
+namespace v2 {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Security)
+BOOST_AUTO_TEST_SUITE(V2)
+
+class CertificateStoreSqlite3Fixture : public ndn::tests::IdentityManagementTimeFixture
+{
+public:
+  CertificateStoreSqlite3Fixture()
+    : dbDir(boost::filesystem::path(UNIT_TEST_CONFIG_PATH) / "certificate-store-sqlite3")
+    , dbPath((dbDir / "certs.db").string())
+  {
+    boost::filesystem::remove_all(dbDir);
+    cert1 = addIdentity("/TestCertificateStore/A").getDefaultKey().getDefaultCertificate();
+    cert2 = addIdentity("/TestCertificateStore/B").getDefaultKey().getDefaultCertificate();
+  }
+
+  ~CertificateStoreSqlite3Fixture()
+  {
+    boost::filesystem::remove_all(dbDir);
+  }
+
+public:
+  boost::filesystem::path dbDir;
+  std::string dbPath;
+  Certificate cert1;
+  Certificate cert2;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestCertificateStoreSqlite3, CertificateStoreSqlite3Fixture)
+
+BOOST_AUTO_TEST_CASE(InsertLoad)
+{
+  auto removalTime = time::system_clock::now() + 1_h;
+  {
+    CertificateStoreSqlite3 store(dbPath);
+    store.insert(cert1, true, removalTime);
+    store.insert(cert2, false, removalTime);
+    store.insert(cert2, false, removalTime + 1_min); // replaces previous record
+    BOOST_CHECK_EQUAL(store.size(true), 1);
+    BOOST_CHECK_EQUAL(store.size(false), 1);
+  }
+
+  CertificateStoreSqlite3 store(dbPath);
+  auto verified = store.load(true);
+  BOOST_REQUIRE_EQUAL(verified.size(), 1);
+  BOOST_CHECK_EQUAL(verified[0].cert, cert1);
+  BOOST_CHECK(verified[0].removalTime == time::fromUnixTimestamp(time::toUnixTimestamp(removalTime)));
+
+  auto unverified = store.load(false);
+  BOOST_REQUIRE_EQUAL(unverified.size(), 1);
+  BOOST_CHECK_EQUAL(unverified[0].cert, cert2);
+  BOOST_CHECK(unverified[0].removalTime ==
+              time::fromUnixTimestamp(time::toUnixTimestamp(removalTime + 1_min)));
+}
+
+BOOST_AUTO_TEST_CASE(Expiration)
+{
+  CertificateStoreSqlite3 store(dbPath);
+  store.insert(cert1, true, time::system_clock::now() + 10_s);
+  store.insert(cert2, true, time::system_clock::now() + 1_h);
+
+  advanceClocks(11_s);
+  auto verified = store.load(true);
+  BOOST_REQUIRE_EQUAL(verified.size(), 1);
+  BOOST_CHECK_EQUAL(verified[0].cert, cert2);
+  BOOST_CHECK_EQUAL(store.size(true), 1);
+
+  // outside of validity period
+  Certificate expiredCert = cert1;
+  expiredCert.setName(Name(cert1.getKeyName()).append("expired").appendVersion());
+  SignatureInfo info;
+  info.setValidityPeriod(ValidityPeriod(time::system_clock::now() - 2_h,
+                                        time::system_clock::now() - 1_h));
+  m_keyChain.sign(expiredCert, signingByCertificate(cert1).setSignatureInfo(info));
+  store.insert(expiredCert, true, time::system_clock::now() + 1_h);
+  BOOST_CHECK_EQUAL(store.size(true), 2);
+
+  verified = store.load(true);
+  BOOST_REQUIRE_EQUAL(verified.size(), 1);
+  BOOST_CHECK_EQUAL(verified[0].cert, cert2);
+  BOOST_CHECK_EQUAL(store.size(true), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Clear)
+{
+  CertificateStoreSqlite3 store(dbPath);
+  store.insert(cert1, true, time::system_clock::now() + 1_h);
+  store.insert(cert1, false, time::system_clock::now() + 1_h);
+
+  store.clear(true);
+  BOOST_CHECK_EQUAL(store.size(true), 0);
+  BOOST_CHECK_EQUAL(store.size(false), 1);
+  BOOST_CHECK_EQUAL(store.load(true).size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCertificateStoreSqlite3
+BOOST_AUTO_TEST_SUITE_END() // V2
+BOOST_AUTO_TEST_SUITE_END() // Security
+
+} // namespace tests
+} // namespace v2
+} // namespace security
+} // namespace ndn
@@ -369,6 +369,51 @@ BOOST_FIXTURE_TEST_CASE(GeneralSigningInterface, IdentityManagementFixture)
   }
 }
 
+BOOST_FIXTURE_TEST_CASE(ResolvedSigner, IdentityManagementFixture)
+{
+  Identity id1 = addIdentity("/id1");
+  Identity id2 = addIdentity("/id2");
+  m_keyChain.setDefaultIdentity(id1);
+
+  KeyChain::ResolvedSigner signer = m_keyChain.resolveSigner();
+  BOOST_CHECK_EQUAL(signer.getKeyName(), id1.getDefaultKey().getName());
+  BOOST_CHECK_EQUAL(signer.getSignatureInfo().getKeyLocator().getName(), id1.getDefaultKey().getName());
+
+  Data data("/data");
+  Interest interest("/interest");
+  m_keyChain.sign(data, signer);
+  m_keyChain.sign(interest, signer);
+  BOOST_CHECK_EQUAL(data.getSignature().getKeyLocator().getName(), id1.getDefaultKey().getName());
+  BOOST_CHECK(verifySignature(data, id1.getDefaultKey()));
+  BOOST_CHECK(verifySignature(interest, id1.getDefaultKey()));
+
+  // changing the default identity causes the signer to be resolved again
+  m_keyChain.setDefaultIdentity(id2);
+  m_keyChain.sign(data, signer);
+  BOOST_CHECK_EQUAL(signer.getKeyName(), id2.getDefaultKey().getName());
+  BOOST_CHECK(verifySignature(data, id2.getDefaultKey()));
+
+  // so does changing the default key of the identity
+  Key key = m_keyChain.createKey(id2);
+  m_keyChain.setDefaultKey(id2, key);
+  const uint8_t buf[] = {0x01, 0x02, 0x03, 0x04};
+  Block sigValue = m_keyChain.sign(buf, sizeof(buf), signer);
+  BOOST_CHECK_EQUAL(signer.getKeyName(), key.getName());
+  BOOST_CHECK(verifySignature(buf, sizeof(buf), sigValue.value(), sigValue.value_size(),
+                              key.getPublicKey().data(), key.getPublicKey().size()));
+
+  // signing key has been deleted
+  KeyChain::ResolvedSigner keySigner = m_keyChain.resolveSigner(signingByKey(key.getName()));
+  m_keyChain.deleteKey(id2, key);
+  BOOST_CHECK_THROW(m_keyChain.sign(data, keySigner), KeyChain::InvalidSigningInfoError);
+
+  KeyChain::ResolvedSigner sha256Signer = m_keyChain.resolveSigner(signingWithSha256());
+  BOOST_CHECK_EQUAL(sha256Signer.getKeyName(), SigningInfo::getDigestSha256Identity());
+  m_keyChain.sign(data, sha256Signer);
+  BOOST_CHECK_EQUAL(data.getSignature().getType(), tlv::DigestSha256);
+  BOOST_CHECK(verifyDigest(data, DigestAlgorithm::SHA256));
+}
+
 BOOST_FIXTURE_TEST_CASE(PublicKeySigningDefaults, IdentityManagementFixture)
 {
   Data data("/test/data");
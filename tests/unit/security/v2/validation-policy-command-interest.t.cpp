@@ -22,6 +22,7 @@
 #include "ndn-cxx/security/v2/validation-policy-command-interest.hpp"
 #include "ndn-cxx/security/v2/validation-policy-simple-hierarchy.hpp"
 #include "ndn-cxx/security/v2/validation-policy-accept-all.hpp"
+#include "ndn-cxx/security/v2/certificate-fetcher-offline.hpp"
 #include "ndn-cxx/security/command-interest-signer.hpp"
 #include "ndn-cxx/security/signing-helpers.hpp"
 
@@ -475,6 +476,66 @@ BOOST_FIXTURE_TEST_CASE(ZeroRecordLifetime, ValidationPolicyCommandInterestFixtu
 
 BOOST_AUTO_TEST_SUITE_END() // Options
 
+BOOST_AUTO_TEST_SUITE(Records)
+
+BOOST_AUTO_TEST_CASE(Table)
+{
+  ValidationPolicyCommandInterest::Options options;
+  options.maxRecords = 2;
+  options.recordLifetime = 10_s;
+  ValidationPolicyCommandInterest::RecordTable table(options);
+
+  BOOST_CHECK(!table.find("/A"));
+  table.insert("/A", 5);
+  table.insert("/A", 3);
+  BOOST_CHECK_EQUAL(*table.find("/A"), 5);
+
+  table.insert("/B", 1);
+  table.insert("/C", 1);
+  BOOST_CHECK_EQUAL(table.size(), 3);
+  BOOST_CHECK(!table.find("/A")); // least recently refreshed record is evicted
+  BOOST_CHECK_EQUAL(table.size(), 2);
+
+  advanceClocks(5_s);
+  table.insert("/B", 2);
+  advanceClocks(6_s);
+  BOOST_CHECK(!table.find("/C")); // expired
+  BOOST_CHECK_EQUAL(*table.find("/B"), 2);
+  BOOST_CHECK_EQUAL(table.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(SharedTable)
+{
+  BOOST_CHECK_THROW(ValidationPolicyCommandInterest(make_unique<ValidationPolicyAcceptAll>(), {}, nullptr),
+                    std::invalid_argument);
+
+  Validator validator2(make_unique<ValidationPolicyCommandInterest>(make_unique<ValidationPolicyAcceptAll>(),
+                                                                    ValidationPolicyCommandInterest::Options{},
+                                                                    policy.getRecordTable()),
+                       make_unique<CertificateFetcherOffline>());
+
+  auto i1 = makeCommandInterest(identity);
+  VALIDATE_SUCCESS(i1, "Should succeed");
+  BOOST_CHECK_EQUAL(policy.getRecordTable()->size(), 1);
+
+  bool hasFailed = false;
+  validator2.validate(i1,
+                      [] (const Interest&) { BOOST_ERROR("Should fail (replay to another validator)"); },
+                      [&] (const Interest&, const ValidationError&) { hasFailed = true; });
+  BOOST_CHECK(hasFailed);
+
+  advanceClocks(5_ms);
+  auto i2 = makeCommandInterest(identity);
+  bool hasSucceeded = false;
+  validator2.validate(i2,
+                      [&] (const Interest&) { hasSucceeded = true; },
+                      [] (const Interest&, const ValidationError&) { BOOST_ERROR("Should succeed"); });
+  BOOST_CHECK(hasSucceeded);
+  VALIDATE_FAILURE(i2, "Should fail (replay of Interest accepted by another validator)");
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Records
+
 BOOST_AUTO_TEST_SUITE_END() // TestValidationPolicyCommandInterest
 BOOST_AUTO_TEST_SUITE_END() // V2
 BOOST_AUTO_TEST_SUITE_END() // Security
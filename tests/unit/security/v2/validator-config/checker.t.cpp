@@ -356,6 +356,50 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(Checks, T, Tests, T)
   }
 }
 
+BOOST_AUTO_TEST_CASE(MemoizedSegments)
+{
+  using namespace ndn::security::v2::tests;
+
+  HyperRelationChecker checker("^(<>*)<>$", "\\1", "^(<>*)<KEY><>$", "\\1", NameRelation::EQUAL);
+  Name klName = makeKeyLocatorName("/foo/bar");
+
+  for (uint64_t seg = 0; seg < 3; ++seg) {
+    auto state = make_shared<DummyValidationState>();
+    BOOST_CHECK_EQUAL(checker.check(tlv::Data, Name("/foo/bar").appendSegment(seg), klName, state), true);
+    BOOST_CHECK_EQUAL(checker.m_passed.size(), 1);
+  }
+
+  auto state = make_shared<DummyValidationState>();
+  BOOST_CHECK_EQUAL(checker.check(tlv::Data, Name("/foo").appendSegment(0), klName, state), false);
+  BOOST_CHECK_EQUAL(bool(state->getOutcome()), false);
+  BOOST_CHECK_EQUAL(checker.m_passed.size(), 1);
+
+  state = make_shared<DummyValidationState>();
+  BOOST_CHECK_EQUAL(checker.check(tlv::Interest, makeSignedInterestName(Name("/foo/bar").appendSegment(7)),
+                                  klName, state), true);
+  BOOST_CHECK_EQUAL(checker.m_passed.size(), 1);
+
+  // the expansion refers to the last component, which therefore cannot be ignored
+  HyperRelationChecker checker2("^(<>*)<>$", "\\0", "^(<>*)<KEY><>$", "\\1", NameRelation::EQUAL);
+  klName = makeKeyLocatorName("/foo/bar");
+  state = make_shared<DummyValidationState>();
+  BOOST_CHECK_EQUAL(checker2.check(tlv::Data, "/foo/bar", klName, state), true);
+  state = make_shared<DummyValidationState>();
+  BOOST_CHECK_EQUAL(checker2.check(tlv::Data, "/foo/baz", klName, state), false);
+  BOOST_CHECK_EQUAL(checker2.m_passed.size(), 0);
+
+  // only the KeyLocator name is significant
+  NameRelationChecker checker3("/foo", NameRelation::IS_PREFIX_OF);
+  for (const auto& pktName : {"/foo/bar", "/foo/baz", "/other"}) {
+    state = make_shared<DummyValidationState>();
+    BOOST_CHECK_EQUAL(checker3.check(tlv::Data, pktName, klName, state), true);
+    BOOST_CHECK_EQUAL(checker3.m_passed.size(), 1);
+  }
+  state = make_shared<DummyValidationState>();
+  BOOST_CHECK_EQUAL(checker3.check(tlv::Data, "/foo/bar", makeKeyLocatorName("/other"), state), false);
+  BOOST_CHECK_EQUAL(checker3.m_passed.size(), 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestChecker
 BOOST_AUTO_TEST_SUITE_END() // ValidatorConfig
 BOOST_AUTO_TEST_SUITE_END() // V2
@@ -86,6 +86,26 @@ BOOST_AUTO_TEST_CASE(RegexName)
   CHECK_FOR_MATCHES(f3, false, true, false, false);
 }
 
+BOOST_AUTO_TEST_CASE(RequiredPrefix)
+{
+  BOOST_CHECK_EQUAL(RelationNameFilter("/foo/bar", NameRelation::EQUAL).getRequiredPrefix(), "/foo/bar");
+  BOOST_CHECK_EQUAL(RelationNameFilter("/foo/bar", NameRelation::IS_STRICT_PREFIX_OF).getRequiredPrefix(),
+                    "/foo/bar");
+
+  BOOST_CHECK_EQUAL(RegexNameFilter(Regex("^<foo><bar>$")).getRequiredPrefix(), "/foo/bar");
+  BOOST_CHECK_EQUAL(RegexNameFilter(Regex("^<foo><bar><>*$")).getRequiredPrefix(), "/foo/bar");
+  BOOST_CHECK_EQUAL(RegexNameFilter(Regex("^<foo><%2F>(<>*)$")).getRequiredPrefix(), "/foo/%2F");
+  BOOST_CHECK_EQUAL(RegexNameFilter(Regex("^<foo><bar>*<baz>$")).getRequiredPrefix(), "/foo");
+  BOOST_CHECK_EQUAL(RegexNameFilter(Regex("^<foo><ba.>$")).getRequiredPrefix(), "/foo");
+  BOOST_CHECK_EQUAL(RegexNameFilter(Regex("^<foo>[<bar><baz>]$")).getRequiredPrefix(), "/foo");
+  BOOST_CHECK_EQUAL(RegexNameFilter(Regex("^(<foo>)<bar>$")).getRequiredPrefix(), "/");
+  BOOST_CHECK_EQUAL(RegexNameFilter(Regex("<foo><bar>$")).getRequiredPrefix(), "/");
+
+  for (const auto& name : {"/foo/%2F", "/foo/%2F/bar"}) {
+    BOOST_CHECK_EQUAL(RegexNameFilter(Regex("^<foo><%2F>(<>*)$")).match(tlv::Data, name), true);
+  }
+}
+
 BOOST_FIXTURE_TEST_SUITE(Create, FilterFixture)
 
 BOOST_AUTO_TEST_CASE(Errors)
@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/security/v2/validator-config/rule-index.hpp"
+#include "ndn-cxx/util/regex.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace ndn {
+namespace security {
+namespace v2 {
+namespace validator_config {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Security)
+BOOST_AUTO_TEST_SUITE(V2)
+BOOST_AUTO_TEST_SUITE(ValidatorConfig)
+
+class RuleIndexFixture
+{
+public:
+  void
+  addRule(const std::string& id, unique_ptr<Filter> filter = nullptr,
+          unique_ptr<Filter> filter2 = nullptr)
+  {
+    auto rule = make_unique<Rule>(id, tlv::Data);
+    if (filter != nullptr) {
+      rule->addFilter(std::move(filter));
+    }
+    if (filter2 != nullptr) {
+      rule->addFilter(std::move(filter2));
+    }
+    rules.push_back(rule.get());
+    index.insert(std::move(rule));
+  }
+
+  /** @brief find the first matching rule by evaluating all rules in order
+   */
+  const Rule*
+  findLinear(const Name& name) const
+  {
+    for (const Rule* rule : rules) {
+      if (rule->match(tlv::Data, name)) {
+        return rule;
+      }
+    }
+    return nullptr;
+  }
+
+  std::string
+  findId(const Name& name) const
+  {
+    const Rule* rule = index.findRule(tlv::Data, name);
+    BOOST_CHECK_EQUAL(rule, findLinear(name));
+    return rule == nullptr ? "" : rule->getId();
+  }
+
+public:
+  RuleIndex index;
+  std::vector<const Rule*> rules;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestRuleIndex, RuleIndexFixture)
+
+BOOST_AUTO_TEST_CASE(Empty)
+{
+  BOOST_CHECK(index.empty());
+  BOOST_CHECK(index.findRule(tlv::Data, "/foo") == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(FirstMatch)
+{
+  addRule("foo-bar-exact", make_unique<RelationNameFilter>("/foo/bar", NameRelation::EQUAL));
+  addRule("foo-regex", make_unique<RegexNameFilter>(Regex("^<foo><>*<baz>$")));
+  addRule("any-regex", make_unique<RegexNameFilter>(Regex("^<>*<qux>$")));
+  addRule("foo-prefix", make_unique<RelationNameFilter>("/foo", NameRelation::IS_PREFIX_OF));
+  addRule("two-filters", make_unique<RelationNameFilter>("/a/b", NameRelation::IS_PREFIX_OF),
+          make_unique<RegexNameFilter>(Regex("^<c><d>$")));
+  addRule("unfiltered");
+  addRule("shadowed", make_unique<RelationNameFilter>("/c", NameRelation::IS_PREFIX_OF));
+  BOOST_CHECK_EQUAL(index.size(), 7);
+
+  BOOST_CHECK_EQUAL(findId("/foo/bar"), "foo-bar-exact");
+  BOOST_CHECK_EQUAL(findId("/foo/bar/baz"), "foo-regex");
+  BOOST_CHECK_EQUAL(findId("/foo/bar/qux"), "any-regex");
+  BOOST_CHECK_EQUAL(findId("/x/y/qux"), "any-regex");
+  BOOST_CHECK_EQUAL(findId("/foo/bar/x"), "foo-prefix");
+  BOOST_CHECK_EQUAL(findId("/foo"), "foo-prefix");
+  BOOST_CHECK_EQUAL(findId("/a/b/c"), "two-filters");
+  BOOST_CHECK_EQUAL(findId("/c/d"), "two-filters");
+  BOOST_CHECK_EQUAL(findId("/c/d/e"), "unfiltered");
+  BOOST_CHECK_EQUAL(findId("/"), "unfiltered");
+
+  index.clear();
+  rules.clear();
+  BOOST_CHECK_EQUAL(index.size(), 0);
+  BOOST_CHECK_EQUAL(findId("/foo/bar"), "");
+}
+
+BOOST_AUTO_TEST_CASE(NoMatch)
+{
+  addRule("foo-strict", make_unique<RelationNameFilter>("/foo", NameRelation::IS_STRICT_PREFIX_OF));
+  addRule("bar-regex", make_unique<RegexNameFilter>(Regex("^<bar><>$")));
+
+  BOOST_CHECK_EQUAL(findId("/foo"), "");
+  BOOST_CHECK_EQUAL(findId("/foo/x"), "foo-strict");
+  BOOST_CHECK_EQUAL(findId("/bar"), "");
+  BOOST_CHECK_EQUAL(findId("/bar/x"), "bar-regex");
+  BOOST_CHECK_EQUAL(findId("/baz/x"), "");
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestRuleIndex
+BOOST_AUTO_TEST_SUITE_END() // ValidatorConfig
+BOOST_AUTO_TEST_SUITE_END() // V2
+BOOST_AUTO_TEST_SUITE_END() // Security
+
+} // namespace tests
+} // namespace validator_config
+} // namespace v2
+} // namespace security
+} // namespace ndn
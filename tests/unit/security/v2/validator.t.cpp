@@ -25,6 +25,8 @@
 #include "tests/boost-test.hpp"
 #include "tests/unit/security/v2/validator-fixture.hpp"
 
+#include <boost/filesystem.hpp>
+
 namespace ndn {
 namespace security {
 namespace v2 {
@@ -173,6 +175,56 @@ BOOST_AUTO_TEST_CASE(ResetVerifiedCertificates)
   VALIDATE_FAILURE(data, "Should fail, as no trusted cache or anchors");
 }
 
+BOOST_AUTO_TEST_CASE(PersistentCertificateStore)
+{
+  boost::filesystem::path dbDir = boost::filesystem::path(UNIT_TEST_CONFIG_PATH) / "validator-store";
+  std::string dbPath = (dbDir / "certs.db").string();
+  boost::filesystem::remove_all(dbDir);
+
+  Data data("/Security/V2/ValidatorFixture/Sub1/Sub2/Data");
+  m_keyChain.sign(data, signingByIdentity(subIdentity));
+
+  auto store = make_shared<CertificateStoreSqlite3>(dbPath);
+  validator.setPersistentCertificateStore(store);
+  VALIDATE_SUCCESS(data, "Should get accepted, as signed by the policy-compliant cert");
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(store->size(true), 1);
+  face.sentInterests.clear();
+  processInterest = nullptr;
+
+  // restarted validator with the same trust anchor, warmed up from the store
+  Validator restarted(make_unique<ValidationPolicySimpleHierarchy>(),
+                      make_unique<CertificateFetcherFromNetwork>(face));
+  restarted.loadAnchor("", Certificate(identity.getDefaultKey().getDefaultCertificate()));
+  restarted.setPersistentCertificateStore(make_shared<CertificateStoreSqlite3>(dbPath));
+
+  size_t nSuccesses = 0;
+  restarted.validate(data,
+                     [&] (const Data&) { ++nSuccesses; },
+                     [] (const Data&, const ValidationError&) {});
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(nSuccesses, 1);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 0);
+
+  // stored certificates are not trusted without a trust anchor, even those stored as verified
+  Validator untrusted(make_unique<ValidationPolicySimpleHierarchy>(),
+                      make_unique<CertificateFetcherFromNetwork>(face));
+  untrusted.setPersistentCertificateStore(make_shared<CertificateStoreSqlite3>(dbPath));
+
+  size_t nFailures = 0;
+  untrusted.validate(data,
+                     [] (const Data&) { BOOST_ERROR("unexpected success"); },
+                     [&] (const Data&, const ValidationError&) { ++nFailures; });
+  mockNetworkOperations();
+  BOOST_CHECK_EQUAL(nFailures, 1);
+
+  // resetting verified certificates also clears them from the store
+  restarted.resetVerifiedCertificates();
+  BOOST_CHECK_EQUAL(store->size(true), 0);
+
+  boost::filesystem::remove_all(dbDir);
+}
+
 BOOST_AUTO_TEST_CASE(UntrustedCertCaching)
 {
   Data data("/Security/V2/ValidatorFixture/Sub1/Sub2/Data");
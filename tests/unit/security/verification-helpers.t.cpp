@@ -493,6 +493,9 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(VerifyDigest, Dataset, DigestDatasets)
   BOOST_CHECK(!verifyDigest(unsignedInterest1, DigestAlgorithm::SHA256));
   BOOST_CHECK(!verifyDigest(unsignedInterest2, DigestAlgorithm::SHA256));
 
+  // unsupported digest algorithm
+  BOOST_CHECK(!verifyDigest(data, DigestAlgorithm::NONE));
+
   // - base version of verifyDigest is tested transitively
 }
 
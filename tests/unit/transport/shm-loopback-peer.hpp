@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_TESTS_UNIT_TRANSPORT_SHM_LOOPBACK_PEER_HPP
+#define NDN_TESTS_UNIT_TRANSPORT_SHM_LOOPBACK_PEER_HPP
+
+#include "ndn-cxx/transport/detail/shm-channel.hpp"
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/filesystem.hpp>
+
+namespace ndn {
+namespace tests {
+
+/** \brief stand-in for a forwarder that accepts ShmTransport connections
+ *
+ *  The peer listens on a Unix stream socket, attaches to the shared memory handed over by the
+ *  first client, records every received packet, and optionally sends it back.
+ */
+class ShmLoopbackPeer : noncopyable
+{
+public:
+  ShmLoopbackPeer(boost::asio::io_service& io, const std::string& path)
+    : m_io(io)
+    , m_acceptor(io)
+    , m_socket(io)
+  {
+    boost::filesystem::remove(path);
+    boost::asio::local::stream_protocol::endpoint endpoint(path);
+    m_acceptor.open(endpoint.protocol());
+    m_acceptor.bind(endpoint);
+    m_acceptor.listen();
+    m_acceptor.async_accept(m_socket, [this] (const boost::system::error_code& error) {
+      if (!error) {
+        m_socket.async_wait(boost::asio::socket_base::wait_read,
+                            [this] (const boost::system::error_code& error) {
+                              if (!error) {
+                                attach();
+                              }
+                            });
+      }
+    });
+  }
+
+  ~ShmLoopbackPeer()
+  {
+    disconnect();
+  }
+
+  bool
+  isAttached() const
+  {
+    return m_channel != nullptr;
+  }
+
+  void
+  send(const Block& wire)
+  {
+    m_channel->send(wire, Block());
+  }
+
+  void
+  setReceiving(bool wantReceive)
+  {
+    m_channel->setReceiving(wantReceive);
+  }
+
+  /** \brief simulate forwarder shutdown
+   */
+  void
+  disconnect()
+  {
+    if (m_channel != nullptr) {
+      m_channel->close();
+      m_channel.reset();
+    }
+    boost::system::error_code error;
+    m_socket.close(error);
+    m_acceptor.close(error);
+  }
+
+private:
+  void
+  attach()
+  {
+    m_channel = detail::ShmChannel::attach(m_io, detail::ShmChannel::receiveFds(m_socket.native_handle()));
+    m_channel->start([this] (const Block& wire) {
+                       received.push_back(wire);
+                       if (shouldEcho) {
+                         send(wire);
+                       }
+                     },
+                     [] (const std::string& reason) {
+                       NDN_THROW(std::runtime_error(reason));
+                     });
+    m_channel->setReceiving(true);
+  }
+
+public:
+  std::vector<Block> received;
+  bool shouldEcho = true;
+
+private:
+  boost::asio::io_service& m_io;
+  boost::asio::local::stream_protocol::acceptor m_acceptor;
+  boost::asio::local::stream_protocol::socket m_socket;
+  shared_ptr<detail::ShmChannel> m_channel;
+};
+
+} // namespace tests
+} // namespace ndn
+
+#endif // NDN_TESTS_UNIT_TRANSPORT_SHM_LOOPBACK_PEER_HPP
@@ -0,0 +1,123 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/transport/detail/shm-ring.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace ndn {
+namespace detail {
+namespace tests {
+
+class ShmRingFixture
+{
+protected:
+  ShmRingFixture()
+    : ring(region, CAPACITY, true)
+  {
+  }
+
+protected:
+  static constexpr size_t CAPACITY = 16384;
+  alignas(64) uint8_t region[ShmRing::getRegionSize(CAPACITY)];
+  ShmRing ring;
+};
+
+constexpr size_t ShmRingFixture::CAPACITY;
+
+BOOST_AUTO_TEST_SUITE(Transport)
+BOOST_FIXTURE_TEST_SUITE(TestShmRing, ShmRingFixture)
+
+BOOST_AUTO_TEST_CASE(PushPop)
+{
+  BOOST_CHECK(ring.isEmpty());
+  BOOST_CHECK(!ring.peekSize());
+
+  const uint8_t header[] = {0x01, 0x02};
+  const uint8_t payload[] = {0x03, 0x04, 0x05};
+  BOOST_CHECK(ring.tryPush(header, sizeof(header), payload, sizeof(payload)));
+  BOOST_CHECK(!ring.isEmpty());
+  BOOST_REQUIRE(ring.peekSize());
+  BOOST_CHECK_EQUAL(*ring.peekSize(), 5);
+
+  uint8_t buf[5];
+  ring.pop(buf, sizeof(buf));
+  const uint8_t expected[] = {0x01, 0x02, 0x03, 0x04, 0x05};
+  BOOST_CHECK_EQUAL_COLLECTIONS(buf, buf + sizeof(buf), expected, expected + sizeof(expected));
+  BOOST_CHECK(ring.isEmpty());
+
+  // does not fit
+  std::vector<uint8_t> big(CAPACITY);
+  BOOST_CHECK(!ring.tryPush(big.data(), big.size(), nullptr, 0));
+}
+
+BOOST_AUTO_TEST_CASE(BogusHead)
+{
+  // the peer claims to have written more than the ring can hold
+  ring.getControl().head.store(CAPACITY + 1);
+  BOOST_CHECK_THROW(ring.peekSize(), std::length_error);
+
+  ring.getControl().head.store(std::numeric_limits<uint64_t>::max());
+  BOOST_CHECK_THROW(ring.peekSize(), std::length_error);
+
+  // head behind tail
+  ring.getControl().tail.store(100);
+  ring.getControl().head.store(50);
+  BOOST_CHECK_THROW(ring.peekSize(), std::length_error);
+
+  // truncated record header
+  ring.getControl().tail.store(0);
+  ring.getControl().head.store(2);
+  BOOST_CHECK_THROW(ring.peekSize(), std::length_error);
+}
+
+BOOST_AUTO_TEST_CASE(BogusSize)
+{
+  const uint8_t record[] = {0x01, 0x02, 0x03};
+  BOOST_REQUIRE(ring.tryPush(record, sizeof(record), nullptr, 0));
+
+  // record header overwritten with a size larger than the ring content
+  ShmRing::RecordSize size = 0xFFFFFFFF;
+  std::memcpy(region + sizeof(ShmRing::Control), &size, sizeof(size));
+  BOOST_CHECK_THROW(ring.peekSize(), std::length_error);
+
+  size = sizeof(record) + 1;
+  std::memcpy(region + sizeof(ShmRing::Control), &size, sizeof(size));
+  BOOST_CHECK_THROW(ring.peekSize(), std::length_error);
+
+  // consistent with the ring content, but larger than any packet
+  size = MAX_NDN_PACKET_SIZE + 1;
+  std::memcpy(region + sizeof(ShmRing::Control), &size, sizeof(size));
+  ring.getControl().head.store(sizeof(size) + size);
+  BOOST_CHECK_THROW(ring.peekSize(), std::length_error);
+
+  size = MAX_NDN_PACKET_SIZE;
+  std::memcpy(region + sizeof(ShmRing::Control), &size, sizeof(size));
+  BOOST_REQUIRE(ring.peekSize());
+  BOOST_CHECK_EQUAL(*ring.peekSize(), MAX_NDN_PACKET_SIZE);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestShmRing
+BOOST_AUTO_TEST_SUITE_END() // Transport
+
+} // namespace tests
+} // namespace detail
+} // namespace ndn
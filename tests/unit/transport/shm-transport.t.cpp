@@ -0,0 +1,203 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/transport/shm-transport.hpp"
+#include "ndn-cxx/encoding/block-helpers.hpp"
+
+#include "tests/boost-test.hpp"
+#include "tests/unit/transport/transport-fixture.hpp"
+
+#ifdef NDN_CXX_HAVE_MEMFD
+#include "tests/unit/transport/shm-loopback-peer.hpp"
+#endif // NDN_CXX_HAVE_MEMFD
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Transport)
+BOOST_FIXTURE_TEST_SUITE(TestShmTransport, TransportFixture)
+
+using ndn::Transport;
+
+BOOST_AUTO_TEST_CASE(GetDefaultSocketNameOk)
+{
+  BOOST_CHECK_EQUAL(ShmTransport::getSocketNameFromUri("shm:///tmp/test/nfd-shm.sock"),
+                    "/tmp/test/nfd-shm.sock");
+}
+
+BOOST_AUTO_TEST_CASE(GetDefaultSocketNameOkOmittedSocketOmittedProtocol)
+{
+  BOOST_CHECK_EQUAL(ShmTransport::getSocketNameFromUri(""), "/var/run/nfd-shm.sock");
+}
+
+BOOST_AUTO_TEST_CASE(GetDefaultSocketNameBadWrongTransport)
+{
+  BOOST_CHECK_EXCEPTION(ShmTransport::getSocketNameFromUri("unix://"),
+                        Transport::Error,
+                        [] (const Transport::Error& error) {
+                          return error.what() == "Cannot create ShmTransport from \"unix\" URI"s;
+                        });
+}
+
+#ifdef NDN_CXX_HAVE_MEMFD
+
+class ShmLoopbackFixture : public TransportFixture
+{
+protected:
+  ShmLoopbackFixture()
+    : socketPath((boost::filesystem::path(UNIT_TEST_CONFIG_PATH) / "shm-transport.sock").string())
+  {
+    boost::filesystem::create_directories(UNIT_TEST_CONFIG_PATH);
+    peer = make_unique<ShmLoopbackPeer>(io, socketPath);
+    transport = make_unique<ShmTransport>(socketPath);
+  }
+
+  void
+  connect()
+  {
+    transport->connect(io, [this] (const Block& wire) { received.push_back(wire); });
+    BOOST_REQUIRE(transport->isConnected());
+    BOOST_REQUIRE(advanceUntil([this] { return peer->isAttached(); }));
+  }
+
+  /** \brief run the io_service until \p predicate holds, for at most \p nSteps handlers
+   */
+  template<typename Predicate>
+  bool
+  advanceUntil(const Predicate& predicate, int nSteps = 500)
+  {
+    for (int i = 0; i < nSteps && !predicate(); ++i) {
+      if (io.stopped()) {
+        io.restart();
+      }
+      io.run_one_for(std::chrono::milliseconds(10));
+    }
+    return predicate();
+  }
+
+protected:
+  boost::asio::io_service io;
+  std::string socketPath;
+  unique_ptr<ShmLoopbackPeer> peer;
+  unique_ptr<ShmTransport> transport;
+  std::vector<Block> received;
+};
+
+BOOST_FIXTURE_TEST_CASE(Loopback, ShmLoopbackFixture)
+{
+  connect();
+  transport->resume();
+
+  Block wire = makeNonNegativeIntegerBlock(100, 42);
+  transport->send(wire);
+
+  // TLV-TYPE and TLV-LENGTH in the header, TLV-VALUE in the payload
+  Block payload = makeStringBlock(tlv::Content, "payload");
+  EncodingBuffer encoder;
+  encoder.prependVarNumber(payload.size());
+  encoder.prependVarNumber(101);
+  transport->send(encoder.block(false), payload);
+
+  BOOST_REQUIRE(advanceUntil([this] { return received.size() == 2; }));
+  BOOST_CHECK_EQUAL(peer->received.at(0), wire);
+  BOOST_CHECK_EQUAL(received.at(0), wire);
+  BOOST_CHECK_EQUAL(received.at(1).type(), 101);
+  BOOST_CHECK_EQUAL(received.at(1).blockFromValue(), payload);
+
+  transport->close();
+  BOOST_CHECK(!transport->isConnected());
+}
+
+BOOST_FIXTURE_TEST_CASE(Backpressure, ShmLoopbackFixture)
+{
+  connect();
+  transport->resume();
+
+  // several times the ring capacity in each direction
+  const size_t nPackets = 500;
+  for (size_t i = 0; i < nPackets; ++i) {
+    transport->send(makeStringBlock(tlv::Content, std::string(4000, static_cast<char>(i))));
+  }
+  BOOST_REQUIRE(advanceUntil([&] { return received.size() == nPackets; }));
+  for (size_t i = 0; i < nPackets; ++i) {
+    BOOST_CHECK_EQUAL(received[i].value()[0], static_cast<uint8_t>(i));
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(PauseResume, ShmLoopbackFixture)
+{
+  connect();
+  peer->shouldEcho = false;
+
+  peer->send(makeNonNegativeIntegerBlock(100, 1));
+  BOOST_CHECK(!advanceUntil([this] { return !received.empty(); }, 20));
+
+  transport->resume();
+  BOOST_CHECK(advanceUntil([this] { return received.size() == 1; }));
+
+  transport->pause();
+  peer->send(makeNonNegativeIntegerBlock(100, 2));
+  BOOST_CHECK(!advanceUntil([this] { return received.size() > 1; }, 20));
+
+  transport->resume();
+  BOOST_CHECK(advanceUntil([this] { return received.size() == 2; }));
+}
+
+BOOST_FIXTURE_TEST_CASE(ReceiveAfterIdle, ShmLoopbackFixture)
+{
+  connect();
+  peer->shouldEcho = false;
+
+  // resume() processes an empty ring, the consumer must still go back to waiting on the doorbell
+  transport->resume();
+  advanceUntil([] { return false; }, 30);
+
+  Block wire = makeNonNegativeIntegerBlock(100, 1);
+  peer->send(wire);
+  BOOST_REQUIRE(advanceUntil([this] { return received.size() == 1; }));
+  BOOST_CHECK_EQUAL(received.at(0), wire);
+}
+
+BOOST_FIXTURE_TEST_CASE(PeerDisconnect, ShmLoopbackFixture)
+{
+  connect();
+  transport->resume();
+
+  peer->disconnect();
+  BOOST_CHECK_THROW(advanceUntil([] { return false; }), Transport::Error);
+  BOOST_CHECK(!transport->isConnected());
+}
+
+BOOST_FIXTURE_TEST_CASE(ConnectError, ShmLoopbackFixture)
+{
+  peer.reset();
+  boost::filesystem::remove(socketPath);
+  BOOST_CHECK_THROW(transport->connect(io, [] (const Block&) {}), Transport::Error);
+  BOOST_CHECK(!transport->isConnected());
+}
+
+#endif // NDN_CXX_HAVE_MEMFD
+
+BOOST_AUTO_TEST_SUITE_END() // TestShmTransport
+BOOST_AUTO_TEST_SUITE_END() // Transport
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,285 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/detail/config.hpp"
+
+#ifdef NDN_CXX_HAVE_IO_URING
+
+#include "ndn-cxx/transport/detail/uring-stream.hpp"
+#include "ndn-cxx/encoding/block-helpers.hpp"
+
+#include "tests/boost-test.hpp"
+
+#include <boost/asio/io_service.hpp>
+
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace ndn {
+namespace detail {
+namespace tests {
+
+class UringStreamFixture
+{
+protected:
+  UringStreamFixture()
+  {
+    BOOST_REQUIRE_EQUAL(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds), 0);
+    try {
+      stream = UringStream::create(io, fds[0]);
+    }
+    catch (const UringStream::Error&) {
+      // io_uring is disabled or too old in the running kernel
+    }
+  }
+
+  ~UringStreamFixture()
+  {
+    if (stream != nullptr) {
+      stream->close();
+    }
+    if (fds[0] >= 0) {
+      ::close(fds[0]);
+    }
+    if (fds[1] >= 0) {
+      ::close(fds[1]);
+    }
+  }
+
+  void
+  start()
+  {
+    stream->start([this] (const uint8_t* buf, size_t size) {
+                    received.insert(received.end(), buf, buf + size);
+                  },
+                  [this] (const boost::system::error_code& error, const std::string&) {
+                    lastError = error;
+                    ++nErrors;
+                  });
+  }
+
+  /** \brief run handlers, waiting for completions as needed, until \p predicate holds
+   *
+   *  Gives up after \p nSteps handlers, so that a missing completion fails the test case
+   *  instead of hanging it.
+   */
+  template<typename Predicate>
+  bool
+  runUntil(const Predicate& predicate, int nSteps = 10000)
+  {
+    for (int i = 0; i < nSteps && !predicate(); ++i) {
+      if (io.stopped()) {
+        io.restart();
+      }
+      io.run_one();
+    }
+    return predicate();
+  }
+
+  /** \brief run all handlers that are ready, without waiting
+   */
+  void
+  poll()
+  {
+    if (io.stopped()) {
+      io.restart();
+    }
+    io.poll();
+  }
+
+  /** \brief number of octets that the kernel holds for reading on the stream's socket
+   */
+  int
+  getPendingInput() const
+  {
+    int n = 0;
+    BOOST_REQUIRE_EQUAL(::ioctl(fds[0], FIONREAD, &n), 0);
+    return n;
+  }
+
+  /** \brief read from the peer end of the socket pair until \p size octets have arrived
+   */
+  Buffer
+  readPeer(size_t size)
+  {
+    Buffer buf(size);
+    size_t nRead = 0;
+    while (nRead < size) {
+      poll();
+      ssize_t n = ::recv(fds[1], buf.data() + nRead, size - nRead, MSG_DONTWAIT);
+      if (n > 0) {
+        nRead += static_cast<size_t>(n);
+      }
+      else if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+        break;
+      }
+    }
+    buf.resize(nRead);
+    return buf;
+  }
+
+protected:
+  boost::asio::io_service io;
+  int fds[2] = {-1, -1};
+  shared_ptr<UringStream> stream;
+  std::vector<uint8_t> received;
+  boost::system::error_code lastError;
+  int nErrors = 0;
+};
+
+#define SKIP_IF_URING_UNAVAILABLE() \
+  do { \
+    if (stream == nullptr) { \
+      BOOST_WARN_MESSAGE(false, "skipping test case: io_uring is unavailable"); \
+      return; \
+    } \
+  } while (false)
+
+BOOST_AUTO_TEST_SUITE(Transport)
+BOOST_FIXTURE_TEST_SUITE(TestUringStream, UringStreamFixture)
+
+BOOST_AUTO_TEST_CASE(Send)
+{
+  SKIP_IF_URING_UNAVAILABLE();
+  start();
+
+  Block header = makeNonNegativeIntegerBlock(100, 1);
+  Block payload = makeStringBlock(tlv::Content, std::string(5000, 'x'));
+  std::vector<uint8_t> expected;
+  for (int i = 0; i < 100; ++i) {
+    stream->send({header, payload});
+    expected.insert(expected.end(), header.begin(), header.end());
+    expected.insert(expected.end(), payload.begin(), payload.end());
+  }
+
+  Buffer actual = readPeer(expected.size());
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(nErrors, 0);
+}
+
+BOOST_AUTO_TEST_CASE(ShortWrite)
+{
+  SKIP_IF_URING_UNAVAILABLE();
+  // without MSG_WAITALL, as on kernels before 5.18, a full socket buffer yields short writes
+  stream->m_sendFlags = MSG_NOSIGNAL;
+  int sndbuf = 4096;
+  BOOST_REQUIRE_EQUAL(::setsockopt(fds[0], SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf)), 0);
+  start();
+
+  std::vector<uint8_t> expected;
+  for (int i = 0; i < 100; ++i) {
+    Block header = makeNonNegativeIntegerBlock(100, static_cast<uint64_t>(i));
+    Block payload = makeStringBlock(tlv::Content, std::string(5000, static_cast<char>(i)));
+    stream->send({header, payload});
+    expected.insert(expected.end(), header.begin(), header.end());
+    expected.insert(expected.end(), payload.begin(), payload.end());
+  }
+
+  Buffer actual = readPeer(expected.size());
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+  BOOST_CHECK_GT(stream->m_nShortWrites, 0);
+  BOOST_CHECK_EQUAL(nErrors, 0);
+  BOOST_CHECK(runUntil([this] { return !stream->isSending(); }));
+}
+
+BOOST_AUTO_TEST_CASE(Receive)
+{
+  SKIP_IF_URING_UNAVAILABLE();
+  start();
+  stream->startReceive();
+
+  // more than the total size of the provided buffers
+  std::vector<uint8_t> sent;
+  for (int i = 0; i < 40; ++i) {
+    std::vector<uint8_t> chunk(10000, static_cast<uint8_t>(i));
+    BOOST_REQUIRE_EQUAL(::send(fds[1], chunk.data(), chunk.size(), 0), static_cast<ssize_t>(chunk.size()));
+    sent.insert(sent.end(), chunk.begin(), chunk.end());
+    BOOST_REQUIRE(runUntil([&] { return received.size() == sent.size(); }));
+  }
+  BOOST_CHECK(received == sent);
+  BOOST_CHECK_EQUAL(nErrors, 0);
+}
+
+BOOST_AUTO_TEST_CASE(StopReceive)
+{
+  SKIP_IF_URING_UNAVAILABLE();
+  start();
+  stream->startReceive();
+
+  uint8_t octet = 1;
+  BOOST_REQUIRE_EQUAL(::send(fds[1], &octet, 1, 0), 1);
+  BOOST_CHECK(runUntil([this] { return received.size() == 1; }));
+
+  // once the cancellation completes, nothing reads from the socket
+  stream->stopReceive();
+  BOOST_REQUIRE(runUntil([this] { return !stream->isReceiveArmed(); }));
+  octet = 2;
+  BOOST_REQUIRE_EQUAL(::send(fds[1], &octet, 1, 0), 1);
+  poll();
+  BOOST_CHECK_EQUAL(received.size(), 1);
+  BOOST_CHECK_EQUAL(getPendingInput(), 1);
+
+  stream->startReceive();
+  BOOST_CHECK(runUntil([this] { return received.size() == 2; }));
+  BOOST_CHECK_EQUAL(received.back(), 2);
+  BOOST_CHECK_EQUAL(nErrors, 0);
+}
+
+BOOST_AUTO_TEST_CASE(PeerClose)
+{
+  SKIP_IF_URING_UNAVAILABLE();
+  start();
+  stream->startReceive();
+
+  ::close(fds[1]);
+  fds[1] = -1;
+  BOOST_CHECK(runUntil([this] { return nErrors > 0; }));
+  BOOST_CHECK_EQUAL(lastError, boost::asio::error::eof);
+}
+
+BOOST_AUTO_TEST_CASE(CloseWithPendingRequests)
+{
+  SKIP_IF_URING_UNAVAILABLE();
+  start();
+  stream->startReceive();
+
+  // fill the socket buffer so that the sendmsg request remains outstanding
+  for (int i = 0; i < 100; ++i) {
+    stream->send({makeStringBlock(tlv::Content, std::string(60000, 'x'))});
+  }
+  poll();
+  BOOST_REQUIRE(stream->isSending());
+  BOOST_REQUIRE(stream->isReceiveArmed());
+
+  stream->close();
+  stream.reset();
+  BOOST_CHECK_EQUAL(nErrors, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestUringStream
+BOOST_AUTO_TEST_SUITE_END() // Transport
+
+} // namespace tests
+} // namespace detail
+} // namespace ndn
+
+#endif // NDN_CXX_HAVE_IO_URING
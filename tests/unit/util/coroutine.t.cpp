@@ -0,0 +1,276 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/util/coroutine.hpp"
+#include "ndn-cxx/util/dummy-client-face.hpp"
+
+#include "tests/boost-test.hpp"
+#include "tests/make-interest-data.hpp"
+#include "tests/unit/dummy-validator.hpp"
+#include "tests/unit/unit-test-time-fixture.hpp"
+
+#ifndef NDN_CXX_HAVE_COROUTINES
+#error "this file must be compiled as C++20"
+#endif
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+using namespace ndn::tests;
+
+/** \brief eagerly started coroutine whose frame is freed when it completes
+ */
+struct Task
+{
+  struct promise_type
+  {
+    Task
+    get_return_object() noexcept
+    {
+      return {};
+    }
+
+    std::suspend_never
+    initial_suspend() noexcept
+    {
+      return {};
+    }
+
+    std::suspend_never
+    final_suspend() noexcept
+    {
+      return {};
+    }
+
+    void
+    return_void() noexcept
+    {
+    }
+
+    void
+    unhandled_exception()
+    {
+      std::terminate();
+    }
+  };
+};
+
+/** \brief sets a flag when the coroutine frame that owns it is destroyed
+ */
+class FrameGuard : noncopyable
+{
+public:
+  explicit
+  FrameGuard(bool& isDestroyed)
+    : m_isDestroyed(isDestroyed)
+  {
+  }
+
+  ~FrameGuard()
+  {
+    m_isDestroyed = true;
+  }
+
+private:
+  bool& m_isDestroyed;
+};
+
+class CoroutineFixture : public UnitTestTimeFixture
+{
+public:
+  CoroutineFixture()
+    : face(io, {true, true})
+  {
+  }
+
+  Task
+  expressOne(Interest interest, optional<ExpressResult>& result, bool& isDestroyed)
+  {
+    FrameGuard guard(isDestroyed);
+    result = co_await express(face, interest);
+  }
+
+public:
+  DummyClientFace face;
+};
+
+BOOST_AUTO_TEST_SUITE(Util)
+BOOST_FIXTURE_TEST_SUITE(TestCoroutine, CoroutineFixture)
+
+BOOST_AUTO_TEST_CASE(ExpressData)
+{
+  optional<ExpressResult> result;
+  bool isDestroyed = false;
+  expressOne(*makeInterest("/A", true), result, isDestroyed);
+  advanceClocks(1_ms);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 1);
+  BOOST_CHECK(!result);
+
+  face.receive(*makeData("/A/1"));
+  advanceClocks(1_ms);
+  BOOST_REQUIRE(result);
+  BOOST_CHECK_EQUAL(result->status, ExpressResult::DATA);
+  BOOST_REQUIRE(result->data);
+  BOOST_CHECK_EQUAL(result->data->getName(), "/A/1");
+  BOOST_CHECK(isDestroyed);
+}
+
+BOOST_AUTO_TEST_CASE(ExpressNack)
+{
+  optional<ExpressResult> result;
+  bool isDestroyed = false;
+  expressOne(*makeInterest("/B"), result, isDestroyed);
+  advanceClocks(1_ms);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 1);
+
+  face.receive(makeNack(face.sentInterests.at(0), lp::NackReason::NO_ROUTE));
+  advanceClocks(1_ms);
+  BOOST_REQUIRE(result);
+  BOOST_CHECK_EQUAL(result->status, ExpressResult::NACK);
+  BOOST_REQUIRE(result->nack);
+  BOOST_CHECK_EQUAL(result->nack->getReason(), lp::NackReason::NO_ROUTE);
+  BOOST_CHECK(isDestroyed);
+}
+
+BOOST_AUTO_TEST_CASE(ExpressTimeout)
+{
+  optional<ExpressResult> result;
+  bool isDestroyed = false;
+  expressOne(*makeInterest("/C", false, 50_ms), result, isDestroyed);
+  advanceClocks(10_ms, 4);
+  BOOST_CHECK(!result);
+
+  advanceClocks(10_ms, 2);
+  BOOST_REQUIRE(result);
+  BOOST_CHECK_EQUAL(result->status, ExpressResult::TIMEOUT);
+  BOOST_CHECK(isDestroyed);
+}
+
+BOOST_AUTO_TEST_CASE(RemoveAllPendingInterests)
+{
+  optional<ExpressResult> result1, result2;
+  bool isDestroyed1 = false, isDestroyed2 = false;
+  expressOne(*makeInterest("/D"), result1, isDestroyed1);
+  expressOne(*makeInterest("/E"), result2, isDestroyed2);
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 2);
+
+  face.removeAllPendingInterests();
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 0);
+  BOOST_REQUIRE(result1);
+  BOOST_CHECK_EQUAL(result1->status, ExpressResult::CANCELED);
+  BOOST_CHECK(isDestroyed1);
+  BOOST_REQUIRE(result2);
+  BOOST_CHECK_EQUAL(result2->status, ExpressResult::CANCELED);
+  BOOST_CHECK(isDestroyed2);
+}
+
+BOOST_AUTO_TEST_CASE(Shutdown)
+{
+  optional<ExpressResult> result;
+  bool isDestroyed = false;
+  expressOne(*makeInterest("/F"), result, isDestroyed);
+  advanceClocks(1_ms);
+
+  face.shutdown();
+  advanceClocks(1_ms);
+  BOOST_REQUIRE(result);
+  BOOST_CHECK_EQUAL(result->status, ExpressResult::CANCELED);
+  BOOST_CHECK(isDestroyed);
+}
+
+class SegmentStreamFixture : public CoroutineFixture
+{
+public:
+  Task
+  fetchAll(SegmentStream& stream)
+  {
+    try {
+      while (optional<Data> segment = co_await stream.next()) {
+        segments.push_back(segment->getName().at(-1).toSegment());
+      }
+      isComplete = true;
+    }
+    catch (const SegmentStream::Error& e) {
+      errorCode = e.getCode();
+    }
+  }
+
+  void
+  sendSegment(uint64_t segment, uint64_t lastSegment)
+  {
+    auto data = make_shared<Data>(Name("/G").appendVersion(1).appendSegment(segment));
+    data->setFreshnessPeriod(1_s);
+    data->setFinalBlock(name::Component::fromSegment(lastSegment));
+    data->setContent(reinterpret_cast<const uint8_t*>("seg"), 3);
+    face.receive(*signData(data));
+  }
+
+public:
+  DummyValidator validator;
+  std::vector<uint64_t> segments;
+  bool isComplete = false;
+  optional<uint32_t> errorCode;
+};
+
+BOOST_FIXTURE_TEST_CASE(FetchSegments, SegmentStreamFixture)
+{
+  SegmentStream stream(SegmentFetcher::start(face, Interest("/G"), validator));
+  fetchAll(stream);
+  advanceClocks(1_ms);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 1);
+
+  sendSegment(0, 2);
+  advanceClocks(1_ms);
+  sendSegment(1, 2);
+  advanceClocks(1_ms);
+  sendSegment(2, 2);
+  advanceClocks(1_ms);
+
+  std::vector<uint64_t> expected{0, 1, 2};
+  BOOST_CHECK_EQUAL_COLLECTIONS(segments.begin(), segments.end(), expected.begin(), expected.end());
+  BOOST_CHECK(isComplete);
+  BOOST_CHECK(!errorCode);
+}
+
+BOOST_FIXTURE_TEST_CASE(FetchError, SegmentStreamFixture)
+{
+  validator.getPolicy().setResult(false);
+  SegmentStream stream(SegmentFetcher::start(face, Interest("/G"), validator));
+  fetchAll(stream);
+  advanceClocks(1_ms);
+
+  sendSegment(0, 2);
+  advanceClocks(1_ms);
+  BOOST_CHECK(segments.empty());
+  BOOST_CHECK(!isComplete);
+  BOOST_REQUIRE(errorCode);
+  BOOST_CHECK_EQUAL(*errorCode, SegmentFetcher::SEGMENT_VALIDATION_FAIL);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCoroutine
+BOOST_AUTO_TEST_SUITE_END() // Util
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/util/face-group.hpp"
+#include "ndn-cxx/mgmt/nfd/control-parameters.hpp"
+#include "ndn-cxx/security/signing-helpers.hpp"
+#include "ndn-cxx/util/dummy-client-face.hpp"
+
+#include "tests/boost-test.hpp"
+#include "tests/make-interest-data.hpp"
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+using namespace ndn::tests;
+
+class FaceGroupFixture
+{
+public:
+  FaceGroupFixture()
+  {
+    FaceGroup::Options options;
+    options.nShards = 3;
+    options.makeKeyChain = [] {
+      return make_unique<KeyChain>("pib-memory:", "tpm-memory:");
+    };
+    options.makeFace = [this] (boost::asio::io_service& io, KeyChain& keyChain) {
+      auto face = make_unique<DummyClientFace>(io, keyChain, DummyClientFace::Options{true, true});
+      faces.push_back(face.get());
+      return face;
+    };
+    group = make_unique<FaceGroup>(options);
+  }
+
+  /** \brief process pending handlers of every shard on the calling thread
+   */
+  void
+  pollShards()
+  {
+    for (int i = 0; i < 3; ++i) {
+      for (size_t s = 0; s < group->size(); ++s) {
+        (*group)[s].getIoService().poll();
+        (*group)[s].getIoService().restart();
+      }
+    }
+  }
+
+  /** \brief extract ControlParameters of the last command sent by the face of shard \p s
+   */
+  nfd::ControlParameters
+  getLastCommand(size_t s)
+  {
+    BOOST_REQUIRE(!faces.at(s)->sentInterests.empty());
+    return nfd::ControlParameters(faces.at(s)->sentInterests.back().getName().at(4).blockFromValue());
+  }
+
+public:
+  std::vector<DummyClientFace*> faces;
+  unique_ptr<FaceGroup> group;
+};
+
+BOOST_AUTO_TEST_SUITE(Util)
+BOOST_FIXTURE_TEST_SUITE(TestFaceGroup, FaceGroupFixture)
+
+BOOST_AUTO_TEST_CASE(Dispatch)
+{
+  BOOST_REQUIRE_EQUAL(group->size(), 3);
+
+  std::vector<std::pair<size_t, Name>> processed;
+  group->setInterestFilter("/A", [&] (FaceGroup::Shard& shard, const Interest& interest) {
+    processed.emplace_back(shard.getIndex(), interest.getName());
+    auto data = makeData(interest.getName());
+    shard.getKeyChain().sign(*data, signingWithSha256());
+    shard.getFace().put(*data);
+  }, bind([] { BOOST_FAIL("Unexpected registration failure"); }));
+  pollShards();
+
+  for (size_t s = 0; s < group->size(); ++s) {
+    BOOST_CHECK_EQUAL(getLastCommand(s).getName(), "/A");
+  }
+
+  // every Interest arrives on the connection of shard 0
+  const int nInterests = 30;
+  for (int i = 0; i < nInterests; ++i) {
+    faces[0]->receive(*makeInterest(Name("/A").appendNumber(i)));
+  }
+  pollShards();
+
+  BOOST_REQUIRE_EQUAL(processed.size(), nInterests);
+  std::vector<size_t> nDataPerShard(group->size());
+  for (const auto& item : processed) {
+    BOOST_CHECK_EQUAL(item.first, group->getShardIndex(item.second));
+    ++nDataPerShard[item.first];
+  }
+  for (size_t s = 0; s < group->size(); ++s) {
+    BOOST_CHECK_EQUAL(faces[s]->sentData.size(), nDataPerShard[s]);
+    BOOST_CHECK_GT(nDataPerShard[s], 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Announce)
+{
+  PrefixAnnouncement pa;
+  pa.setAnnouncedName("/B");
+  pa.setExpiration(10_s);
+
+  int nFailures = 0;
+  group->announce(pa, [] (FaceGroup::Shard&, const Interest&) {},
+                  bind([&nFailures] { ++nFailures; }));
+  pollShards();
+  BOOST_CHECK_EQUAL(nFailures, 0);
+  for (size_t s = 0; s < group->size(); ++s) {
+    auto parameters = getLastCommand(s);
+    BOOST_CHECK_EQUAL(parameters.getName(), "/B");
+    BOOST_CHECK_EQUAL(parameters.getExpirationPeriod(), 10_s);
+  }
+
+  auto now = time::system_clock::now();
+  pa.setValidityPeriod(security::ValidityPeriod(now - 2_h, now - 1_h));
+  group->announce(pa, [] (FaceGroup::Shard&, const Interest&) {},
+                  bind([&nFailures] { ++nFailures; }));
+  BOOST_CHECK_EQUAL(nFailures, 1);
+}
+
+BOOST_AUTO_TEST_CASE(StartStop)
+{
+  group->start();
+
+  std::atomic<size_t> nExecuted{0};
+  for (size_t s = 0; s < group->size(); ++s) {
+    (*group)[s].getIoService().post([&nExecuted] { ++nExecuted; });
+  }
+  for (int i = 0; i < 500 && nExecuted < group->size(); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  BOOST_CHECK_EQUAL(nExecuted, group->size());
+
+  group->stop();
+  group->stop(); // no effect
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestFaceGroup
+BOOST_AUTO_TEST_SUITE_END() // Util
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
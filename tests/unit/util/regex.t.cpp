@@ -24,11 +24,13 @@
 #include "ndn-cxx/util/regex.hpp"
 #include "ndn-cxx/util/regex/regex-backref-manager.hpp"
 #include "ndn-cxx/util/regex/regex-backref-matcher.hpp"
+#include "ndn-cxx/util/regex/regex-compiled-matcher.hpp"
 #include "ndn-cxx/util/regex/regex-component-matcher.hpp"
 #include "ndn-cxx/util/regex/regex-component-set-matcher.hpp"
 #include "ndn-cxx/util/regex/regex-pattern-list-matcher.hpp"
 #include "ndn-cxx/util/regex/regex-repeat-matcher.hpp"
 #include "ndn-cxx/util/regex/regex-top-matcher.hpp"
+#include "ndn-cxx/util/sha256.hpp"
 
 #include "tests/boost-test.hpp"
 
@@ -456,6 +458,62 @@ BOOST_AUTO_TEST_CASE(RegexBackrefManagerMemoryLeak)
   BOOST_CHECK_EQUAL(b2.use_count(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(CompiledMatcher)
+{
+  const std::vector<string> exprs{
+    "^<a><b><c>", "<b><c><d>$", "^<a><b><c><d>$", "<a><b><c><d>", "<b><c>", "<>", "^<>$", "^$",
+    "^(<.*>*)<.*>", "^(<.*>*)<.*><c>(<.*>)<.*>", "<.*>(<.*>*)<.*>$", "<a>(<>*)<>$",
+    "^<a>*<b>+<c>?$", "^<a>{2}<b>{1,2}<c>{,1}<d>{2,}$", "^(<a><b>)+$", "^(<a>(<b>)?)*<c>$",
+    "^[<a><b>]+$", "^[^<a><b>]<c>$", "^<ndn><(.*)\\.(.*)><DNS>(<>*)<>",
+    "^(<>*)<KEY><>$", "^<>*<KEY><ksk-[0-9]+><ID-CERT>$", "^<localhost><nfd><rib>[<register><unregister>]<>$",
+    "^<a|bc>$", "^<(?:ab)+>$", "^<\\d{2,3}>$", "^<[a-c-]+>$", "^<[^.]*>$", "^<%2F.*>$", "^<\\.\\.\\..*>$",
+    "^<sha256digest=.*>$", "^<\\w+>$", "^<\\W>$", "^<x\\x41>$", "^<.+?>$",
+    // a repetition with min > 0 never matches an empty sequence in Regex
+    "((<[^a]*>?){0,0}){2}<.*>{,1}$", "^([^<b><c>]{0}(<a>?){1,2})<x>$", "^(<a>?){2}<x>$",
+    "^(<a>?){1,3}<c>?$", "^((<a>?){0}<b>?){1,3}<c>$", "^([^<b><c>]{0}(<a>)<.*>)<.*>?$",
+  };
+  const std::vector<Name> names{
+    "/", "/a", "/a/b", "/a/b/c", "/a/b/c/d", "/a/b/c/d/e", "/n/a/b/c", "/n/a/b/c/d/e", "/a/a/b/c/d/d",
+    "/a/a/b/b/d/d", "/a/b/a/b", "/a/b/a/c", "/c", "/d/c", "/a/c", "/ndn/ucla.edu/DNS/yingdi/mac/ksk-1",
+    "/ndn/edu/ucla/KEY/ksk-1", "/ndn/edu/ucla/KEY/ksk-12/ID-CERT", "/ndn/KEY/ksk-/ID-CERT",
+    "/localhost/nfd/rib/register/params", "/localhost/nfd/rib/list/params", "/bc", "/abab", "/12", "/1234",
+    "/aa-cc", "/%2F%2Fx", "/...", "/....", "/.....", "/xA", "/x%41", "/_w", "/%00",
+    Name("/a").appendImplicitSha256Digest(util::Sha256::computeDigest(nullptr, 0)),
+  };
+
+  for (const auto& expr : exprs) {
+    BOOST_TEST_CONTEXT(expr) {
+      Regex reference(expr);
+      RegexCompiledMatcher compiled(expr);
+      BOOST_CHECK(compiled.isCompiled());
+      for (const auto& name : names) {
+        BOOST_TEST_CONTEXT(name) {
+          BOOST_CHECK_EQUAL(compiled.match(name), reference.match(name));
+          // the lazily built automaton must give the same answer again
+          BOOST_CHECK_EQUAL(compiled.match(name), reference.match(name));
+        }
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(CompiledMatcherFallback)
+{
+  // component pattern with a backreference is evaluated with std::regex
+  RegexCompiledMatcher backref("^<(a+)b\\1>$");
+  BOOST_CHECK(backref.isCompiled());
+  BOOST_CHECK_EQUAL(backref.match("/aabaa"), true);
+  BOOST_CHECK_EQUAL(backref.match("/aaba"), false);
+
+  // repetition too large to be unrolled into an automaton
+  RegexCompiledMatcher repeat("^<a>{20000}<b>$");
+  BOOST_CHECK(!repeat.isCompiled());
+  BOOST_CHECK_EQUAL(repeat.match("/a/b"), false);
+
+  BOOST_CHECK_THROW(RegexCompiledMatcher("<a"), RegexCompiledMatcher::Error);
+  BOOST_CHECK_THROW(RegexCompiledMatcher("<a>{3,2}"), RegexCompiledMatcher::Error);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestRegex
 BOOST_AUTO_TEST_SUITE_END() // Util
 
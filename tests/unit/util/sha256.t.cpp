@@ -26,6 +26,7 @@
 
 #include <boost/endian/conversion.hpp>
 #include <sstream>
+#include <thread>
 
 namespace ndn {
 namespace util {
@@ -190,6 +191,41 @@ BOOST_AUTO_TEST_CASE(StaticComputeDigest)
                                 digest->data(), digest->data() + digest->size());
 }
 
+BOOST_AUTO_TEST_CASE(StaticComputeDigestConcurrent)
+{
+  std::vector<Buffer> inputs;
+  std::vector<ConstBufferPtr> expected;
+  for (uint8_t i = 0; i < 16; ++i) {
+    inputs.emplace_back(i * 100 + 1);
+    std::fill(inputs.back().begin(), inputs.back().end(), i);
+    Sha256 sha;
+    sha.update(inputs.back().data(), inputs.back().size());
+    expected.push_back(sha.computeDigest());
+  }
+
+  std::vector<std::vector<ConstBufferPtr>> results(4);
+  std::vector<std::thread> threads;
+  for (auto& result : results) {
+    threads.emplace_back([&inputs, &result] {
+      for (int round = 0; round < 100; ++round) {
+        for (const auto& input : inputs) {
+          result.push_back(Sha256::computeDigest(input.data(), input.size()));
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (const auto& result : results) {
+    BOOST_REQUIRE_EQUAL(result.size(), 100 * inputs.size());
+    for (size_t i = 0; i < result.size(); ++i) {
+      BOOST_CHECK(*result[i] == *expected[i % inputs.size()]);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_CASE(Print)
 {
   const uint8_t origin[] = {0x94, 0xEE, 0x05, 0x93, 0x35, 0xE5, 0x87, 0xE5,
@@ -150,6 +150,30 @@ BOOST_AUTO_TEST_CASE(Basic)
   }
 }
 
+BOOST_AUTO_TEST_CASE(Reset)
+{
+  Sqlite3Statement(db, "CREATE TABLE test (t1 int)").step();
+
+  Sqlite3Statement insert(db, "INSERT INTO test VALUES (?)");
+  for (int i = 1; i <= 3; ++i) {
+    insert.bind(1, i);
+    BOOST_CHECK_EQUAL(insert.step(), SQLITE_DONE);
+    insert.reset();
+  }
+
+  // bindings are cleared by reset
+  BOOST_CHECK_EQUAL(insert.step(), SQLITE_DONE);
+  insert.reset();
+
+  Sqlite3Statement select(db, "SELECT count(t1), count(*) FROM test");
+  for (int i = 0; i < 2; ++i) {
+    BOOST_REQUIRE_EQUAL(select.step(), SQLITE_ROW);
+    BOOST_CHECK_EQUAL(select.getInt(0), 3);
+    BOOST_CHECK_EQUAL(select.getInt(1), 4);
+    select.reset();
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestSqlite3Statement
 BOOST_AUTO_TEST_SUITE_END() // Util
 